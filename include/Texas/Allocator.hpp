@@ -23,5 +23,20 @@ namespace Texas
 
 		[[nodiscard]] virtual std::byte* allocate(std::size_t amount, MemoryType memType) = 0;
 		virtual void deallocate(std::byte* ptr, MemoryType memType) = 0;
+
+		/*
+			Allocates memory where the returned pointer is a multiple of alignment, 
+			such as when the memory is used as a staging buffer for GPU uploads.
+			alignment must be a power of two. Returns nullptr if it is not.
+
+			Memory from this function must be freed with deallocateAligned(), 
+			with the same alignment and memType.
+
+			The default implementation over-allocates with allocate() and
+			stores the distance to the start of that allocation right before the returned pointer.
+			Override both functions if your allocator can align memory by itself.
+		*/
+		[[nodiscard]] virtual std::byte* allocateAligned(std::size_t amount, std::size_t alignment, MemoryType memType);
+		virtual void deallocateAligned(std::byte* ptr, std::size_t alignment, MemoryType memType);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Texas/Allocator.hpp"
+#include "Texas/Span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Texas
+{
+    /*
+        Bump allocator for working-memory.
+
+        Working-memory is handed out from one contiguous arena by moving an offset forward.
+        Deallocating does not free anything by itself, but once every allocation made from
+        the arena has been deallocated, the arena is reset and reused from the start.
+        A loading path deallocates all its working-memory before it returns,
+        so the arena is reset after every load.
+
+        Requests that don't fit in the arena and requests for image-data are forwarded
+        to the upstream allocator. Without an upstream allocator they use dynamic allocations
+        if TEXAS_ENABLE_DYNAMIC_ALLOCATIONS is defined, and otherwise fail.
+
+        An ArenaAllocator must only be used by one thread at a time.
+    */
+    class ArenaAllocator final : public Allocator
+    {
+    public:
+        struct Statistics
+        {
+            // Amount of allocations that were served from the arena.
+            std::uint64_t arenaAllocationCount = 0;
+            // Amount of allocations that were forwarded because they were image-data or did not fit.
+            std::uint64_t forwardedAllocationCount = 0;
+            // Amount of times the arena was reset after all its allocations were deallocated.
+            std::uint64_t resetCount = 0;
+            // Amount of times the arena was reallocated to a larger size.
+            std::uint64_t growCount = 0;
+            // Highest amount of bytes that has been in use in the arena at once.
+            std::size_t peakBytesUsed = 0;
+            // Current size of the arena in bytes.
+            std::size_t capacity = 0;
+        };
+
+        /*
+            Uses buffer as the arena. The ArenaAllocator never grows or frees the buffer.
+        */
+        explicit ArenaAllocator(ByteSpan buffer, Allocator* upstream = nullptr) noexcept;
+        /*
+            Allocates an arena of initialCapacity bytes from upstream.
+            When working-memory had to be forwarded because the arena was full,
+            the arena grows at its next reset so the same loads fit next time.
+        */
+        explicit ArenaAllocator(std::size_t initialCapacity, Allocator* upstream = nullptr) noexcept;
+        ArenaAllocator(ArenaAllocator const&) = delete;
+        ArenaAllocator& operator=(ArenaAllocator const&) = delete;
+        ~ArenaAllocator();
+
+        [[nodiscard]] virtual std::byte* allocate(std::size_t amount, MemoryType memType) override;
+        virtual void deallocate(std::byte* ptr, MemoryType memType) override;
+
+        [[nodiscard]] Statistics statistics() const noexcept;
+
+        /*
+            Returns the amount of bytes currently in use in the arena.
+        */
+        [[nodiscard]] std::size_t bytesUsed() const noexcept;
+
+    private:
+        [[nodiscard]] std::byte* allocateUpstream(std::size_t amount, MemoryType memType) noexcept;
+        void deallocateUpstream(std::byte* ptr, MemoryType memType) noexcept;
+        void reset() noexcept;
+
+        std::byte* m_buffer = nullptr;
+        std::size_t m_capacity = 0;
+        std::size_t m_offset = 0;
+        // Amount of allocations in the arena that have not been deallocated.
+        std::size_t m_liveCount = 0;
+        // Bytes of working-memory forwarded since the last reset, because the arena was full.
+        std::size_t m_overflowBytes = 0;
+        bool m_ownsBuffer = false;
+        Allocator* m_upstream = nullptr;
+        Statistics m_statistics{};
+    };
+}
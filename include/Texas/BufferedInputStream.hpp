@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Texas/InputStream.hpp"
+#include "Texas/Result.hpp"
+#include "Texas/Span.hpp"
+
+#include <cstddef>
+
+namespace Texas
+{
+    /*
+        InputStream that wraps another InputStream and reads from it in large blocks.
+
+        Texas reads files through lots of small reads, like the 8-byte chunk headers of PNG files.
+        When every call to the wrapped stream is expensive, such as for a network filesystem
+        or an archive reader, wrapping it in a BufferedInputStream turns those into
+        a few large reads. Small reads, ignores and seeks that land inside the buffer
+        never reach the wrapped stream.
+
+        Reads from the wrapped stream always start at a multiple of blockSize, and fill
+        as much of the buffer as they can, so the buffer size decides how far it reads ahead.
+        Reads that are larger than the buffer go straight to the wrapped stream,
+        and so do vectored reads, through the readVectored() of the wrapped stream.
+
+        acquire() only hands out bytes that are in the buffer already.
+
+        If the wrapped stream implements size(), it's never read past its end.
+        Otherwise a read into the buffer that fails is taken to mean the end of the stream is near,
+        and the buffer is filled with half as much from there on. Once that is less than a read
+        asks for, the read goes straight to the wrapped stream with the exact size asked for.
+        When a read fails, tell() of the wrapped stream must say where the read left it,
+        and if that is not where the read started, the wrapped stream has to be able to seek back.
+
+        The wrapped stream must not be used by anything else while it's wrapped.
+    */
+    class BufferedInputStream : public InputStream
+    {
+    public:
+        static constexpr std::size_t defaultBlockSize = 4096;
+        // Used if no buffer size is specified.
+        static constexpr std::size_t recommendedBufferSize = 1 << 16;
+
+        /*
+            Wraps source, using buffer to hold the bytes read ahead of time.
+            Both must outlive the BufferedInputStream.
+            blockSize is reduced to the size of buffer if buffer is smaller.
+        */
+        BufferedInputStream(InputStream& source, ByteSpan buffer, std::size_t blockSize = defaultBlockSize) noexcept;
+        BufferedInputStream(BufferedInputStream const&) = delete;
+        BufferedInputStream& operator=(BufferedInputStream const&) = delete;
+
+        [[nodiscard]] virtual Result read(ByteSpan dst) noexcept override;
+        [[nodiscard]] virtual Result readVectored(Span<ByteSpan const> dsts) noexcept override;
+        virtual void ignore(std::size_t amount) noexcept override;
+        [[nodiscard]] virtual ConstByteSpan acquire(std::size_t amount) noexcept override;
+
+        [[nodiscard]] virtual std::size_t tell() noexcept override;
+        virtual void seek(std::size_t pos) noexcept override;
+        [[nodiscard]] virtual std::size_t size() noexcept override;
+        virtual void hint(std::size_t pos, std::size_t length, AccessHint access) noexcept override;
+
+    private:
+        // Makes sure the wrapped stream is at pos.
+        void moveSourceTo(std::size_t pos) noexcept;
+
+        InputStream* m_source = nullptr;
+        ByteSpan m_buffer = {};
+        std::size_t m_blockSize = 0;
+        std::size_t m_sourceSize = 0;
+        // Most bytes read into the buffer at once. Halved every time a read into the buffer fails
+        // when the wrapped stream does not know its size, so that it happens a few times at most.
+        std::size_t m_fillLimit = unknownSize;
+
+        // Stream position of the first byte in m_buffer.
+        std::size_t m_bufferStreamPos = 0;
+        // Amount of bytes in m_buffer that hold data.
+        std::size_t m_bufferFilled = 0;
+        std::size_t m_pos = 0;
+        std::size_t m_sourcePos = 0;
+    };
+}
@@ -2,6 +2,7 @@
 
 #include "Texas/TextureInfo.hpp"
 #include "Texas/Dimensions.hpp"
+#include "Texas/ImageDataRange.hpp"
 
 // Include detail headers
 #include "Texas/detail/FileInfo_BackendData.hpp"
@@ -25,12 +26,30 @@ namespace Texas
 
         [[nodiscard]] std::uint64_t memoryRequired() const noexcept;
 
+        /*
+            Returns the amount of memory needed to hold the mip levels and array layers in range,
+            when they are loaded with Texas::loadImageData.
+
+            Returns 0 if the range is empty or reaches outside the texture.
+        */
+        [[nodiscard]] std::uint64_t memoryRequired(ImageDataRange const& range) const noexcept;
+
         [[nodiscard]] std::uint64_t workingMemoryRequired() const noexcept;
 
+        /*
+            Returns the smallest amount of working memory Texas::loadImageData accepts for this file.
+
+            Passing in less working memory than .workingMemoryRequired() makes 
+            PNG image-data get decoded one row at a time, 
+            so the working memory only needs to hold a couple of rows instead of the entire image.
+        */
+        [[nodiscard]] std::uint64_t minWorkingMemoryRequired() const noexcept;
+
     private:
         TextureInfo m_textureInfo = {};
         std::uint64_t m_memoryRequired = 0;
         std::uint64_t m_workingMemoryRequired = 0;
+        std::uint64_t m_minWorkingMemoryRequired = 0;
 
         mutable detail::FileInfo_BackendData m_backendData{};
 
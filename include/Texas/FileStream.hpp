@@ -0,0 +1,169 @@
+#pragma once
+
+#include "Texas/Allocator.hpp"
+#include "Texas/InputStream.hpp"
+#include "Texas/Result.hpp"
+#include "Texas/Span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Texas
+{
+    /*
+        A file opened for reading, that any number of threads can read from at the same time.
+
+        Every read says where in the file it starts, through pread() on POSIX
+        and ReadFile() with an offset on Windows. The file has no shared position,
+        so there is nothing to lock, and offsets are 64-bit on every platform.
+    */
+    class FileHandle
+    {
+    public:
+        // Offset, size and buffer address of every direct read are a multiple of this.
+        static constexpr std::size_t directReadAlignment = 4096;
+
+        FileHandle() noexcept = default;
+        FileHandle(FileHandle const&) = delete;
+        FileHandle(FileHandle&&) noexcept;
+
+        FileHandle& operator=(FileHandle const&) = delete;
+        FileHandle& operator=(FileHandle&&) noexcept;
+
+        ~FileHandle();
+
+        /*
+            Opens the file at the specified path. Any previously opened file is closed first.
+
+            If enableDirectReads is true, a second handle that bypasses the OS file cache is
+            opened as well, with O_DIRECT on Linux and FILE_FLAG_NO_BUFFERING on Windows.
+            Not every filesystem allows that, so check hasDirectReads() afterwards.
+        */
+        [[nodiscard]] Result open(char const* path, bool enableDirectReads = false) noexcept;
+
+        /*
+            Closes the file. Does nothing if no file is open.
+        */
+        void close() noexcept;
+
+        [[nodiscard]] bool isOpen() const noexcept;
+
+        [[nodiscard]] bool hasDirectReads() const noexcept;
+
+        /*
+            Returns the size of the file in bytes, as it was when it was opened.
+        */
+        [[nodiscard]] std::uint64_t size() const noexcept;
+
+        /*
+            Reads dst.size() bytes, starting offset bytes into the file.
+            Safe to call from many threads at once.
+        */
+        [[nodiscard]] Result readAt(std::uint64_t offset, ByteSpan dst) const noexcept;
+
+        /*
+            Fills every span in dsts, in order, starting offset bytes into the file.
+            Uses preadv() on POSIX, so it's a single call to the OS in most cases.
+            Safe to call from many threads at once.
+        */
+        [[nodiscard]] Result readAtVectored(std::uint64_t offset, Span<ByteSpan const> dsts) const noexcept;
+
+        /*
+            Passes the hint for length bytes starting offset bytes into the file on to the OS.
+            A length of 0 covers everything to the end of the file. Does nothing on Windows.
+        */
+        void hint(std::uint64_t offset, std::uint64_t length, InputStream::AccessHint access) const noexcept;
+
+        /*
+            Fills every span in dsts, in order, starting offset bytes into the file,
+            without going through the OS file cache.
+            The file is read in aligned blocks into bounceBuffer, and copied from there,
+            so offset and the spans don't have to be aligned.
+            bounceBuffer must start at, and have a size that is a multiple of, directReadAlignment.
+            Safe to call from many threads at once, as long as they use different bounce buffers.
+        */
+        [[nodiscard]] Result readAtDirect(
+            std::uint64_t offset,
+            Span<ByteSpan const> dsts,
+            ByteSpan bounceBuffer) const noexcept;
+
+    private:
+        // File descriptor on POSIX, HANDLE on Windows. -1 when no file is open.
+        std::intptr_t m_nativeHandle = -1;
+        // Same as m_nativeHandle, but bypasses the OS file cache. -1 when not available.
+        std::intptr_t m_directHandle = -1;
+        std::uint64_t m_size = 0;
+    };
+
+    /*
+        InputStream that reads from a FileHandle.
+
+        The position in the file is kept by the stream, not by the file,
+        so many FileStreams can read from the same FileHandle at once.
+        Give every thread its own FileStream to load different textures,
+        or different mip levels, out of one large pack file.
+
+        Every read is a call to the OS, so wrap it in a Texas::BufferedInputStream
+        when parsing files, which does lots of small reads.
+
+        Hints are passed on to the OS through posix_fadvise() on POSIX.
+        AccessHint::DontNeed drops the pages from the OS file cache for every process,
+        so it's ignored unless setDropConsumedPages(true) has been called. Turn it on for
+        one-shot imports, so that they don't push everything else out of the file cache.
+
+        With enableDirectReads(), large reads, such as the image-data of KTX files,
+        skip the OS file cache entirely. That gives offline tools that churn through
+        more data than fits in memory predictable throughput, without evicting
+        the file cache of everything else on the system.
+    */
+    class FileStream : public InputStream
+    {
+    public:
+        // Reads this large or larger skip the file cache when direct reads are enabled, unless specified otherwise.
+        static constexpr std::size_t defaultMinDirectReadSize = 1 << 18;
+        // Largest bounce buffer a direct read takes from the allocator.
+        static constexpr std::size_t maxDirectReadBufferSize = 1 << 20;
+
+        FileStream() noexcept = default;
+        /*
+            file must outlive the FileStream.
+            The stream starts at startOffset, and its positions are offsets into the file.
+        */
+        explicit FileStream(FileHandle const& file, std::uint64_t startOffset = 0) noexcept;
+
+        [[nodiscard]] virtual Result read(ByteSpan dst) noexcept override;
+        [[nodiscard]] virtual Result readVectored(Span<ByteSpan const> dsts) noexcept override;
+        virtual void ignore(std::size_t amount) noexcept override;
+
+        [[nodiscard]] virtual std::size_t tell() noexcept override;
+        virtual void seek(std::size_t pos) noexcept override;
+        [[nodiscard]] virtual std::size_t size() noexcept override;
+        virtual void hint(std::size_t pos, std::size_t length, AccessHint access) noexcept override;
+
+        /*
+            Enables dropping the pages of the file from the OS file cache
+            once Texas is done reading them. Off by default.
+        */
+        void setDropConsumedPages(bool enabled) noexcept;
+
+        /*
+            Makes reads of atleast minReadSize bytes go through FileHandle::readAtDirect(),
+            with a bounce buffer taken from allocator by allocateAligned() for every read.
+            allocator must outlive the FileStream.
+            Does nothing if the file was not opened with direct reads,
+            then every read goes through the OS file cache like before.
+        */
+        void enableDirectReads(Allocator& allocator, std::size_t minReadSize = defaultMinDirectReadSize) noexcept;
+
+    private:
+        [[nodiscard]] bool useDirectRead(std::size_t readSize) const noexcept;
+        [[nodiscard]] Result readDirect(Span<ByteSpan const> dsts, std::size_t totalSize) noexcept;
+
+        FileHandle const* m_file = nullptr;
+        std::uint64_t m_offset = 0;
+        bool m_dropConsumedPages = false;
+        // nullptr unless direct reads are enabled.
+        Allocator* m_directReadAllocator = nullptr;
+        std::size_t m_minDirectReadSize = 0;
+    };
+}
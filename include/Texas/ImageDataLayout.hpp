@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Texas
+{
+    /*
+        Describes where a single mip level is placed in a destination buffer.
+
+        For block-compressed formats, a row is a row of blocks.
+    */
+    struct MipLayout
+    {
+        // Offset in bytes from the start of the buffer to the first row of layer 0.
+        std::uint64_t offset;
+        // Offset in bytes between the start of two consecutive rows.
+        std::uint64_t rowPitch;
+        // Offset in bytes between the start of two consecutive depth slices.
+        std::uint64_t slicePitch;
+        // Offset in bytes between the start of two consecutive array layers.
+        std::uint64_t layerPitch;
+    };
+
+    /*
+        Describes how image-data is placed in a destination buffer.
+
+        Lets the image-data be loaded straight into a buffer that has
+        the layout required for a GPU upload, such as a mapped staging buffer
+        where every mip level must start at an aligned offset and rows are padded.
+
+        A layout where no mip levels or rows are padded
+        is the same as the layout of Texas::Texture.
+    */
+    struct ImageDataLayout
+    {
+        // The highest mip count a file with 32-bit dimensions can have.
+        static constexpr std::uint8_t maxMipCount = 32;
+
+        MipLayout mips[maxMipCount] = {};
+        // The minimum size in bytes of a buffer that can hold the image-data in this layout.
+        std::uint64_t totalSize = 0;
+    };
+}
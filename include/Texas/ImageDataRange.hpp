@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Texas
+{
+    /*
+        Specifies a range of mip levels and array layers of a texture's image-data.
+
+        Used to load only part of a texture, such as loading the smallest mip levels first
+        and the larger ones later when streaming textures.
+    */
+    struct ImageDataRange
+    {
+        std::uint8_t baseMip = 0;
+        std::uint8_t mipCount = 0;
+        std::uint64_t baseLayer = 0;
+        std::uint64_t layerCount = 0;
+    };
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Texas/Allocator.hpp"
+#include "Texas/FileInfo.hpp"
+#include "Texas/Result.hpp"
+#include "Texas/Span.hpp"
+
+// Include detail headers
+#include "Texas/detail/IncrementalDecoder_BackendData.hpp"
+#include "Texas/detail/PrivateAccessor_Declaration.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Texas
+{
+    /*
+        Decodes a file from bytes that are pushed in as they arrive,
+        instead of pulling them from an InputStream.
+
+        Lets a texture be decoded while it's still being downloaded,
+        and lets the rows and mip levels that are done be used before the rest of the file has arrived.
+
+        Usage:
+         - Pass every piece of the file to .feed() in order.
+         - Once .hasFileInfo() returns true, call .setDstBuffer() with a buffer
+           of atleast .fileInfo().memoryRequired() bytes.
+         - .mipsReady() and .rowsReady() tell how much of dstBuffer has been written.
+         - The file is decoded once .isDone() returns true.
+
+        The image-data is placed the same way as in Texas::Texture.
+        An IncrementalDecoder must only be used by one thread at a time.
+    */
+    class IncrementalDecoder
+    {
+    public:
+        /*
+            Creates an IncrementalDecoder that gets all its memory from allocator.
+            The allocator must outlive the IncrementalDecoder.
+        */
+        explicit IncrementalDecoder(Allocator& allocator) noexcept;
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+        /*
+            Creates an IncrementalDecoder that uses dynamic allocations for its memory.
+        */
+        IncrementalDecoder() noexcept;
+#endif
+        IncrementalDecoder(IncrementalDecoder const&) = delete;
+        IncrementalDecoder(IncrementalDecoder&&) noexcept;
+
+        IncrementalDecoder& operator=(IncrementalDecoder const&) = delete;
+        IncrementalDecoder& operator=(IncrementalDecoder&&) noexcept;
+
+        ~IncrementalDecoder();
+
+        /*
+            Passes the next bytes of the file to the decoder. data only has to live until this returns.
+
+            Bytes that arrive before the file's metadata has been parsed,
+            or before a destination buffer has been set, are kept by the decoder until they can be used.
+            Once an error has been returned, every call after that returns the same error until .reset().
+        */
+        [[nodiscard]] Result feed(ConstByteSpan data) noexcept;
+
+        /*
+            Returns true once enough of the file has been fed to parse its metadata.
+        */
+        [[nodiscard]] bool hasFileInfo() const noexcept;
+
+        /*
+            Returns info on the file being decoded. Only valid if .hasFileInfo() returns true.
+        */
+        [[nodiscard]] FileInfo const& fileInfo() const noexcept;
+
+        /*
+            Sets the buffer the image-data is decoded into, and decodes any image-data that has already been fed.
+            Can only be called once per file, after .hasFileInfo() returns true.
+            dstBuffer must hold atleast .fileInfo().memoryRequired() bytes, and outlive the decoding.
+        */
+        [[nodiscard]] Result setDstBuffer(ByteSpan dstBuffer) noexcept;
+
+        /*
+            Returns the amount of mip levels that have been written to the destination buffer in full.
+        */
+        [[nodiscard]] std::uint8_t mipsReady() const noexcept;
+
+        /*
+            Returns the amount of rows that have been written to the destination buffer
+            for mip level .mipsReady(), the one currently being decoded.
+            Rows are counted across every array layer and depth slice of the mip level, in the order
+            they're placed in the destination buffer. For block-compressed formats, a row is a row of blocks.
+        */
+        [[nodiscard]] std::uint64_t rowsReady() const noexcept;
+
+        /*
+            Returns true once every mip level has been written to the destination buffer.
+            For PNG files, that is once the checksums of the image-data have been checked too.
+        */
+        [[nodiscard]] bool isDone() const noexcept;
+
+        /*
+            Gets the decoder ready for a new file.
+            Memory is kept around to be reused for the next file.
+        */
+        void reset() noexcept;
+
+        /*
+            Frees all memory held by the decoder, and gets it ready for a new file.
+        */
+        void releaseMemory() noexcept;
+
+    private:
+        // Makes sure the buffer holds atleast `size` bytes, keeping its contents.
+        [[nodiscard]] Result reserveBuffer(std::size_t size) noexcept;
+        [[nodiscard]] std::byte* allocateWorkingMemory(std::size_t size) noexcept;
+        void deallocateWorkingMemory(std::byte* ptr) noexcept;
+
+        Allocator* m_allocator = nullptr;
+
+        // Holds the bytes fed before they could be decoded.
+        ByteSpan m_buffer = {};
+        std::size_t m_bufferSize = 0;
+        // Amount of bytes fed since the start of the file.
+        std::size_t m_streamPos = 0;
+        // Parsing is not attempted again until this many bytes have been fed.
+        std::size_t m_parseStreamPosRequired = 0;
+        // Stream position of the first byte of image-data.
+        std::size_t m_imageDataStreamPos = 0;
+        bool m_hasFileInfo = false;
+        FileInfo m_fileInfo = {};
+
+        ByteSpan m_dstBuffer = {};
+        ByteSpan m_workingMem = {};
+        detail::InflateContext* m_inflateContext = nullptr;
+        detail::IncrementalDecoder_BackendData m_backendData{};
+
+        Result m_error = { ResultType::Success, nullptr };
+
+        friend detail::PrivateAccessor;
+    };
+}
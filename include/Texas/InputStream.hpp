@@ -9,14 +9,90 @@ namespace Texas
 {
 	/*
 		Polymorphic stream interface for reading bytes.
+
+		Texas only calls seek() when it has to go somewhere the stream is not already at.
+		Streams that can not seek, like pipes and sockets, can be used
+		with Texas::loadFromStream, or with Texas::probeStream followed right away by
+		Texas::loadImageData on the same stream.
+		seek() is then never called, and tell() only has to count the bytes consumed.
 	*/
 	class InputStream
 	{
 	public:
+		// Returned by size() when the stream does not know its own size.
+		static constexpr std::size_t unknownSize = static_cast<std::size_t>(-1);
+
+		// How a range of the stream is about to be used. See hint().
+		enum class AccessHint : char
+		{
+			// The range is about to be read from front to back, through many smaller reads.
+			Sequential,
+			// The range is about to be read.
+			WillNeed,
+			// The range has been read, and Texas won't read it again.
+			DontNeed
+		};
+
 		[[nodiscard]] virtual Result read(ByteSpan dst) noexcept = 0;
 		virtual void ignore(std::size_t amount) noexcept = 0;
 
 		[[nodiscard]] virtual std::size_t tell() noexcept = 0;
 		virtual void seek(std::size_t pos) noexcept = 0;
+
+		/*
+			Returns the size of the entire stream in bytes, or unknownSize.
+			Optional to implement. Lets wrappers like Texas::BufferedInputStream
+			read ahead without ever reading past the end of the stream.
+		*/
+		[[nodiscard]] virtual std::size_t size() noexcept
+		{
+			return unknownSize;
+		}
+
+		/*
+			Fills every span in dsts, in order, with the bytes that come next in the stream.
+			Same as calling read() once for each span.
+			Optional to implement. Streams where every read is a call to the OS can
+			fill all of them at once, like readv() on POSIX.
+		*/
+		[[nodiscard]] virtual Result readVectored(Span<ByteSpan const> dsts) noexcept
+		{
+			for (std::size_t i = 0; i < dsts.size(); i++)
+			{
+				Result const result = read(dsts.data()[i]);
+				if (!result.isSuccessful())
+					return result;
+			}
+			return { ResultType::Success, nullptr };
+		}
+
+		/*
+			Returns a span over the next amount bytes of the stream, straight from memory
+			the stream already holds them in, and moves the stream past them.
+			The bytes stay valid until the next call to any other function of the stream.
+			Returns an empty span if the stream can't, without moving it,
+			and the bytes have to be read with read() instead.
+			Optional to implement. Lets streams that hold the file in memory hand
+			the compressed data of PNG files to the decompressor without copying it.
+		*/
+		[[nodiscard]] virtual ConstByteSpan acquire(std::size_t amount) noexcept
+		{
+			(void)amount;
+			return {};
+		}
+
+		/*
+			Tells the stream how the length bytes starting at pos are about to be used,
+			so it can fetch them ahead of time, or let go of them once they have been read.
+			A length of 0 covers everything from pos to the end of the stream.
+			Texas calls this before and after reading image-data.
+			Optional to implement. Must not change the position of the stream.
+		*/
+		virtual void hint(std::size_t pos, std::size_t length, AccessHint access) noexcept
+		{
+			(void)pos;
+			(void)length;
+			(void)access;
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Texas/InputStream.hpp"
+#include "Texas/Result.hpp"
+#include "Texas/Span.hpp"
+
+// Include detail headers
+#include "Texas/detail/MemoryMapping.hpp"
+#include "Texas/detail/PrivateAccessor_Declaration.hpp"
+
+#include <cstddef>
+
+namespace Texas
+{
+    /*
+        InputStream that reads from a file mapped into memory.
+
+        Reads are served straight from the mapping, 
+        so there is no file-IO call or intermediate buffer involved.
+        acquire() hands out spans into the mapping, so the compressed data
+        of PNG files is decompressed without being copied at all.
+
+        Hints are passed on to the OS through madvise() on POSIX. AccessHint::DontNeed
+        only releases the pages from this mapping, they stay in the OS file cache.
+    */
+    class MappedFileStream : public InputStream
+    {
+    public:
+        MappedFileStream() noexcept = default;
+        MappedFileStream(MappedFileStream const&) = delete;
+        MappedFileStream(MappedFileStream&&) noexcept;
+
+        MappedFileStream& operator=(MappedFileStream const&) = delete;
+        MappedFileStream& operator=(MappedFileStream&&) noexcept;
+
+        virtual ~MappedFileStream();
+
+        /*
+            Maps the file at the specified path into memory and places the stream at the start of it.
+            Any previously mapped file is unmapped first.
+        */
+        [[nodiscard]] Result open(char const* path) noexcept;
+
+        /*
+            Unmaps the file. Does nothing if no file is mapped.
+        */
+        void close() noexcept;
+
+        /*
+            Returns a span over the entire mapped file.
+        */
+        [[nodiscard]] ConstByteSpan data() const noexcept;
+
+        [[nodiscard]] virtual Result read(ByteSpan dst) noexcept override;
+        virtual void ignore(std::size_t amount) noexcept override;
+        [[nodiscard]] virtual ConstByteSpan acquire(std::size_t amount) noexcept override;
+
+        [[nodiscard]] virtual std::size_t tell() noexcept override;
+        virtual void seek(std::size_t pos) noexcept override;
+        [[nodiscard]] virtual std::size_t size() noexcept override;
+        virtual void hint(std::size_t pos, std::size_t length, AccessHint access) noexcept override;
+
+    private:
+        detail::MemoryMapping m_mapping{};
+        std::size_t m_offset = 0;
+
+        friend detail::PrivateAccessor;
+    };
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Texas/InputStream.hpp"
+#include "Texas/Result.hpp"
+#include "Texas/Span.hpp"
+
+#include <cstddef>
+// For std::memcpy
+#include <cstring>
+
+namespace Texas
+{
+    /*
+        InputStream that reads from a buffer holding an entire file,
+        such as a file inside an asset pack that is already in memory.
+
+        The class is final and defined entirely in this header.
+        Texas::loadFromStream, Texas::parseStream, Texas::probeStream and Texas::loadImageData
+        have overloads for it, where the KTX and PNG loaders are compiled for this exact type.
+        There, every read is a direct call that gets inlined into the parsers,
+        instead of going through the virtual functions of InputStream.
+        It can still be passed to anything that takes an InputStream.
+    */
+    class MemoryInputStream final : public InputStream
+    {
+    public:
+        inline MemoryInputStream() noexcept = default;
+        /*
+            data must outlive the MemoryInputStream.
+        */
+        inline explicit MemoryInputStream(ConstByteSpan data) noexcept;
+
+        /*
+            Returns a span over the entire buffer.
+        */
+        [[nodiscard]] inline ConstByteSpan data() const noexcept;
+
+        [[nodiscard]] inline virtual Result read(ByteSpan dst) noexcept override;
+        [[nodiscard]] inline virtual Result readVectored(Span<ByteSpan const> dsts) noexcept override;
+        inline virtual void ignore(std::size_t amount) noexcept override;
+        [[nodiscard]] inline virtual ConstByteSpan acquire(std::size_t amount) noexcept override;
+
+        [[nodiscard]] inline virtual std::size_t tell() noexcept override;
+        inline virtual void seek(std::size_t pos) noexcept override;
+        [[nodiscard]] inline virtual std::size_t size() noexcept override;
+
+    private:
+        ConstByteSpan m_data = {};
+        std::size_t m_offset = 0;
+    };
+
+    inline MemoryInputStream::MemoryInputStream(ConstByteSpan data) noexcept :
+        m_data(data)
+    {
+    }
+
+    inline ConstByteSpan MemoryInputStream::data() const noexcept
+    {
+        return m_data;
+    }
+
+    inline Result MemoryInputStream::read(ByteSpan dst) noexcept
+    {
+        if (m_offset > m_data.size() || dst.size() > m_data.size() - m_offset)
+            return { ResultType::PrematureEndOfFile, "Reached premature end of buffer." };
+        if (dst.size() > 0)
+            std::memcpy(dst.data(), m_data.data() + m_offset, dst.size());
+        m_offset += dst.size();
+        return { ResultType::Success, nullptr };
+    }
+
+    inline Result MemoryInputStream::readVectored(Span<ByteSpan const> dsts) noexcept
+    {
+        for (std::size_t i = 0; i < dsts.size(); i++)
+        {
+            Result const result = read(dsts.data()[i]);
+            if (!result.isSuccessful())
+                return result;
+        }
+        return { ResultType::Success, nullptr };
+    }
+
+    inline void MemoryInputStream::ignore(std::size_t amount) noexcept
+    {
+        m_offset += amount;
+    }
+
+    inline ConstByteSpan MemoryInputStream::acquire(std::size_t amount) noexcept
+    {
+        if (m_offset > m_data.size() || amount > m_data.size() - m_offset)
+            return {};
+        ConstByteSpan const returnVal = { m_data.data() + m_offset, amount };
+        m_offset += amount;
+        return returnVal;
+    }
+
+    inline std::size_t MemoryInputStream::tell() noexcept
+    {
+        return m_offset;
+    }
+
+    inline void MemoryInputStream::seek(std::size_t pos) noexcept
+    {
+        m_offset = pos;
+    }
+
+    inline std::size_t MemoryInputStream::size() noexcept
+    {
+        return m_data.size();
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Texas/Allocator.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace Texas
+{
+    /*
+        Size-class pool allocator for image-data.
+
+        Image-data allocations are rounded up to a size-class, there are 4 size-classes 
+        between each power of two from 256 bytes up to 256 MiB. Deallocated blocks are kept 
+        in a cache and handed out again to the next allocation of the same size-class. 
+        Every thread uses its own cache, so threads rarely wait on each other. 
+        A thread whose cache is empty looks in the other threads' caches before 
+        allocating a new block. Larger allocations are not pooled.
+
+        Requests for working-memory, new blocks and unpooled allocations are forwarded 
+        to the upstream allocator. Without an upstream allocator they use dynamic allocations 
+        if TEXAS_ENABLE_DYNAMIC_ALLOCATIONS is defined, and otherwise fail.
+
+        A PoolAllocator can be used from several threads at once.
+        Every allocation must be deallocated before the PoolAllocator is destroyed.
+    */
+    class PoolAllocator final : public Allocator
+    {
+    public:
+        static constexpr std::size_t minBlockSize = 256;
+        static constexpr std::size_t maxBlockSize = std::size_t(256) << 20;
+        static constexpr std::uint8_t sizeClassCount = 81;
+        static constexpr std::uint8_t cacheCount = 8;
+
+        struct Statistics
+        {
+            // Amount of image-data allocations.
+            std::uint64_t allocationCount = 0;
+            // Amount of image-data allocations that were served from a cache.
+            std::uint64_t cacheHitCount = 0;
+            // Amount of allocations forwarded because they were working-memory, new blocks or too large.
+            std::uint64_t forwardedAllocationCount = 0;
+            // Bytes of image-data currently handed out, after rounding up to size-classes.
+            std::size_t bytesInUse = 0;
+            // Highest value bytesInUse has had.
+            std::size_t peakBytesInUse = 0;
+            // Bytes kept in the caches.
+            std::size_t bytesCached = 0;
+        };
+
+        /*
+            maxCachedBytes limits how many bytes each thread's cache keeps, 
+            blocks deallocated beyond this are handed back.
+        */
+        explicit PoolAllocator(Allocator* upstream = nullptr, std::size_t maxCachedBytes = std::size_t(64) << 20) noexcept;
+        PoolAllocator(PoolAllocator const&) = delete;
+        PoolAllocator& operator=(PoolAllocator const&) = delete;
+        ~PoolAllocator();
+
+        [[nodiscard]] virtual std::byte* allocate(std::size_t amount, MemoryType memType) override;
+        virtual void deallocate(std::byte* ptr, MemoryType memType) override;
+
+        /*
+            Hands all cached blocks back.
+        */
+        void trim() noexcept;
+
+        [[nodiscard]] Statistics statistics() const noexcept;
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct Cache
+        {
+            std::mutex mutex;
+            FreeBlock* freeLists[sizeClassCount] = {};
+            std::size_t bytesCached = 0;
+        };
+
+        [[nodiscard]] Cache& threadCache() noexcept;
+        [[nodiscard]] std::byte* allocateUpstream(std::size_t amount, MemoryType memType) noexcept;
+        void deallocateUpstream(std::byte* ptr, MemoryType memType) noexcept;
+        void addBytesInUse(std::size_t amount) noexcept;
+
+        Allocator* m_upstream = nullptr;
+        std::size_t m_maxCachedBytes = 0;
+        Cache m_caches[cacheCount];
+
+        std::atomic<std::uint64_t> m_allocationCount{ 0 };
+        std::atomic<std::uint64_t> m_cacheHitCount{ 0 };
+        std::atomic<std::uint64_t> m_forwardedAllocationCount{ 0 };
+        std::atomic<std::size_t> m_bytesInUse{ 0 };
+        std::atomic<std::size_t> m_peakBytesInUse{ 0 };
+        std::atomic<std::size_t> m_bytesCached{ 0 };
+    };
+}
@@ -2,6 +2,9 @@
 
 #include "Texas/Result.hpp"
 
+// For placement new
+#include <new>
+
 namespace Texas
 {
     /*
@@ -14,7 +17,7 @@ namespace Texas
     class ResultValue
     {
     public:
-        ResultValue() noexcept = default;
+        ResultValue() noexcept;
         ResultValue(ResultValue<T> const&) noexcept;
         ResultValue(ResultValue<T>&&) noexcept;
         ResultValue(T const&) noexcept;
@@ -31,6 +34,8 @@ namespace Texas
         ResultValue(ResultType resultType, char const* errorMessage) noexcept;
         ~ResultValue() noexcept;
 
+        ResultValue<T>& operator=(ResultValue<T>&&) noexcept;
+
         [[nodiscard]] ResultType resultType() const noexcept;
         [[nodiscard]] char const* errorMessage() const noexcept;
 
@@ -74,22 +79,30 @@ namespace Texas
     };
 
     template<typename T>
-    ResultValue<T>::ResultValue(ResultValue<T> const& other) noexcept
+    ResultValue<T>::ResultValue() noexcept :
+        m_valueBuffer()
+    {
+    }
+
+    template<typename T>
+    ResultValue<T>::ResultValue(ResultValue<T> const& other) noexcept :
+        m_result(other.m_result),
+        m_valueBuffer()
     {
-        m_result = other.m_result;
         if (m_result.isSuccessful())
         {
-            new(m_value) T(other);
+            new(&m_value) T(other.m_value);
         }
     }
 
     template<typename T>
-    ResultValue<T>::ResultValue(ResultValue<T>&& other) noexcept
+    ResultValue<T>::ResultValue(ResultValue<T>&& other) noexcept :
+        m_result(other.m_result),
+        m_valueBuffer()
     {
-        m_result = other.m_result;
-        if (other.m_result.isSuccessful())
+        if (m_result.isSuccessful())
         {
-            new(m_value) T(static_cast<T&&>(other.m_value));
+            new(&m_value) T(static_cast<T&&>(other.m_value));
         }
     }
 
@@ -121,6 +134,21 @@ namespace Texas
             m_value.~T();
     }
 
+    template<typename T>
+    ResultValue<T>& ResultValue<T>::operator=(ResultValue<T>&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        if (isSuccessful())
+            m_value.~T();
+        m_result = other.m_result;
+        if (m_result.isSuccessful())
+            new(&m_value) T(static_cast<T&&>(other.m_value));
+
+        return *this;
+    }
+
     template<typename T>
     ResultType ResultValue<T>::resultType() const noexcept
     {
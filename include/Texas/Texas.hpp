@@ -1,16 +1,38 @@
 #pragma once
 
 #include "Texas/InputStream.hpp"
+#include "Texas/BufferedInputStream.hpp"
+#include "Texas/FileStream.hpp"
+#include "Texas/MemoryInputStream.hpp"
 #include "Texas/ResultValue.hpp"
 #include "Texas/Span.hpp"
 #include "Texas/FileInfo.hpp"
 #include "Texas/Texture.hpp"
+#include "Texas/TextureView.hpp"
 #include "Texas/Allocator.hpp"
+#include "Texas/ImageDataLayout.hpp"
+#include "Texas/ImageDataRange.hpp"
+#include "Texas/ArenaAllocator.hpp"
+#include "Texas/PoolAllocator.hpp"
+#include "Texas/TextureLoader.hpp"
+#include "Texas/IncrementalDecoder.hpp"
 
 #if defined(TEXAS_ENABLE_KTX_SAVE)
 #   include "Texas/KTX_Save.hpp"
 #endif
 
+#if defined(TEXAS_ENABLE_PNG_SAVE)
+#   include "Texas/PNG_Save.hpp"
+#endif
+
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+#   include "Texas/MappedFileStream.hpp"
+#endif
+
+#if defined(TEXAS_ENABLE_BATCH_LOADING)
+#   include "Texas/BatchLoad.hpp"
+#endif
+
 namespace Texas
 {
     /*
@@ -22,6 +44,16 @@ namespace Texas
     */
     [[nodiscard]] ResultValue<Texture> loadFromPath(char const* path, Allocator& allocator) noexcept;
 
+    /*
+        Loads an entire texture from a file that is already in memory, without copying its image-data.
+
+        Only works for files whose image-data is already stored in its final layout, as with KTX files.
+        The returned TextureView points straight into fileData, which must outlive it.
+        Returns ResultType::FileNotSupported for files that have to be decoded, such as PNG files.
+        Load those with Texas::loadFromStream and a Texas::MemoryInputStream instead.
+    */
+    [[nodiscard]] ResultValue<TextureView> loadFromMemory(ConstByteSpan fileData) noexcept;
+
     /*
         Parses for texture-info from a polymorphic stream
 
@@ -29,6 +61,16 @@ namespace Texas
     */
     [[nodiscard]] ResultValue<FileInfo> parseStream(InputStream& stream) noexcept;
 
+    /*
+        Parses for texture-info from a polymorphic stream, 
+        but only reads the file up to where its image-data starts.
+
+        This is much faster than Texas::parseStream for PNG files, which otherwise have every chunk
+        in the file visited. Use this when only the dimensions and pixel-format are needed. 
+        The file is validated less thoroughly, but the result can still be used with Texas::loadImageData.
+    */
+    [[nodiscard]] ResultValue<FileInfo> probeStream(InputStream& stream) noexcept;
+
     /*
         Loads imagedata into dstBuffer by using information gathered with Texas::parseStream
     */
@@ -37,8 +79,110 @@ namespace Texas
         FileInfo const& file, 
         ByteSpan dstBuffer,
         ByteSpan workingMemory) noexcept;
+
+    /*
+        Loads imagedata into dstBuffer by using information gathered with Texas::parseStream,
+        where every mip level, array layer and row is placed as described by dstLayout.
+
+        This lets the image-data be written straight into a mapped GPU staging buffer
+        in the layout the copy to the image expects. 
+        Use Texas::calculateImageDataLayout to make a layout that follows the 
+        offset and row-pitch alignment of your graphics API.
+        dstBuffer must be atleast as large as the furthest byte the layout places image-data at.
+    */
+    [[nodiscard]] Result loadImageData(
+        InputStream& stream,
+        FileInfo const& file,
+        ByteSpan dstBuffer,
+        ImageDataLayout const& dstLayout,
+        ByteSpan workingMemory) noexcept;
+
+    /*
+        Loads only the mip levels and array layers in range into dstBuffer, 
+        by using information gathered with Texas::parseStream.
+
+        The image-data is tightly packed, and dstBuffer must be atleast 
+        Texas::FileInfo::memoryRequired(range) bytes.
+        The stream is moved to the image-data by itself, so different ranges
+        can be loaded from the same stream and FileInfo, in any order.
+        KTX files are indexed when parsed, so reaching the first mip level of the range
+        takes a single seek. Ranges can also be loaded in parallel, with one stream per thread
+        sharing the same FileInfo.
+    */
+    [[nodiscard]] Result loadImageData(
+        InputStream& stream,
+        FileInfo const& file,
+        ImageDataRange const& range,
+        ByteSpan dstBuffer,
+        ByteSpan workingMemory) noexcept;
+
+    /*
+        Loads only the mip levels and array layers in range into dstBuffer, 
+        placed as described by dstLayout.
+
+        Layer indices in dstLayout are relative to range.baseLayer. 
+        Use the Texas::calculateImageDataLayout overload that takes a range to make one.
+    */
+    [[nodiscard]] Result loadImageData(
+        InputStream& stream,
+        FileInfo const& file,
+        ImageDataRange const& range,
+        ByteSpan dstBuffer,
+        ImageDataLayout const& dstLayout,
+        ByteSpan workingMemory) noexcept;
+
+    /*
+        Same as the functions above, but for a texture that is already in memory.
+
+        The KTX and PNG loaders are compiled separately for Texas::MemoryInputStream,
+        so every read is inlined into them instead of going through a virtual call.
+        Use these for textures inside memory-resident asset packs.
+    */
+    [[nodiscard]] ResultValue<Texture> loadFromStream(MemoryInputStream& stream, Allocator& allocator) noexcept;
+    [[nodiscard]] ResultValue<FileInfo> parseStream(MemoryInputStream& stream) noexcept;
+    [[nodiscard]] ResultValue<FileInfo> probeStream(MemoryInputStream& stream) noexcept;
+    [[nodiscard]] Result loadImageData(
+        MemoryInputStream& stream,
+        FileInfo const& file,
+        ByteSpan dstBuffer,
+        ByteSpan workingMemory) noexcept;
+    [[nodiscard]] Result loadImageData(
+        MemoryInputStream& stream,
+        FileInfo const& file,
+        ByteSpan dstBuffer,
+        ImageDataLayout const& dstLayout,
+        ByteSpan workingMemory) noexcept;
+    [[nodiscard]] Result loadImageData(
+        MemoryInputStream& stream,
+        FileInfo const& file,
+        ImageDataRange const& range,
+        ByteSpan dstBuffer,
+        ByteSpan workingMemory) noexcept;
+    [[nodiscard]] Result loadImageData(
+        MemoryInputStream& stream,
+        FileInfo const& file,
+        ImageDataRange const& range,
+        ByteSpan dstBuffer,
+        ImageDataLayout const& dstLayout,
+        ByteSpan workingMemory) noexcept;
 }
 
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+namespace Texas
+{
+    /*
+        Loads an entire texture by mapping the file at the specified path into memory, 
+        by using a custom memory allocator.
+
+        If the file's image-data is already stored in its final layout, as with KTX files,
+        the returned Texture points straight into the mapping and keeps it alive.
+        No image-data is copied and the allocator is not used.
+        Other files are decoded from the mapping into memory from the allocator.
+    */
+    [[nodiscard]] ResultValue<Texture> loadFromPathMapped(char const* path, Allocator& allocator) noexcept;
+}
+#endif
+
 #ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
 namespace Texas
 {
@@ -48,6 +192,13 @@ namespace Texas
         Note: This loading path uses dynamic allocations in the implementation.
     */
     [[nodiscard]] ResultValue<Texture> loadFromStream(InputStream& stream) noexcept;
+    /*
+        Loads an entire texture that is already in memory, 
+        with every read inlined into the loaders.
+
+        Note: This loading path uses dynamic allocations in the implementation.
+    */
+    [[nodiscard]] ResultValue<Texture> loadFromStream(MemoryInputStream& stream) noexcept;
 
     /*
         Loads an entire texture from file at the specified path
@@ -55,5 +206,18 @@ namespace Texas
         Note: This loading path uses dynamic allocations in the implementation.
     */
     [[nodiscard]] ResultValue<Texture> loadFromPath(char const* path) noexcept;
+
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+    /*
+        Loads an entire texture by mapping the file at the specified path into memory.
+
+        If the file's image-data is already stored in its final layout, as with KTX files,
+        the returned Texture points straight into the mapping and keeps it alive.
+
+        Note: This loading path uses dynamic allocations in the implementation
+        for files that have to be decoded.
+    */
+    [[nodiscard]] ResultValue<Texture> loadFromPathMapped(char const* path) noexcept;
+#endif
 }
 #endif
\ No newline at end of file
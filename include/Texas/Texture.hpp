@@ -6,6 +6,9 @@
 
 // Include detail headers
 #include "Texas/detail/PrivateAccessor_Declaration.hpp"
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+#   include "Texas/detail/MemoryMapping.hpp"
+#endif
 
 #include <cstddef>
 #include <cstdint>
@@ -43,6 +46,9 @@ namespace Texas
         /*
             Returns the offset from the start of the imagedata to the specified mip level.
 
+            If the imagedata points into a memory-mapped KTX file, the offset
+            accounts for the 'imageSize' fields and padding stored in the file.
+
             Causes undefined behavior if: 
              - The texture's contents have been moved through move-semantics.
              - mipIndex is equal to or higher than .mipCount().
@@ -80,6 +86,9 @@ namespace Texas
 
         /*
             Returns a span to the internal buffer of the Texture object.
+
+            If the imagedata points into a memory-mapped KTX file, the span covers
+            the file's entire image-data section, including its 'imageSize' fields and padding.
         */
         [[nodiscard]] ConstByteSpan rawBufferSpan() const;
 
@@ -90,12 +99,19 @@ namespace Texas
         [[nodiscard]] std::byte const* layerData(std::uint8_t mipIndex, std::uint64_t layerIndex) const;
         [[nodiscard]] std::byte const* rawBufferData() const;
         [[nodiscard]] std::uint64_t totalDataSize() const;
+        // Returns true if the imagedata points straight into a memory-mapped file.
+        [[nodiscard]] bool isMapped() const;
 
         void deallocateInternalBuffer();
 
         TextureInfo m_textureInfo{};
         ByteSpan m_buffer = {};
         Allocator* m_allocator = nullptr;
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+        // Only used when the imagedata points straight into a memory-mapped file.
+        detail::MemoryMapping m_mapping{};
+        ConstByteSpan m_mappedBuffer = {};
+#endif
 
         friend detail::PrivateAccessor;
     };
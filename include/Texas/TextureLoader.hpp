@@ -0,0 +1,159 @@
+#pragma once
+
+#include "Texas/Allocator.hpp"
+#include "Texas/FileInfo.hpp"
+#include "Texas/ImageDataLayout.hpp"
+#include "Texas/ImageDataRange.hpp"
+#include "Texas/InputStream.hpp"
+#include "Texas/MemoryInputStream.hpp"
+#include "Texas/Result.hpp"
+#include "Texas/ResultValue.hpp"
+#include "Texas/Span.hpp"
+#include "Texas/Texture.hpp"
+
+// Include detail headers
+#include "Texas/detail/PrivateAccessor_Declaration.hpp"
+
+#include <cstddef>
+
+namespace Texas::detail
+{
+    class InflateContext;
+}
+
+namespace Texas
+{
+    /*
+        Loads textures one after another while keeping state around between loads.
+
+        Working-memory is kept in a pool that only grows when a file needs more than any file before it,
+        and the decompression state is reset between loads instead of being recreated.
+        After the first few loads, loading a texture only allocates the memory for its image-data.
+        Loading with .loadImageData() does not allocate at all.
+
+        A TextureLoader must only be used by one thread at a time.
+    */
+    class TextureLoader
+    {
+    public:
+        /*
+            Creates a TextureLoader that gets all its memory from allocator.
+            The allocator must outlive the TextureLoader, and every Texture it loads.
+        */
+        explicit TextureLoader(Allocator& allocator) noexcept;
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+        /*
+            Creates a TextureLoader that uses dynamic allocations for its memory.
+        */
+        TextureLoader() noexcept;
+#endif
+        TextureLoader(TextureLoader const&) = delete;
+        TextureLoader(TextureLoader&&) noexcept;
+
+        TextureLoader& operator=(TextureLoader const&) = delete;
+        TextureLoader& operator=(TextureLoader&&) noexcept;
+
+        ~TextureLoader();
+
+        /*
+            Loads an entire texture from a polymorphic stream.
+        */
+        [[nodiscard]] ResultValue<Texture> loadFromStream(InputStream& stream) noexcept;
+        /*
+            Loads an entire texture that is already in memory, with every read inlined into the loaders.
+        */
+        [[nodiscard]] ResultValue<Texture> loadFromStream(MemoryInputStream& stream) noexcept;
+
+        /*
+            Loads an entire texture from file at the specified path.
+        */
+        [[nodiscard]] ResultValue<Texture> loadFromPath(char const* path) noexcept;
+
+        /*
+            Loads imagedata into dstBuffer by using information gathered with Texas::parseStream.
+            Working-memory is taken from the TextureLoader's pool.
+        */
+        [[nodiscard]] Result loadImageData(
+            InputStream& stream,
+            FileInfo const& file,
+            ByteSpan dstBuffer) noexcept;
+
+        /*
+            Loads imagedata into dstBuffer in the layout described by dstLayout,
+            by using information gathered with Texas::parseStream.
+            Working-memory is taken from the TextureLoader's pool.
+        */
+        [[nodiscard]] Result loadImageData(
+            InputStream& stream,
+            FileInfo const& file,
+            ByteSpan dstBuffer,
+            ImageDataLayout const& dstLayout) noexcept;
+
+        /*
+            Loads only the mip levels and array layers in range into dstBuffer, tightly packed.
+            Working-memory is taken from the TextureLoader's pool.
+        */
+        [[nodiscard]] Result loadImageData(
+            InputStream& stream,
+            FileInfo const& file,
+            ImageDataRange const& range,
+            ByteSpan dstBuffer) noexcept;
+
+        /*
+            Loads only the mip levels and array layers in range into dstBuffer, 
+            placed as described by dstLayout.
+            Working-memory is taken from the TextureLoader's pool.
+        */
+        [[nodiscard]] Result loadImageData(
+            InputStream& stream,
+            FileInfo const& file,
+            ImageDataRange const& range,
+            ByteSpan dstBuffer,
+            ImageDataLayout const& dstLayout) noexcept;
+
+#if defined(TEXAS_ENABLE_PNG_PIPELINING)
+        /*
+            Makes every load after this decode large PNG files on two threads,
+            one that decompresses rows and one that defilters them, at the same time.
+            Off by default. The working-memory pool grows by a ring buffer of rows 
+            between the two threads, and a thread is started for every such load.
+            Worth it for large single images, like heightmaps and lightmaps, when there are idle cores.
+
+            PNG files whose image-data is split in segments, by an 'iDOT' chunk or by 
+            Texas::PNG::saveToStream, are instead decoded on one thread per segment when 
+            the stream can hand out the whole file with acquire(), like a Texas::MemoryInputStream.
+            The pool then grows to hold all of the filtered image-data, and every such load
+            starts a new thread for each segment after the first, up to 15 of them,
+            and joins them before it returns. That cost is paid per file, so it only pays off
+            when the segments are large.
+        */
+        void setPipelinedDecoding(bool enabled) noexcept;
+#endif
+
+        /*
+            Returns the size of the working-memory pool in bytes.
+        */
+        [[nodiscard]] std::size_t workingMemoryCapacity() const noexcept;
+
+        /*
+            Frees the working-memory pool and the decompression state.
+            They are recreated by the next load that needs them.
+        */
+        void releaseMemory() noexcept;
+
+    private:
+        // Makes sure the working-memory pool holds atleast `size` bytes.
+        [[nodiscard]] Result reserveWorkingMemory(std::size_t size) noexcept;
+        // Makes sure the working-memory pool can load the image-data of file.
+        [[nodiscard]] Result reserveWorkingMemory(FileInfo const& file) noexcept;
+        [[nodiscard]] std::byte* allocateWorkingMemory(std::size_t size) noexcept;
+        void deallocateWorkingMemory(std::byte* ptr) noexcept;
+
+        Allocator* m_allocator = nullptr;
+        ByteSpan m_workingMem = {};
+        detail::InflateContext* m_inflateContext = nullptr;
+        bool m_pipelinedDecoding = false;
+
+        friend detail::PrivateAccessor;
+    };
+}
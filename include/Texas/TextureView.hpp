@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Texas/TextureInfo.hpp"
+#include "Texas/Span.hpp"
+
+// Include detail headers
+#include "Texas/detail/PrivateAccessor_Declaration.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Texas
+{
+    /*
+        Represents a texture whose imagedata is used in-place, straight out of a file in memory.
+        Returned by Texas::loadFromMemory.
+
+        A TextureView does not own anything. The file it was loaded from
+        must outlive the TextureView, and every span it returns.
+
+        The imagedata is laid out like the KTX file it points into,
+        so the offsets account for the 'imageSize' fields and padding stored in the file.
+    */
+    class TextureView
+    {
+    public:
+        TextureView() = default;
+
+        [[nodiscard]] TextureInfo const& textureInfo() const;
+        [[nodiscard]] FileFormat fileFormat() const;
+        [[nodiscard]] TextureType textureType() const;
+        [[nodiscard]] PixelFormat pixelFormat() const;
+        [[nodiscard]] ChannelType channelType() const;
+        [[nodiscard]] ColorSpace colorSpace() const;
+        [[nodiscard]] Dimensions baseDimensions() const;
+        [[nodiscard]] std::uint8_t mipCount() const;
+        [[nodiscard]] std::uint64_t layerCount() const;
+
+        /*
+            Returns the offset from the start of the imagedata to the specified mip level.
+
+            Causes undefined behavior if:
+             - mipIndex is equal to or higher than .mipCount().
+        */
+        [[nodiscard]] std::uint64_t mipOffset(std::uint8_t mipIndex) const;
+
+        /*
+            Returns a span to the imagedata of the specified mip level.
+
+            Causes undefined behavior if:
+             - mipIndex is equal to or higher than .mipCount().
+        */
+        [[nodiscard]] ConstByteSpan mipSpan(std::uint8_t mipIndex) const;
+
+        /*
+            Returns the offset from the start the imagedata to the specified layer at the specified mip level.
+
+            Causes undefined behavior if:
+             - If mipIndex is equal to or higher than .mipCount().
+             - If layerIndex is equal to or higher than .layerCount().
+        */
+        [[nodiscard]] std::uint64_t layerOffset(std::uint8_t mipIndex, std::uint64_t layerIndex) const;
+
+        /*
+            Returns a span to the image-data of the specified layer at the specified mip level.
+
+            Causes undefined behavior if:
+             - If mipIndex is equal to or higher than .mipCount().
+             - If layerIndex is equal to or higher than .layerCount().
+        */
+        [[nodiscard]] ConstByteSpan layerSpan(std::uint8_t mipIndex, std::uint64_t layerIndex) const;
+
+        /*
+            Returns a span over the file's entire image-data section,
+            including its 'imageSize' fields and padding.
+        */
+        [[nodiscard]] ConstByteSpan rawBufferSpan() const;
+
+    private:
+        [[nodiscard]] std::uint64_t layerSize(std::uint8_t mipIndex) const;
+
+        TextureInfo m_textureInfo{};
+        ConstByteSpan m_imageData = {};
+
+        friend detail::PrivateAccessor;
+    };
+}
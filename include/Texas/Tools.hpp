@@ -3,6 +3,8 @@
 #include "Texas/PixelFormat.hpp"
 #include "Texas/Dimensions.hpp"
 #include "Texas/TextureInfo.hpp"
+#include "Texas/ImageDataLayout.hpp"
+#include "Texas/ImageDataRange.hpp"
 
 #include <cstdint>
 
@@ -73,4 +75,40 @@ namespace Texas
         Does not work for cubemaps.
     */
     [[nodiscard]] std::uint64_t calculateSingleImageSize(Dimensions dimensions, PixelFormat pixelFormat) noexcept;
+
+    /*
+        Returns the size in bytes of a single row of an image.
+        For block-compressed formats this is the size of a row of blocks.
+    */
+    [[nodiscard]] std::uint64_t calculateRowSize(Dimensions dimensions, PixelFormat pixelFormat) noexcept;
+
+    /*
+        Returns the amount of rows in a single depth slice of an image.
+        For block-compressed formats this is the amount of rows of blocks.
+    */
+    [[nodiscard]] std::uint64_t calculateRowCount(Dimensions dimensions, PixelFormat pixelFormat) noexcept;
+
+    /*
+        Returns a layout for a texture's image-data where every mip level starts
+        at a multiple of offsetAlignment, and every row starts at a multiple of rowPitchAlignment
+        relative to the start of its mip level. Array layers and depth slices are not padded further.
+
+        Passing 1 or 0 for both alignments gives the same layout as Texas::Texture.
+        The alignments do not need to be powers of two.
+    */
+    [[nodiscard]] ImageDataLayout calculateImageDataLayout(
+        TextureInfo const& textureInfo,
+        std::uint64_t offsetAlignment,
+        std::uint64_t rowPitchAlignment) noexcept;
+
+    /*
+        Returns a layout that only holds the mip levels and array layers in range.
+        The first mip level in the range is placed at offset 0, 
+        and the mip levels outside the range are left zeroed.
+    */
+    [[nodiscard]] ImageDataLayout calculateImageDataLayout(
+        TextureInfo const& textureInfo,
+        ImageDataRange const& range,
+        std::uint64_t offsetAlignment,
+        std::uint64_t rowPitchAlignment) noexcept;
 }
\ No newline at end of file
@@ -7,15 +7,47 @@ namespace Texas::detail
 {
     struct FileInfo_KTX_BackendData
     {
+        // KTX files can not have more mip levels than this.
+        static constexpr std::uint8_t maxMipCount = 32;
+
+        // Stream position of the 'imageSize' field of the first mip level.
+        std::size_t imageDataStreamPos = 0;
+        /*
+            Stream position of the 'imageSize' field of each mip level.
+            Calculated from the header, so it's only correct when every 'imageSize' field
+            matches the size Texas calculates. Has to be checked before it's trusted.
+        */
+        std::size_t mipStreamPos[maxMipCount] = {};
     };
 
 	struct FileInfo_PNG_BackendData
     {
+        // Largest size a PNG PLTE chunk's data can have.
+        static constexpr std::uint32_t maxPlteChunkDataLength = 768;
+
         std::size_t firstIdatChunkStreamPos = 0;
-        std::uint32_t maxIdatChunkDataLength = 0;
-        // Leave as 0 if no PLTE chunk is found.
-        std::size_t plteChunkStreamPos = 0;
+        std::uint32_t firstIdatChunkDataLength = 0;
+        // Stream position right after the CRC of the last IDAT chunk. Left as 0 if the file was probed.
+        std::size_t idatChunksEndStreamPos = 0;
+        // Leave as 0 if the image does not use indexed colours.
         std::uint32_t plteChunkDataLength = 0;
+        // The colours of the PLTE chunk are kept here when parsing,
+        // so decoding never has to go back in the stream for them.
+        std::byte plteChunkData[maxPlteChunkDataLength] = {};
+
+        // Most segments we keep track of, files with more are decoded as if they had none.
+        static constexpr std::uint32_t maxSegmentCount = 16;
+        /*
+            Segments of the IDAT data that can be decompressed independently,
+            as described by an 'iDOT' or 'txSG' chunk. Each segment starts at an IDAT chunk,
+            right after the zLib data-stream was flushed with Z_FULL_FLUSH.
+            Left as 0 if the file has no such chunk, otherwise it's atleast 2.
+        */
+        std::uint32_t segmentCount = 0;
+        // First row of the image each segment decompresses to. The first segment starts at row 0.
+        std::uint32_t segmentFirstRows[maxSegmentCount] = {};
+        // Stream position of the IDAT chunk each segment starts at.
+        std::size_t segmentChunkStreamPos[maxSegmentCount] = {};
     };
 
     union FileInfo_BackendData
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Texas::detail
+{
+    class InflateContext;
+
+    struct IncrementalDecoder_KTX_BackendData
+    {
+        // Which part of the current mip level the next bytes belong to.
+        enum class Section : std::uint8_t
+        {
+            ImageSize,
+            Payload,
+            Padding,
+            Done
+        };
+
+        Section section = Section::ImageSize;
+        // The 'imageSize' field can be split across two pushes, so it's gathered here.
+        std::byte imageSizeBuffer[4] = {};
+        std::uint8_t imageSizeBytesRead = 0;
+        // Bytes left of the payload or padding of the current mip level.
+        std::uint64_t sectionRemaining = 0;
+        // Mip levels that have been written to the destination buffer in full.
+        std::uint8_t mipsReady = 0;
+        // Bytes written of the mip level currently being decoded.
+        std::uint64_t mipBytesWritten = 0;
+        std::uint64_t dstOffset = 0;
+    };
+
+    struct IncrementalDecoder_PNG_BackendData
+    {
+        // Which part of the chunk stream the next bytes belong to.
+        enum class Section : std::uint8_t
+        {
+            ChunkHeader,
+            IdatData,
+            ChunkCrc,
+            /*
+                Every row has been decoded and the zLib data-stream has ended, anything after that is ignored.
+                With TEXAS_ENABLE_PNG_CRC_CHECK, the CRCs of all IDAT chunks have been checked as well,
+                which we know once the header of the chunk after them has come in.
+            */
+            Done
+        };
+
+        Section section = Section::ChunkHeader;
+        // The 'Length' and 'Chunk type' fields can be split across two pushes, so they're gathered here.
+        std::byte chunkHeaderBuffer[8] = {};
+        std::uint8_t chunkHeaderBytesRead = 0;
+        // Bytes left of the IDAT data or CRC field we are currently in.
+        std::uint32_t sectionRemaining = 0;
+        // CRC of the current chunk's type and data, and its CRC field as it comes in.
+        // Only checked when TEXAS_ENABLE_PNG_CRC_CHECK is defined.
+        std::uint32_t chunkCrc = 0;
+        std::byte chunkCrcBuffer[4] = {};
+        // Rows that have been written to the destination buffer in full.
+        std::uint32_t rowsReady = 0;
+        // Set once zLib has reached the end of the data-stream and checked its Adler-32.
+        bool zLibStreamEnded = false;
+        // Holds the filtered rows zLib decompresses into, two of them when dealing with indexed colours.
+        std::byte* filteredRows = nullptr;
+        InflateContext* inflateContext = nullptr;
+    };
+
+    union IncrementalDecoder_BackendData
+    {
+#ifdef TEXAS_ENABLE_KTX_READ
+        IncrementalDecoder_KTX_BackendData ktx{};
+#endif
+#ifdef TEXAS_ENABLE_PNG_READ
+        IncrementalDecoder_PNG_BackendData png;
+#endif
+    };
+}
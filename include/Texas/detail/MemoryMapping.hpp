@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Texas::detail
+{
+    /*
+        Read-only view of a file that has been mapped into memory.
+        An empty mapping has data equal to nullptr.
+    */
+    struct MemoryMapping
+    {
+        std::byte const* data = nullptr;
+        std::size_t size = 0;
+    };
+}
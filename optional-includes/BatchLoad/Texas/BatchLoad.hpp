@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Texas/Allocator.hpp"
+#include "Texas/InputStream.hpp"
+#include "Texas/Result.hpp"
+#include "Texas/ResultValue.hpp"
+#include "Texas/Span.hpp"
+#include "Texas/Texture.hpp"
+
+#include <cstdint>
+
+namespace Texas
+{
+    /*
+        Loads the files at every path in paths on a pool of threads, by using a custom memory allocator.
+        The result of loading paths[i] is written to results[i].
+
+        threadCount is the amount of threads doing work, including the calling thread.
+        Passing in 0 uses as many threads as the hardware supports.
+        Threads that run out of files take over half of the remaining files of another thread.
+
+        With TEXAS_ENABLE_IO_URING on Linux, files are read through io_uring by the calling thread,
+        while the threads decode the files that have already been read. Files are read whole into
+        working-memory, so atmost 64 MiB of them are read ahead at a time. If the kernel does not
+        support io_uring, files are loaded the same way as without it.
+
+        The allocator is called from several threads at once and must be thread-safe.
+
+        Only returns an error if the batch could not be started.
+        Errors from loading individual files are stored in results.
+    */
+    [[nodiscard]] Result loadFromPaths(
+        Span<char const* const> paths,
+        Span<ResultValue<Texture>> results,
+        Allocator& allocator,
+        std::uint32_t threadCount = 0) noexcept;
+
+    /*
+        Loads a texture from every stream in streams on a pool of threads, by using a custom memory allocator.
+        The result of loading streams[i] is written to results[i].
+
+        Every stream is only read by a single thread. The same stream can not appear twice.
+
+        threadCount is the amount of threads doing work, including the calling thread.
+        Passing in 0 uses as many threads as the hardware supports.
+        Threads that run out of streams take over half of the remaining streams of another thread.
+
+        The allocator is called from several threads at once and must be thread-safe.
+
+        Only returns an error if the batch could not be started.
+        Errors from loading individual streams are stored in results.
+    */
+    [[nodiscard]] Result loadFromStreams(
+        Span<InputStream* const> streams,
+        Span<ResultValue<Texture>> results,
+        Allocator& allocator,
+        std::uint32_t threadCount = 0) noexcept;
+}
+
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+namespace Texas
+{
+    /*
+        Loads the files at every path in paths on a pool of threads.
+        The result of loading paths[i] is written to results[i].
+
+        threadCount is the amount of threads doing work, including the calling thread.
+        Passing in 0 uses as many threads as the hardware supports.
+
+        Note: This loading path uses dynamic allocations in the implementation.
+    */
+    [[nodiscard]] Result loadFromPaths(
+        Span<char const* const> paths,
+        Span<ResultValue<Texture>> results,
+        std::uint32_t threadCount = 0) noexcept;
+
+    /*
+        Loads a texture from every stream in streams on a pool of threads.
+        The result of loading streams[i] is written to results[i].
+
+        Every stream is only read by a single thread. The same stream can not appear twice.
+
+        threadCount is the amount of threads doing work, including the calling thread.
+        Passing in 0 uses as many threads as the hardware supports.
+
+        Note: This loading path uses dynamic allocations in the implementation.
+    */
+    [[nodiscard]] Result loadFromStreams(
+        Span<InputStream* const> streams,
+        Span<ResultValue<Texture>> results,
+        std::uint32_t threadCount = 0) noexcept;
+}
+#endif
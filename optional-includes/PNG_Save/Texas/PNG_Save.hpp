@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Texas/Allocator.hpp"
+#include "Texas/Texture.hpp"
+#include "Texas/Result.hpp"
+#include "Texas/Span.hpp"
+#include "Texas/OutputStream.hpp"
+
+#include <cstdint>
+
+namespace Texas::PNG
+{
+	// Most segments a PNG file can be split into by Texas::PNG::saveToStream.
+	constexpr std::uint32_t maxSegmentCount = 16;
+
+	/*
+		Only single 2D images with one mip level and one array layer can be saved.
+		PixelFormat must be R_8, RG_8, RGB_8 or RGBA_8, with ChannelType UnsignedNormalized.
+	*/
+	[[nodiscard]] Result canSave(TextureInfo const& texInfo) noexcept;
+
+	/*
+		Writes a PNG to polymorphic stream, by using a custom memory allocator.
+
+		If segmentCount is higher than 1, the image is split into that many bands of rows,
+		and the zLib data-stream is flushed at the start of each one so it can be decompressed
+		on its own. Where each segment starts is stored in a 'txSG' chunk, which
+		Texas::TextureLoader uses to decode the segments in parallel when pipelined decoding is on.
+		Other PNG decoders skip the chunk, and read the file like any other PNG.
+		Each segment makes the file slightly larger. segmentCount is lowered to the height
+		of the image if it's higher, and can not be 0 or higher than Texas::PNG::maxSegmentCount.
+
+		The compressed image-data is kept in working-memory from allocator until it's written,
+		because the 'txSG' chunk has to appear before it in the file. zLib's allocations go through it too.
+
+		imageData must be tightly packed.
+	*/
+	[[nodiscard]] Result saveToStream(
+		TextureInfo const& texInfo,
+		ConstByteSpan imageData,
+		OutputStream& stream,
+		Allocator& allocator,
+		std::uint32_t segmentCount = 1) noexcept;
+	/*
+		Writes a PNG to polymorphic stream, by using a custom memory allocator.
+
+		See the overload above for segmentCount.
+	*/
+	[[nodiscard]] Result saveToStream(
+		Texture const& texture,
+		OutputStream& stream,
+		Allocator& allocator,
+		std::uint32_t segmentCount = 1) noexcept;
+
+	/*
+		Writes a PNG to file, by using a custom memory allocator.
+
+		See Texas::PNG::saveToStream for segmentCount.
+	*/
+	[[nodiscard]] Result saveToFile(
+		char const* path,
+		TextureInfo const& texInfo,
+		ConstByteSpan imageData,
+		Allocator& allocator,
+		std::uint32_t segmentCount = 1) noexcept;
+
+	[[nodiscard]] Result saveToFile(
+		char const* path,
+		Texture const& texture,
+		Allocator& allocator,
+		std::uint32_t segmentCount = 1) noexcept;
+}
+
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+namespace Texas::PNG
+{
+	/*
+		Writes a PNG to polymorphic stream.
+
+		See the overload that takes an allocator for segmentCount.
+
+		Note: This saving path uses dynamic allocations in the implementation.
+	*/
+	[[nodiscard]] Result saveToStream(
+		TextureInfo const& texInfo,
+		ConstByteSpan imageData,
+		OutputStream& stream,
+		std::uint32_t segmentCount = 1) noexcept;
+	/*
+		Writes a PNG to polymorphic stream.
+
+		Note: This saving path uses dynamic allocations in the implementation.
+	*/
+	[[nodiscard]] Result saveToStream(
+		Texture const& texture,
+		OutputStream& stream,
+		std::uint32_t segmentCount = 1) noexcept;
+
+	/*
+		Writes a PNG to file.
+
+		Note: This saving path uses dynamic allocations in the implementation.
+	*/
+	[[nodiscard]] Result saveToFile(
+		char const* path,
+		TextureInfo const& texInfo,
+		ConstByteSpan imageData,
+		std::uint32_t segmentCount = 1) noexcept;
+
+	[[nodiscard]] Result saveToFile(char const* path, Texture const& texture, std::uint32_t segmentCount = 1) noexcept;
+}
+#endif
\ No newline at end of file
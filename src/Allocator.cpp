@@ -0,0 +1,47 @@
+#include "Texas/Allocator.hpp"
+
+#include "NumericLimits.hpp"
+
+#include <cstring>
+
+namespace Texas::detail
+{
+    // Stored right before the pointer returned by Allocator::allocateAligned.
+    using AlignedOffset_T = std::size_t;
+}
+
+std::byte* Texas::Allocator::allocateAligned(std::size_t amount, std::size_t alignment, MemoryType memType)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+        return nullptr;
+    if (alignment < alignof(detail::AlignedOffset_T))
+        alignment = alignof(detail::AlignedOffset_T);
+
+    std::size_t const overhead = sizeof(detail::AlignedOffset_T) + alignment - 1;
+    if (amount > detail::maxValue<std::size_t>() - overhead)
+        return nullptr;
+
+    std::byte* const block = allocate(amount + overhead, memType);
+    if (block == nullptr)
+        return nullptr;
+
+    std::uintptr_t const blockAddress = reinterpret_cast<std::uintptr_t>(block);
+    std::uintptr_t const alignedAddress = 
+        (blockAddress + sizeof(detail::AlignedOffset_T) + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    std::byte* const returnVal = block + (alignedAddress - blockAddress);
+
+    detail::AlignedOffset_T const offset = static_cast<detail::AlignedOffset_T>(returnVal - block);
+    std::memcpy(returnVal - sizeof(offset), &offset, sizeof(offset));
+    return returnVal;
+}
+
+void Texas::Allocator::deallocateAligned(std::byte* ptr, std::size_t alignment, MemoryType memType)
+{
+    (void)alignment;
+    if (ptr == nullptr)
+        return;
+
+    detail::AlignedOffset_T offset = 0;
+    std::memcpy(&offset, ptr - sizeof(offset), sizeof(offset));
+    deallocate(ptr - offset, memType);
+}
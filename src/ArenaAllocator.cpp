@@ -0,0 +1,144 @@
+#include "Texas/ArenaAllocator.hpp"
+
+#include <cstddef>
+#include <new>
+
+namespace Texas::detail
+{
+    // Every allocation from the arena is aligned like memory from operator new.
+    constexpr std::size_t arenaAlignment = alignof(std::max_align_t);
+
+    [[nodiscard]] static constexpr std::size_t alignArenaSize(std::size_t size) noexcept
+    {
+        return (size + arenaAlignment - 1) / arenaAlignment * arenaAlignment;
+    }
+}
+
+Texas::ArenaAllocator::ArenaAllocator(ByteSpan buffer, Allocator* upstream) noexcept :
+    m_buffer(buffer.data()),
+    m_capacity(buffer.size()),
+    m_ownsBuffer(false),
+    m_upstream(upstream)
+{
+    m_statistics.capacity = m_capacity;
+}
+
+Texas::ArenaAllocator::ArenaAllocator(std::size_t initialCapacity, Allocator* upstream) noexcept :
+    m_ownsBuffer(true),
+    m_upstream(upstream)
+{
+    initialCapacity = detail::alignArenaSize(initialCapacity);
+    if (initialCapacity > 0)
+    {
+        m_buffer = allocateUpstream(initialCapacity, MemoryType::WorkingData);
+        if (m_buffer != nullptr)
+            m_capacity = initialCapacity;
+    }
+    m_statistics.capacity = m_capacity;
+}
+
+Texas::ArenaAllocator::~ArenaAllocator()
+{
+    if (m_ownsBuffer && m_buffer != nullptr)
+        deallocateUpstream(m_buffer, MemoryType::WorkingData);
+}
+
+std::byte* Texas::ArenaAllocator::allocate(std::size_t amount, MemoryType memType)
+{
+    if (memType == MemoryType::WorkingData)
+    {
+        std::size_t const alignedAmount = detail::alignArenaSize(amount);
+        if (alignedAmount <= m_capacity - m_offset)
+        {
+            std::byte* const returnVal = m_buffer + m_offset;
+            m_offset += alignedAmount;
+            m_liveCount++;
+            m_statistics.arenaAllocationCount++;
+            if (m_offset > m_statistics.peakBytesUsed)
+                m_statistics.peakBytesUsed = m_offset;
+            return returnVal;
+        }
+        m_overflowBytes += alignedAmount;
+    }
+
+    m_statistics.forwardedAllocationCount++;
+    return allocateUpstream(amount, memType);
+}
+
+void Texas::ArenaAllocator::deallocate(std::byte* ptr, MemoryType memType)
+{
+    if (ptr == nullptr)
+        return;
+
+    bool const isInArena = m_buffer != nullptr && ptr >= m_buffer && ptr < m_buffer + m_capacity;
+    if (!isInArena)
+    {
+        deallocateUpstream(ptr, memType);
+        // Nothing lives in the arena, so this is a chance to grow it for the next load.
+        if (memType == MemoryType::WorkingData && m_liveCount == 0 && m_overflowBytes > 0)
+            reset();
+        return;
+    }
+
+    m_liveCount--;
+    if (m_liveCount == 0)
+        reset();
+}
+
+Texas::ArenaAllocator::Statistics Texas::ArenaAllocator::statistics() const noexcept
+{
+    return m_statistics;
+}
+
+std::size_t Texas::ArenaAllocator::bytesUsed() const noexcept
+{
+    return m_offset;
+}
+
+void Texas::ArenaAllocator::reset() noexcept
+{
+    m_offset = 0;
+    m_statistics.resetCount++;
+
+    if (m_ownsBuffer && m_overflowBytes > 0)
+    {
+        // Grow so that everything we had to forward since the last reset would have fit.
+        std::size_t newCapacity = m_capacity * 2;
+        if (newCapacity < m_capacity + m_overflowBytes)
+            newCapacity = m_capacity + m_overflowBytes;
+        std::byte* const newBuffer = allocateUpstream(newCapacity, MemoryType::WorkingData);
+        if (newBuffer != nullptr)
+        {
+            if (m_buffer != nullptr)
+                deallocateUpstream(m_buffer, MemoryType::WorkingData);
+            m_buffer = newBuffer;
+            m_capacity = newCapacity;
+            m_statistics.capacity = m_capacity;
+            m_statistics.growCount++;
+        }
+    }
+    m_overflowBytes = 0;
+}
+
+std::byte* Texas::ArenaAllocator::allocateUpstream(std::size_t amount, MemoryType memType) noexcept
+{
+    if (m_upstream != nullptr)
+        return m_upstream->allocate(amount, memType);
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+    return new(std::nothrow) std::byte[amount];
+#else
+    return nullptr;
+#endif
+}
+
+void Texas::ArenaAllocator::deallocateUpstream(std::byte* ptr, MemoryType memType) noexcept
+{
+    if (m_upstream != nullptr)
+    {
+        m_upstream->deallocate(ptr, memType);
+        return;
+    }
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+    delete[] ptr;
+#endif
+}
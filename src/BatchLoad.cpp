@@ -0,0 +1,674 @@
+#include "Texas/BatchLoad.hpp"
+#include "Texas/Texas.hpp"
+
+#include "PrivateAccessor.hpp"
+
+#if defined(TEXAS_ENABLE_IO_URING)
+#   include "IoUring.hpp"
+#   include "KTX.hpp"
+#   include "PNG.hpp"
+
+#   include <fcntl.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+
+#   include <cerrno>
+#   include <cstring>
+#endif
+
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace Texas::detail
+{
+    /*
+        The range of batch items a worker has not started on yet.
+        The owner takes items from the front, other workers steal from the back.
+    */
+    struct BatchWorkQueue
+    {
+        std::mutex mutex;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+
+    class BatchScheduler
+    {
+    public:
+        BatchWorkQueue* queues = nullptr;
+        std::uint32_t queueCount = 0;
+
+        /*
+            Hands out the next item for the worker.
+            Returns false when there are no items left in any queue.
+        */
+        [[nodiscard]] bool acquire(std::uint32_t workerIndex, std::size_t& itemIndex) noexcept
+        {
+            BatchWorkQueue& ownQueue = queues[workerIndex];
+            {
+                std::lock_guard<std::mutex> lock(ownQueue.mutex);
+                if (ownQueue.begin < ownQueue.end)
+                {
+                    itemIndex = ownQueue.begin;
+                    ownQueue.begin++;
+                    return true;
+                }
+            }
+
+            // Our own queue is empty, steal half the remaining items of the first worker that has any.
+            for (std::uint32_t i = 1; i < queueCount; i++)
+            {
+                BatchWorkQueue& victim = queues[(workerIndex + i) % queueCount];
+                std::size_t stolenBegin = 0;
+                std::size_t stolenEnd = 0;
+                {
+                    std::lock_guard<std::mutex> lock(victim.mutex);
+                    std::size_t const remaining = victim.end - victim.begin;
+                    if (remaining == 0)
+                        continue;
+                    stolenEnd = victim.end;
+                    stolenBegin = victim.end - (remaining + 1) / 2;
+                    victim.end = stolenBegin;
+                }
+
+                itemIndex = stolenBegin;
+                std::lock_guard<std::mutex> lock(ownQueue.mutex);
+                ownQueue.begin = stolenBegin + 1;
+                ownQueue.end = stolenEnd;
+                return true;
+            }
+
+            return false;
+        }
+    };
+
+    /*
+        Takes working-memory aligned to alignment from allocator, or from the heap if allocator is nullptr.
+        Objects are constructed in some of it, so the alignment has to be enough for them.
+        Returns nullptr on failure.
+    */
+    [[nodiscard]] static std::byte* allocateBatchMemory(Allocator* allocator, std::size_t size, std::size_t alignment) noexcept
+    {
+        if (allocator != nullptr)
+            return allocator->allocateAligned(size, alignment, Allocator::MemoryType::WorkingData);
+        return static_cast<std::byte*>(::operator new[](size, std::align_val_t(alignment), std::nothrow));
+    }
+
+    static void deallocateBatchMemory(Allocator* allocator, std::byte* ptr, std::size_t alignment) noexcept
+    {
+        if (allocator != nullptr)
+            allocator->deallocateAligned(ptr, alignment, Allocator::MemoryType::WorkingData);
+        else
+            ::operator delete[](ptr, std::align_val_t(alignment));
+    }
+
+    // Loads the file at path the regular way, using the heap if allocator is nullptr.
+    [[nodiscard]] static ResultValue<Texture> loadFromPath(char const* path, Allocator* allocator) noexcept
+    {
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+        if (allocator == nullptr)
+            return Texas::loadFromPath(path);
+#endif
+        return Texas::loadFromPath(path, *allocator);
+    }
+
+    template<typename LoadItemFn>
+    static void runBatchWorker(BatchScheduler& scheduler, std::uint32_t workerIndex, LoadItemFn const& loadItem) noexcept
+    {
+        std::size_t itemIndex = 0;
+        while (scheduler.acquire(workerIndex, itemIndex))
+            loadItem(itemIndex);
+    }
+
+    /*
+        Calls loadItem for every index in [0, itemCount) across threadCount threads,
+        where one of them is the calling thread.
+        The memory for the scheduler is taken from allocator if it's not nullptr.
+    */
+    template<typename LoadItemFn>
+    [[nodiscard]] static Result runBatch(
+        std::size_t itemCount,
+        std::uint32_t threadCount,
+        Allocator* allocator,
+        LoadItemFn const& loadItem) noexcept
+    {
+        if (threadCount == 0)
+            threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0)
+            threadCount = 1;
+        if (threadCount > itemCount)
+            threadCount = static_cast<std::uint32_t>(itemCount);
+
+        if (threadCount <= 1)
+        {
+            for (std::size_t i = 0; i < itemCount; i++)
+                loadItem(i);
+            return { ResultType::Success, nullptr };
+        }
+
+        // The queues and the threads we spawn share one allocation.
+        std::size_t const queuesSize = sizeof(BatchWorkQueue) * threadCount;
+        std::size_t const threadsOffset = (queuesSize + alignof(std::thread) - 1) / alignof(std::thread) * alignof(std::thread);
+        std::size_t const memSize = threadsOffset + sizeof(std::thread) * (threadCount - 1);
+        std::size_t const memAlignment = alignof(BatchWorkQueue) > alignof(std::thread) ? alignof(BatchWorkQueue) : alignof(std::thread);
+        std::byte* const mem = allocateBatchMemory(allocator, memSize, memAlignment);
+        if (mem == nullptr)
+        {
+            if (allocator != nullptr)
+                return { ResultType::InvalidLibraryUsage, "Allocator returned nullptr when attempting to allocate working-memory." };
+            return { ResultType::UnknownError, "Failed to allocate working-memory for the batch scheduler." };
+        }
+
+        BatchScheduler scheduler{};
+        scheduler.queues = reinterpret_cast<BatchWorkQueue*>(mem);
+        scheduler.queueCount = threadCount;
+        for (std::uint32_t i = 0; i < threadCount; i++)
+        {
+            BatchWorkQueue* const queue = new(scheduler.queues + i) BatchWorkQueue;
+            queue->begin = itemCount * i / threadCount;
+            queue->end = itemCount * (i + 1) / threadCount;
+        }
+
+        // The calling thread is worker 0, so we spawn one less thread.
+        std::thread* const threads = reinterpret_cast<std::thread*>(mem + threadsOffset);
+        std::uint32_t spawnedCount = 0;
+        for (; spawnedCount < threadCount - 1; spawnedCount++)
+        {
+            std::thread* const thread = new(threads + spawnedCount) std::thread;
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+            try
+            {
+                *thread = std::thread(&runBatchWorker<LoadItemFn>, std::ref(scheduler), spawnedCount + 1, std::cref(loadItem));
+            }
+            catch (...)
+            {
+                // The workers we did spawn steal the items of the ones we could not.
+                thread->~thread();
+                break;
+            }
+#else
+            *thread = std::thread(&runBatchWorker<LoadItemFn>, std::ref(scheduler), spawnedCount + 1, std::cref(loadItem));
+#endif
+        }
+
+        runBatchWorker(scheduler, 0, loadItem);
+
+        for (std::uint32_t i = 0; i < spawnedCount; i++)
+        {
+            threads[i].join();
+            threads[i].~thread();
+        }
+        for (std::uint32_t i = 0; i < threadCount; i++)
+            scheduler.queues[i].~BatchWorkQueue();
+
+        deallocateBatchMemory(allocator, mem, memAlignment);
+
+        return { ResultType::Success, nullptr };
+    }
+
+#if defined(TEXAS_ENABLE_IO_URING)
+    // Files are read in windows, and the next window is read while the previous one is decoded.
+    constexpr std::uint32_t ioUringWindowMaxFileCount = 32;
+    /*
+        A window holds fewer files if they would take up more memory than this.
+        Files larger than this are not read into a window at all, the regular loader
+        streams them from their path instead.
+    */
+    constexpr std::size_t ioUringWindowMaxSize = std::size_t(64) << 20;
+    /*
+        Size of the first read of every file. It's checked before the rest of the file is read,
+        and it covers the entire file for most small textures.
+    */
+    constexpr std::uint32_t ioUringHeaderReadSize = 1 << 16;
+    // Largest single read handed to the kernel.
+    constexpr std::uint32_t ioUringMaxReadSize = 1 << 30;
+    // File contents are only read as bytes, so they get the alignment operator new would give them.
+    constexpr std::size_t ioUringFileDataAlignment = alignof(std::max_align_t);
+
+    struct IoUringBatchFile
+    {
+        int fd = -1;
+        std::byte* data = nullptr;
+        std::size_t size = 0;
+        std::size_t amountRead = 0;
+        // Reading stops here until the header has been checked.
+        std::size_t readEnd = 0;
+        // The kernel has a read of this file, or it's queued up.
+        bool readInFlight = false;
+        // Loaded from its path by the regular loader when its window is decoded.
+        bool loadFromPath = false;
+        Result result = { ResultType::Success, nullptr };
+    };
+
+    struct IoUringBatchWindow
+    {
+        IoUringBatchFile* files = nullptr;
+        // Index of the path of files[0].
+        std::size_t pathsBegin = 0;
+        std::uint32_t fileCount = 0;
+        // Files that are still being read.
+        std::uint32_t pendingCount = 0;
+    };
+
+    /*
+        Reads files through io_uring, so the reads of many files are in flight at once,
+        and hands them to the decoders on a pool of threads.
+    */
+    class IoUringBatch
+    {
+    public:
+        IoUring ring{};
+        Allocator* allocator = nullptr;
+        // Holds the files of both windows. The index of a file in here is the userData of its reads.
+        IoUringBatchFile* files = nullptr;
+        IoUringBatchWindow windows[2] = {};
+        // Set once the ring has reported an error. The remaining files are read without it.
+        bool ringFailed = false;
+
+        // Opens the files of paths starting at pathsBegin, and starts reading their headers.
+        void startWindow(IoUringBatchWindow& window, Span<char const* const> paths, std::size_t pathsBegin) noexcept
+        {
+            window.pathsBegin = pathsBegin;
+            window.fileCount = 0;
+            window.pendingCount = 0;
+
+            std::size_t windowSize = 0;
+            while (pathsBegin + window.fileCount < paths.size() && window.fileCount < ioUringWindowMaxFileCount)
+            {
+                IoUringBatchFile& file = window.files[window.fileCount];
+                file = IoUringBatchFile{};
+                file.fd = ::open(paths.data()[pathsBegin + window.fileCount], O_RDONLY | O_CLOEXEC);
+                struct stat fileStat{};
+                if (file.fd == -1)
+                    file.result = { ResultType::CouldNotOpenFile, "Failed to open this file for reading." };
+                else if (::fstat(file.fd, &fileStat) != 0)
+                    file.result = { ResultType::CouldNotOpenFile, "Failed to query the size of this file." };
+                else if (static_cast<std::uint64_t>(fileStat.st_size) > static_cast<std::size_t>(-1))
+                    file.result = { ResultType::FileNotSupported, "File is larger than the system can hold in memory." };
+                else if (static_cast<std::uint64_t>(fileStat.st_size) > ioUringWindowMaxSize)
+                    file.loadFromPath = true;
+                else
+                    file.size = static_cast<std::size_t>(fileStat.st_size);
+
+                if (window.fileCount > 0 && windowSize + file.size > ioUringWindowMaxSize)
+                {
+                    // Leave it for the next window.
+                    closeFile(file);
+                    break;
+                }
+                windowSize += file.size;
+                window.fileCount++;
+
+                if (!file.result.isSuccessful() || file.size == 0)
+                {
+                    closeFile(file);
+                    continue;
+                }
+                file.data = allocateBatchMemory(allocator, file.size, ioUringFileDataAlignment);
+                if (file.data == nullptr)
+                {
+                    file.result = { ResultType::InvalidLibraryUsage, "Allocator returned nullptr when attempting to allocate working-memory." };
+                    closeFile(file);
+                    continue;
+                }
+                if (ringFailed)
+                {
+                    readRemainingSynchronously(file);
+                    closeFile(file);
+                    continue;
+                }
+                file.readEnd = file.size < ioUringHeaderReadSize ? file.size : ioUringHeaderReadSize;
+                window.pendingCount++;
+                queueNextRead(file);
+            }
+
+            if (!ringFailed && !ring.submitAndWait(0))
+                abandonRing(window);
+        }
+
+        // Waits until every file in window has been read.
+        void finishWindow(IoUringBatchWindow& window) noexcept
+        {
+            while (window.pendingCount > 0)
+            {
+                if (!ring.submitAndWait(1))
+                {
+                    abandonRing(window);
+                    return;
+                }
+                handleCompletions();
+            }
+        }
+
+        // Handles the reads that have completed so far, without waiting for any.
+        void pollCompletions() noexcept
+        {
+            // Errors are left for finishWindow() to handle.
+            if (ringFailed || !ring.submitAndWait(0))
+                return;
+            handleCompletions();
+        }
+
+        void handleCompletions() noexcept
+        {
+            std::uint64_t userData = 0;
+            std::int32_t readResult = 0;
+            while (ring.popCompletion(userData, readResult))
+            {
+                IoUringBatchWindow& window = windows[userData / ioUringWindowMaxFileCount];
+                IoUringBatchFile& file = files[userData];
+                file.readInFlight = false;
+                if (handleCompletion(file, readResult))
+                {
+                    closeFile(file);
+                    window.pendingCount--;
+                }
+            }
+        }
+
+        // Returns true once the file has been read in full, or reading it failed.
+        [[nodiscard]] bool handleCompletion(IoUringBatchFile& file, std::int32_t readResult) noexcept
+        {
+            if (readResult == -EAGAIN || readResult == -EINTR)
+            {
+                queueNextRead(file);
+                return false;
+            }
+            else if (readResult < 0)
+            {
+                // Kernels before 5.6 can set up a ring, but don't support IORING_OP_READ.
+                readRemainingSynchronously(file);
+                return true;
+            }
+            else if (readResult == 0)
+            {
+                file.result = { ResultType::PrematureEndOfFile, "File got shorter while it was being read." };
+                return true;
+            }
+
+            file.amountRead += static_cast<std::size_t>(readResult);
+            if (file.amountRead == file.readEnd && file.readEnd < file.size)
+            {
+                // The header is in. Only read the rest if it's a file-format we know.
+                if (!hasKnownIdentifier(file))
+                {
+                    file.result = { ResultType::FileNotSupported,
+                                    "Could not identify file-format of input "
+                                    "or file-format is not supported." };
+                    return true;
+                }
+                file.readEnd = file.size;
+            }
+            if (file.amountRead < file.readEnd)
+            {
+                queueNextRead(file);
+                return false;
+            }
+            return true;
+        }
+
+        void queueNextRead(IoUringBatchFile& file) noexcept
+        {
+            std::size_t readSize = file.readEnd - file.amountRead;
+            if (readSize > ioUringMaxReadSize)
+                readSize = ioUringMaxReadSize;
+            bool const queued = ring.queueRead(
+                file.fd,
+                file.amountRead,
+                file.data + file.amountRead,
+                static_cast<std::uint32_t>(readSize),
+                static_cast<std::uint64_t>(&file - files));
+            // Every file has atmost one read in flight, so this should never happen.
+            if (!queued)
+                readRemainingSynchronously(file);
+            file.readInFlight = queued;
+        }
+
+        void readRemainingSynchronously(IoUringBatchFile& file) noexcept
+        {
+            while (file.amountRead < file.size)
+            {
+                ssize_t const bytesRead = ::pread(
+                    file.fd,
+                    file.data + file.amountRead,
+                    file.size - file.amountRead,
+                    static_cast<off_t>(file.amountRead));
+                if (bytesRead == -1 && errno == EINTR)
+                    continue;
+                if (bytesRead == -1)
+                {
+                    file.result = { ResultType::UnknownError, "The OS reported an error when reading from file." };
+                    return;
+                }
+                if (bytesRead == 0)
+                {
+                    file.result = { ResultType::PrematureEndOfFile, "File got shorter while it was being read." };
+                    return;
+                }
+                file.amountRead += static_cast<std::size_t>(bytesRead);
+            }
+            file.readEnd = file.size;
+        }
+
+        /*
+            Stops using the ring after it reported an error, and reads the rest of window without it.
+            Queued reads are taken back, but the kernel may still write into the files of the reads
+            it already has, so those have to complete before the files can be read again or freed.
+        */
+        void abandonRing(IoUringBatchWindow& window) noexcept
+        {
+            ringFailed = true;
+
+            std::uint64_t userData = 0;
+            while (ring.unqueueRead(userData))
+                files[userData].readInFlight = false;
+
+            bool waitFailed = false;
+            while (!waitFailed && hasReadsInFlight(window))
+            {
+                waitFailed = !ring.submitAndWait(1);
+                std::int32_t readResult = 0;
+                while (ring.popCompletion(userData, readResult))
+                    files[userData].readInFlight = false;
+            }
+
+            for (std::uint32_t i = 0; i < window.fileCount; i++)
+            {
+                IoUringBatchFile& file = window.files[i];
+                if (file.fd == -1)
+                    continue;
+                if (file.readInFlight)
+                {
+                    // Leaked on purpose, freeing it while the kernel can still write to it is worse.
+                    file.data = nullptr;
+                    file.result = { ResultType::UnknownError, "io_uring stopped working while the file was being read." };
+                }
+                else
+                    readRemainingSynchronously(file);
+                closeFile(file);
+            }
+            window.pendingCount = 0;
+        }
+
+        [[nodiscard]] static bool hasReadsInFlight(IoUringBatchWindow const& window) noexcept
+        {
+            for (std::uint32_t i = 0; i < window.fileCount; i++)
+            {
+                if (window.files[i].readInFlight)
+                    return true;
+            }
+            return false;
+        }
+
+        [[nodiscard]] static bool hasKnownIdentifier(IoUringBatchFile const& file) noexcept
+        {
+            bool const isKTX = file.amountRead >= sizeof(KTX::identifier) &&
+                std::memcmp(file.data, KTX::identifier, sizeof(KTX::identifier)) == 0;
+            bool const isPNG = file.amountRead >= sizeof(PNG::identifier) &&
+                std::memcmp(file.data, PNG::identifier, sizeof(PNG::identifier)) == 0;
+            return isKTX || isPNG;
+        }
+
+        static void closeFile(IoUringBatchFile& file) noexcept
+        {
+            if (file.fd != -1)
+                ::close(file.fd);
+            file.fd = -1;
+        }
+    };
+
+    /*
+        Loads the files at every path through io_uring.
+        Returns false without touching results if io_uring can't be used,
+        then the files have to be loaded the regular way.
+    */
+    [[nodiscard]] static bool loadFromPathsIoUring(
+        Span<char const* const> paths,
+        Span<ResultValue<Texture>> results,
+        Allocator* allocator,
+        std::uint32_t threadCount) noexcept
+    {
+        // The batch and the files of both windows share one allocation.
+        std::size_t const filesOffset = 
+            (sizeof(IoUringBatch) + alignof(IoUringBatchFile) - 1) / alignof(IoUringBatchFile) * alignof(IoUringBatchFile);
+        std::size_t const batchMemSize = filesOffset + sizeof(IoUringBatchFile) * 2 * ioUringWindowMaxFileCount;
+        std::size_t const batchMemAlignment = 
+            alignof(IoUringBatch) > alignof(IoUringBatchFile) ? alignof(IoUringBatch) : alignof(IoUringBatchFile);
+        std::byte* const batchMem = allocateBatchMemory(allocator, batchMemSize, batchMemAlignment);
+        if (batchMem == nullptr)
+            return false;
+        IoUringBatch* const batch = new(batchMem) IoUringBatch;
+        // One read in flight for every file in both windows.
+        if (!batch->ring.init(2 * ioUringWindowMaxFileCount))
+        {
+            batch->~IoUringBatch();
+            deallocateBatchMemory(allocator, batchMem, batchMemAlignment);
+            return false;
+        }
+        batch->allocator = allocator;
+        batch->files = reinterpret_cast<IoUringBatchFile*>(batchMem + filesOffset);
+        for (std::uint32_t i = 0; i < 2 * ioUringWindowMaxFileCount; i++)
+            new(batch->files + i) IoUringBatchFile;
+        batch->windows[0].files = batch->files;
+        batch->windows[1].files = batch->files + ioUringWindowMaxFileCount;
+
+        std::thread::id const ioThreadId = std::this_thread::get_id();
+        IoUringBatchWindow* readingWindow = &batch->windows[0];
+        batch->startWindow(*readingWindow, paths, 0);
+        while (readingWindow->fileCount > 0)
+        {
+            batch->finishWindow(*readingWindow);
+            IoUringBatchWindow* const decodingWindow = readingWindow;
+            readingWindow = readingWindow == &batch->windows[0] ? &batch->windows[1] : &batch->windows[0];
+            batch->startWindow(*readingWindow, paths, decodingWindow->pathsBegin + decodingWindow->fileCount);
+
+            auto const decodeFile = [=](std::size_t i) noexcept
+            {
+                IoUringBatchFile& file = decodingWindow->files[i];
+                ResultValue<Texture>& fileResult = results.data()[decodingWindow->pathsBegin + i];
+                if (file.loadFromPath)
+                    fileResult = loadFromPath(paths.data()[decodingWindow->pathsBegin + i], allocator);
+                else if (file.result.isSuccessful())
+                {
+                    MemoryInputStream stream({ file.data, file.size });
+                    fileResult = PrivateAccessor::loadFromStream(stream, allocator);
+                }
+                else
+                    fileResult = file.result;
+                if (file.data != nullptr)
+                    deallocateBatchMemory(allocator, file.data, ioUringFileDataAlignment);
+                file.data = nullptr;
+
+                // The ring is only touched by the thread that set it up. It keeps the
+                // reads of the next window going in between decoding files.
+                if (std::this_thread::get_id() == ioThreadId)
+                    batch->pollCompletions();
+            };
+            // If the threads could not be set up, we decode on this thread instead.
+            if (!runBatch(decodingWindow->fileCount, threadCount, allocator, decodeFile).isSuccessful())
+            {
+                for (std::uint32_t i = 0; i < decodingWindow->fileCount; i++)
+                    decodeFile(i);
+            }
+        }
+
+        for (std::uint32_t i = 0; i < 2 * ioUringWindowMaxFileCount; i++)
+            batch->files[i].~IoUringBatchFile();
+        batch->~IoUringBatch();
+        deallocateBatchMemory(allocator, batchMem, batchMemAlignment);
+        return true;
+    }
+#endif
+
+    [[nodiscard]] static Result loadFromPaths(
+        Span<char const* const> paths,
+        Span<ResultValue<Texture>> results,
+        Allocator* allocator,
+        std::uint32_t threadCount) noexcept
+    {
+        if (paths.size() != results.size())
+            return { ResultType::InvalidLibraryUsage, "The amount of results must equal the amount of paths." };
+
+#if defined(TEXAS_ENABLE_IO_URING)
+        if (loadFromPathsIoUring(paths, results, allocator, threadCount))
+            return { ResultType::Success, nullptr };
+#endif
+
+        return runBatch(paths.size(), threadCount, allocator, [=](std::size_t i) noexcept
+        {
+            results.data()[i] = loadFromPath(paths.data()[i], allocator);
+        });
+    }
+
+    [[nodiscard]] static Result loadFromStreams(
+        Span<InputStream* const> streams,
+        Span<ResultValue<Texture>> results,
+        Allocator* allocator,
+        std::uint32_t threadCount) noexcept
+    {
+        if (streams.size() != results.size())
+            return { ResultType::InvalidLibraryUsage, "The amount of results must equal the amount of streams." };
+
+        return runBatch(streams.size(), threadCount, allocator, [=](std::size_t i) noexcept
+        {
+            results.data()[i] = PrivateAccessor::loadFromStream(*streams.data()[i], allocator);
+        });
+    }
+}
+
+Texas::Result Texas::loadFromPaths(
+    Span<char const* const> paths,
+    Span<ResultValue<Texture>> results,
+    Allocator& allocator,
+    std::uint32_t threadCount) noexcept
+{
+    return detail::loadFromPaths(paths, results, &allocator, threadCount);
+}
+
+Texas::Result Texas::loadFromStreams(
+    Span<InputStream* const> streams,
+    Span<ResultValue<Texture>> results,
+    Allocator& allocator,
+    std::uint32_t threadCount) noexcept
+{
+    return detail::loadFromStreams(streams, results, &allocator, threadCount);
+}
+
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+Texas::Result Texas::loadFromPaths(
+    Span<char const* const> paths,
+    Span<ResultValue<Texture>> results,
+    std::uint32_t threadCount) noexcept
+{
+    return detail::loadFromPaths(paths, results, nullptr, threadCount);
+}
+
+Texas::Result Texas::loadFromStreams(
+    Span<InputStream* const> streams,
+    Span<ResultValue<Texture>> results,
+    std::uint32_t threadCount) noexcept
+{
+    return detail::loadFromStreams(streams, results, nullptr, threadCount);
+}
+#endif
@@ -0,0 +1,189 @@
+#include "Texas/BufferedInputStream.hpp"
+
+// For std::memcpy
+#include <cstring>
+
+Texas::BufferedInputStream::BufferedInputStream(
+    InputStream& source,
+    ByteSpan buffer,
+    std::size_t blockSize) noexcept :
+    m_source(&source),
+    m_buffer(buffer),
+    m_blockSize(blockSize)
+{
+    if (m_blockSize > m_buffer.size())
+        m_blockSize = m_buffer.size();
+    if (m_blockSize == 0)
+        m_blockSize = 1;
+
+    m_sourceSize = m_source->size();
+    m_sourcePos = m_source->tell();
+    m_pos = m_sourcePos;
+    m_bufferStreamPos = m_sourcePos;
+}
+
+Texas::Result Texas::BufferedInputStream::read(ByteSpan dst) noexcept
+{
+    if (m_sourceSize != unknownSize && (m_pos > m_sourceSize || dst.size() > m_sourceSize - m_pos))
+        return { ResultType::PrematureEndOfFile, "Reached premature end of stream." };
+    if (dst.size() == 0)
+        return { ResultType::Success, nullptr };
+
+    // Serve as much as we can from the buffer.
+    std::size_t amountCopied = 0;
+    if (m_pos >= m_bufferStreamPos && m_pos < m_bufferStreamPos + m_bufferFilled)
+    {
+        amountCopied = m_bufferStreamPos + m_bufferFilled - m_pos;
+        if (amountCopied > dst.size())
+            amountCopied = dst.size();
+        std::memcpy(dst.data(), m_buffer.data() + (m_pos - m_bufferStreamPos), amountCopied);
+        m_pos += amountCopied;
+    }
+    std::size_t const amountRemaining = dst.size() - amountCopied;
+    if (amountRemaining == 0)
+        return { ResultType::Success, nullptr };
+
+    // Start the refill at the start of the block we are in.
+    // If the wrapped stream is already further into the block, we start there
+    // instead so that it doesn't have to go backwards.
+    std::size_t fillStart = m_pos - m_pos % m_blockSize;
+    if (m_sourcePos != unknownSize && m_sourcePos > fillStart && m_sourcePos <= m_pos)
+        fillStart = m_sourcePos;
+    std::size_t const bufferCapacity = m_buffer.size() - m_buffer.size() % m_blockSize;
+    // Bytes of the refill that have to be read to serve this read.
+    std::size_t const amountNeeded = m_pos - fillStart + amountRemaining;
+
+    std::size_t fillAmount = bufferCapacity < m_fillLimit ? bufferCapacity : m_fillLimit;
+    if (m_sourceSize != unknownSize && fillAmount > m_sourceSize - fillStart)
+        fillAmount = m_sourceSize - fillStart;
+    while (fillAmount >= amountNeeded)
+    {
+        moveSourceTo(fillStart);
+        Result const result = m_source->read({ m_buffer.data(), fillAmount });
+        if (result.isSuccessful())
+        {
+            m_bufferStreamPos = fillStart;
+            m_bufferFilled = fillAmount;
+            m_sourcePos = fillStart + fillAmount;
+
+            std::memcpy(dst.data() + amountCopied, m_buffer.data() + (m_pos - m_bufferStreamPos), amountRemaining);
+            m_pos += amountRemaining;
+            return { ResultType::Success, nullptr };
+        }
+
+        m_bufferFilled = 0;
+        if (m_sourceSize != unknownSize)
+        {
+            m_sourcePos = unknownSize;
+            return result;
+        }
+        // We don't know the size of the wrapped stream, so we take this to mean we are near its end,
+        // and read ahead half as much from now on.
+        m_sourcePos = m_source->tell();
+        fillAmount /= 2;
+        m_fillLimit = fillAmount;
+    }
+
+    // The rest doesn't fit in the buffer, or we are too close to the end of the stream
+    // to read ahead, so it goes straight into dst.
+    moveSourceTo(m_pos);
+    Result const result = m_source->read({ dst.data() + amountCopied, amountRemaining });
+    if (!result.isSuccessful())
+    {
+        m_sourcePos = unknownSize;
+        return result;
+    }
+    m_pos += amountRemaining;
+    m_sourcePos = m_pos;
+    return { ResultType::Success, nullptr };
+}
+
+Texas::Result Texas::BufferedInputStream::readVectored(Span<ByteSpan const> dsts) noexcept
+{
+    std::size_t totalSize = 0;
+    for (std::size_t i = 0; i < dsts.size(); i++)
+        totalSize += dsts.data()[i].size();
+    if (m_sourceSize != unknownSize && (m_pos > m_sourceSize || totalSize > m_sourceSize - m_pos))
+        return { ResultType::PrematureEndOfFile, "Reached premature end of stream." };
+
+    // Reads that fit in the buffer are cheaper to serve from it.
+    std::size_t const bufferCapacity = m_buffer.size() - m_buffer.size() % m_blockSize;
+    if (totalSize <= bufferCapacity)
+        return InputStream::readVectored(dsts);
+
+    // Spans that start inside the buffer go through read(), until we are past what's buffered.
+    std::size_t dstIndex = 0;
+    while (dstIndex < dsts.size() && m_pos >= m_bufferStreamPos && m_pos < m_bufferStreamPos + m_bufferFilled)
+    {
+        Result const result = read(dsts.data()[dstIndex]);
+        if (!result.isSuccessful())
+            return result;
+        dstIndex += 1;
+    }
+    if (dstIndex == dsts.size())
+        return { ResultType::Success, nullptr };
+
+    // The rest goes straight from the wrapped stream into the spans.
+    moveSourceTo(m_pos);
+    Span<ByteSpan const> const remainingDsts = { dsts.data() + dstIndex, dsts.size() - dstIndex };
+    Result const result = m_source->readVectored(remainingDsts);
+    if (!result.isSuccessful())
+    {
+        m_sourcePos = unknownSize;
+        return result;
+    }
+    for (std::size_t i = 0; i < remainingDsts.size(); i++)
+        m_pos += remainingDsts.data()[i].size();
+    m_sourcePos = m_pos;
+    return { ResultType::Success, nullptr };
+}
+
+void Texas::BufferedInputStream::ignore(std::size_t amount) noexcept
+{
+    // The wrapped stream is only moved once we have to read from it.
+    m_pos += amount;
+}
+
+Texas::ConstByteSpan Texas::BufferedInputStream::acquire(std::size_t amount) noexcept
+{
+    if (m_pos < m_bufferStreamPos || m_pos > m_bufferStreamPos + m_bufferFilled)
+        return {};
+    if (amount > m_bufferStreamPos + m_bufferFilled - m_pos)
+        return {};
+    ConstByteSpan const returnVal = { m_buffer.data() + (m_pos - m_bufferStreamPos), amount };
+    m_pos += amount;
+    return returnVal;
+}
+
+std::size_t Texas::BufferedInputStream::tell() noexcept
+{
+    return m_pos;
+}
+
+void Texas::BufferedInputStream::seek(std::size_t pos) noexcept
+{
+    m_pos = pos;
+}
+
+std::size_t Texas::BufferedInputStream::size() noexcept
+{
+    return m_sourceSize;
+}
+
+void Texas::BufferedInputStream::hint(std::size_t pos, std::size_t length, AccessHint access) noexcept
+{
+    // Our positions are the same as the ones of the wrapped stream.
+    m_source->hint(pos, length, access);
+}
+
+void Texas::BufferedInputStream::moveSourceTo(std::size_t pos) noexcept
+{
+    if (m_sourcePos == pos)
+        return;
+    // Going forward is done with ignore, so that wrapped streams that can't seek still work.
+    if (m_sourcePos != unknownSize && m_sourcePos < pos)
+        m_source->ignore(pos - m_sourcePos);
+    else
+        m_source->seek(pos);
+    m_sourcePos = pos;
+}
@@ -0,0 +1,75 @@
+#include "CpuFeatures.hpp"
+
+#include <cstdint>
+
+#if defined(TEXAS_ARCH_X86)
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#endif
+
+namespace Texas::detail
+{
+#if defined(TEXAS_ARCH_X86)
+    static void cpuid(std::uint32_t leaf, std::uint32_t subLeaf, std::uint32_t (&regs)[4]) noexcept
+    {
+#   if defined(_MSC_VER)
+        int temp[4] = {};
+        __cpuidex(temp, static_cast<int>(leaf), static_cast<int>(subLeaf));
+        for (int i = 0; i < 4; i++)
+            regs[i] = static_cast<std::uint32_t>(temp[i]);
+#   else
+        __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#   endif
+    }
+
+    // Returns the XCR0 register, which tells us what register state the OS saves on context-switches.
+    static std::uint64_t readXcr0() noexcept
+    {
+#   if defined(_MSC_VER)
+        return _xgetbv(0);
+#   else
+        std::uint32_t eax = 0;
+        std::uint32_t edx = 0;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return eax | (static_cast<std::uint64_t>(edx) << 32);
+#   endif
+    }
+#endif
+
+    [[nodiscard]] static CpuFeatures detectCpuFeatures() noexcept
+    {
+        CpuFeatures features{};
+
+#if defined(TEXAS_ARCH_X86)
+        std::uint32_t regs[4] = {};
+        cpuid(0, 0, regs);
+        std::uint32_t const maxLeaf = regs[0];
+        if (maxLeaf < 1)
+            return features;
+
+        cpuid(1, 0, regs);
+        features.pclmul = (regs[2] & (1u << 1)) != 0;
+        bool const osxsave = (regs[2] & (1u << 27)) != 0;
+        bool const avx = (regs[2] & (1u << 28)) != 0;
+
+        // AVX2 also requires the OS to save the YMM registers.
+        bool const osSavesYmm = osxsave && (readXcr0() & 0x6) == 0x6;
+        if (maxLeaf >= 7 && avx && osSavesYmm)
+        {
+            cpuid(7, 0, regs);
+            features.avx2 = (regs[1] & (1u << 5)) != 0;
+        }
+#endif
+
+        return features;
+    }
+}
+
+Texas::detail::CpuFeatures const& Texas::detail::getCpuFeatures() noexcept
+{
+    static CpuFeatures const features = detectCpuFeatures();
+    return features;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#   define TEXAS_ARCH_X86
+#endif
+
+// SSE2 is part of the x86-64 baseline, so it does not need to be detected at runtime.
+#if defined(TEXAS_ARCH_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define TEXAS_HAS_SSE2
+#endif
+
+// Marks a function as allowed to use instructions beyond the compiler's baseline.
+// Such functions must only be called after checking getCpuFeatures().
+#if defined(_MSC_VER) && !defined(__clang__)
+#   define TEXAS_TARGET(targetName)
+#else
+#   define TEXAS_TARGET(targetName) __attribute__((target(targetName)))
+#endif
+
+namespace Texas::detail
+{
+    /*
+        Instruction set extensions available on the CPU we are running on.
+    */
+    struct CpuFeatures
+    {
+        // Carry-less multiplication, used for CRC-32.
+        bool pclmul = false;
+        bool avx2 = false;
+    };
+
+    /*
+        Returns the features of the CPU we are running on.
+        They are only detected the first time this is called.
+    */
+    [[nodiscard]] CpuFeatures const& getCpuFeatures() noexcept;
+}
@@ -0,0 +1,230 @@
+#include "Crc32.hpp"
+
+#include "CpuFeatures.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(TEXAS_HAS_SSE2)
+#   include <immintrin.h>
+#endif
+
+// The ARMv8 CRC32 instructions read the data as little-endian.
+#if defined(__ARM_FEATURE_CRC32) && !defined(__ARM_BIG_ENDIAN)
+#   define TEXAS_HAS_ARM_CRC32
+#   include <arm_acle.h>
+#endif
+
+/*
+    Every kernel works on the CRC register as it is between bytes,
+    which is the bitwise inverse of the CRC value zLib's crc32() takes and returns.
+*/
+
+namespace Texas::detail
+{
+    using Crc32Kernel = std::uint32_t(*)(std::uint32_t crcRegister, std::uint8_t const* data, std::size_t size) noexcept;
+
+    // Lookup tables for the reflected CRC-32 polynomial 0xEDB88320.
+    // values[n][b] is the CRC register after byte b, followed by n zero bytes.
+    struct Crc32Tables
+    {
+        std::uint32_t values[8][256] = {};
+    };
+
+    [[nodiscard]] static constexpr Crc32Tables makeCrc32Tables() noexcept
+    {
+        Crc32Tables tables{};
+        for (std::uint32_t i = 0; i < 256; i++)
+        {
+            std::uint32_t value = i;
+            for (int bit = 0; bit < 8; bit++)
+                value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+            tables.values[0][i] = value;
+        }
+        for (std::uint32_t i = 0; i < 256; i++)
+        {
+            for (std::size_t n = 1; n < 8; n++)
+            {
+                std::uint32_t const prev = tables.values[n - 1][i];
+                tables.values[n][i] = (prev >> 8) ^ tables.values[0][prev & 0xFF];
+            }
+        }
+        return tables;
+    }
+
+    static constexpr Crc32Tables crc32Tables = makeCrc32Tables();
+
+    [[nodiscard]] static inline std::uint32_t loadU32LittleEndian(std::uint8_t const* ptr) noexcept
+    {
+        return std::uint32_t(ptr[0]) |
+            std::uint32_t(ptr[1]) << 8 |
+            std::uint32_t(ptr[2]) << 16 |
+            std::uint32_t(ptr[3]) << 24;
+    }
+
+    [[nodiscard]] static std::uint32_t crc32_SlicingBy8(
+        std::uint32_t crcRegister,
+        std::uint8_t const* data,
+        std::size_t size) noexcept
+    {
+        auto const& t = crc32Tables.values;
+        while (size >= 8)
+        {
+            std::uint32_t const low = crcRegister ^ loadU32LittleEndian(data);
+            std::uint32_t const high = loadU32LittleEndian(data + 4);
+            crcRegister =
+                t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+                t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+            data += 8;
+            size -= 8;
+        }
+        for (std::size_t i = 0; i < size; i++)
+            crcRegister = t[0][(crcRegister ^ data[i]) & 0xFF] ^ (crcRegister >> 8);
+        return crcRegister;
+    }
+
+#if defined(TEXAS_HAS_SSE2)
+    // Folds acc 128 bits forward with the constants in k, onto next.
+    TEXAS_TARGET("pclmul")
+    [[nodiscard]] static inline __m128i fold16_PCLMUL(__m128i acc, __m128i next, __m128i k) noexcept
+    {
+        __m128i const low = _mm_clmulepi64_si128(acc, k, 0x00);
+        __m128i const high = _mm_clmulepi64_si128(acc, k, 0x11);
+        return _mm_xor_si128(_mm_xor_si128(high, low), next);
+    }
+
+    /*
+        Folds 64 bytes at a time with carry-less multiplication, then reduces to 32 bits
+        with a Barrett reduction. Follows Intel's "Fast CRC Computation for Generic Polynomials
+        Using PCLMULQDQ Instruction", with the constants for the reflected polynomial.
+
+        size must be atleast 64, and a multiple of 16.
+    */
+    TEXAS_TARGET("pclmul")
+    [[nodiscard]] static std::uint32_t crc32_Fold_PCLMUL(
+        std::uint32_t crcRegister,
+        std::uint8_t const* data,
+        std::size_t size) noexcept
+    {
+        // x^(4*128+32) mod P and x^(4*128-32) mod P, for folding across 64 bytes.
+        __m128i const k1k2 = _mm_set_epi64x(0x01C6E41596, 0x0154442BD4);
+        // x^(128+32) mod P and x^(128-32) mod P, for folding across 16 bytes.
+        __m128i const k3k4 = _mm_set_epi64x(0x00CCAA009E, 0x01751997D0);
+        // x^64 mod P
+        __m128i const k5 = _mm_set_epi64x(0, 0x0163CD6124);
+        // P and its Barrett constant mu
+        __m128i const polyMu = _mm_set_epi64x(0x01F7011641, 0x01DB710641);
+        __m128i const mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+        __m128i x1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + 0x00));
+        __m128i x2 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + 0x10));
+        __m128i x3 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + 0x20));
+        __m128i x4 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + 0x30));
+        x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crcRegister)));
+        data += 64;
+        size -= 64;
+
+        // Four independent folds, so the multiplications can overlap.
+        while (size >= 64)
+        {
+            __m128i const x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+            __m128i const x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+            __m128i const x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+            __m128i const x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+            x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+            x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+            x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + 0x00)));
+            x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + 0x10)));
+            x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + 0x20)));
+            x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + 0x30)));
+            data += 64;
+            size -= 64;
+        }
+
+        // Fold the four accumulators into one.
+        x1 = fold16_PCLMUL(x1, x2, k3k4);
+        x1 = fold16_PCLMUL(x1, x3, k3k4);
+        x1 = fold16_PCLMUL(x1, x4, k3k4);
+        while (size >= 16)
+        {
+            x1 = fold16_PCLMUL(x1, _mm_loadu_si128(reinterpret_cast<__m128i const*>(data)), k3k4);
+            data += 16;
+            size -= 16;
+        }
+
+        // Fold 128 bits to 64 bits.
+        x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+        x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+        x2 = _mm_srli_si128(x1, 4);
+        x1 = _mm_and_si128(x1, mask32);
+        x1 = _mm_clmulepi64_si128(x1, k5, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+
+        // Barrett reduction to 32 bits.
+        x2 = _mm_and_si128(x1, mask32);
+        x2 = _mm_clmulepi64_si128(x2, polyMu, 0x10);
+        x2 = _mm_and_si128(x2, mask32);
+        x2 = _mm_clmulepi64_si128(x2, polyMu, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+        return static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(x1, 4)));
+    }
+
+    TEXAS_TARGET("pclmul")
+    [[nodiscard]] static std::uint32_t crc32_PCLMUL(
+        std::uint32_t crcRegister,
+        std::uint8_t const* data,
+        std::size_t size) noexcept
+    {
+        if (size >= 64)
+        {
+            std::size_t const foldSize = size & ~std::size_t(15);
+            crcRegister = crc32_Fold_PCLMUL(crcRegister, data, foldSize);
+            data += foldSize;
+            size -= foldSize;
+        }
+        return crc32_SlicingBy8(crcRegister, data, size);
+    }
+#endif
+
+#if defined(TEXAS_HAS_ARM_CRC32)
+    [[nodiscard]] static std::uint32_t crc32_ArmCrc32(
+        std::uint32_t crcRegister,
+        std::uint8_t const* data,
+        std::size_t size) noexcept
+    {
+        while (size >= 8)
+        {
+            std::uint64_t value = 0;
+            std::memcpy(&value, data, sizeof(value));
+            crcRegister = __crc32d(crcRegister, value);
+            data += 8;
+            size -= 8;
+        }
+        for (std::size_t i = 0; i < size; i++)
+            crcRegister = __crc32b(crcRegister, data[i]);
+        return crcRegister;
+    }
+#endif
+
+    [[nodiscard]] static Crc32Kernel selectCrc32Kernel() noexcept
+    {
+#if defined(TEXAS_HAS_ARM_CRC32)
+        // The compiler only defines this when every CPU we can run on has the instructions.
+        return &crc32_ArmCrc32;
+#else
+#   if defined(TEXAS_HAS_SSE2)
+        if (getCpuFeatures().pclmul)
+            return &crc32_PCLMUL;
+#   endif
+        return &crc32_SlicingBy8;
+#endif
+    }
+}
+
+std::uint32_t Texas::detail::updateCrc32(std::uint32_t crc, ConstByteSpan data) noexcept
+{
+    static Crc32Kernel const kernel = selectCrc32Kernel();
+    return ~kernel(~crc, reinterpret_cast<std::uint8_t const*>(data.data()), data.size());
+}
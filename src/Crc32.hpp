@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Texas/Span.hpp"
+
+#include <cstdint>
+
+namespace Texas::detail
+{
+    /*
+        Continues crc over data, with the CRC-32 used by PNG and zLib. Start with a crc of 0.
+        Gives the same result as zLib's crc32().
+
+        Uses PCLMULQDQ on x86 and the CRC32 instructions on ARMv8 where they are available,
+        and slicing-by-8 tables everywhere else.
+    */
+    [[nodiscard]] std::uint32_t updateCrc32(std::uint32_t crc, ConstByteSpan data) noexcept;
+}
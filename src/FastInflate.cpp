@@ -0,0 +1,849 @@
+#include "FastInflate.hpp"
+
+// For std::memcpy and std::memset
+#include <cstring>
+
+namespace Texas::detail
+{
+    // Bits looked up at once in the main decode tables. Longer codes continue in a subtable.
+    constexpr std::uint32_t litLenTableBits = 11;
+    constexpr std::uint32_t distTableBits = 10;
+    constexpr std::uint32_t codeLenTableBits = 7;
+    constexpr std::uint32_t maxCodeLength = 15;
+
+    constexpr std::uint32_t litLenSymbolCount = 288;
+    constexpr std::uint32_t distSymbolCount = 32;
+    constexpr std::uint32_t codeLenSymbolCount = 19;
+    // The most symbols a dynamic block can give a code-length to.
+    constexpr std::uint32_t maxDynamicLitLenCount = 286;
+    constexpr std::uint32_t maxDynamicDistCount = 30;
+    constexpr std::uint32_t endOfBlockSymbol = 256;
+
+    // Every code gets a subtable of the same size, and there is atmost one subtable per symbol.
+    constexpr std::size_t litLenTableSize = (1 << litLenTableBits) + litLenSymbolCount * (1 << (maxCodeLength - litLenTableBits));
+    constexpr std::size_t distTableSize = (1 << distTableBits) + distSymbolCount * (1 << (maxCodeLength - distTableBits));
+    constexpr std::size_t codeLenTableSize = 1 << codeLenTableBits;
+
+    /*
+        Every entry of a decode table is 32 bits.
+         - Bits 0-4 are the amount of bits the code takes up.
+           For pairs of literals, it's both codes together.
+         - Bits 5-8 are the amount of extra bits that follow a length or distance code,
+           or the amount of bits a subtable is indexed by.
+         - Bits 11-15 are the flags below.
+         - Bits 16-31 are the value. One literal in bits 16-23 and the next in bits 24-31,
+           the base of a length or distance, a code-length, or the offset of a subtable.
+    */
+    constexpr std::uint32_t entryInvalid = 1 << 11;
+    constexpr std::uint32_t entrySubtable = 1 << 12;
+    constexpr std::uint32_t entryEndOfBlock = 1 << 13;
+    constexpr std::uint32_t entryLiteralPair = 1 << 14;
+    constexpr std::uint32_t entryLiteral = 1 << 15;
+
+    constexpr std::uint16_t lengthBases[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    constexpr std::uint8_t lengthExtraBits[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    constexpr std::uint16_t distBases[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    constexpr std::uint8_t distExtraBits[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+    // The order the code-lengths of the code-length code are stored in.
+    constexpr std::uint8_t codeLenOrder[codeLenSymbolCount] = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    enum class CodeKind : char
+    {
+        LitLen,
+        Dist,
+        CodeLen
+    };
+
+    [[nodiscard]] static constexpr std::uint32_t entryLength(std::uint32_t entry) noexcept
+    {
+        return entry & 0x1f;
+    }
+
+    [[nodiscard]] static constexpr std::uint32_t entryExtraBits(std::uint32_t entry) noexcept
+    {
+        return (entry >> 5) & 0xf;
+    }
+
+    /*
+        Reads the compressed data through a 64-bit bit buffer. Bits are consumed from the bottom.
+
+        When atleast 8 bytes are left in the current piece of data, the buffer is refilled
+        with a single 8-byte load. The bits above bitCount() then hold the start of the
+        bytes that come next, which is what they get filled with anyway.
+    */
+    class InflateBitReader
+    {
+    public:
+        explicit InflateBitReader(FastInflateSource& source) noexcept :
+            m_source(&source)
+        {
+        }
+
+        // Buffers atleast 56 bits, unless the compressed data runs out first.
+        void refill() noexcept
+        {
+            if (m_end - m_pos >= 8)
+            {
+                m_bitBuffer |= loadU64(m_pos) << m_bitCount;
+                m_pos += (63 - m_bitCount) >> 3;
+                m_bitCount |= 56;
+            }
+            else
+                refillSlow();
+        }
+
+        [[nodiscard]] std::uint64_t bits() const noexcept
+        {
+            return m_bitBuffer;
+        }
+
+        [[nodiscard]] std::uint32_t bitCount() const noexcept
+        {
+            return m_bitCount;
+        }
+
+        void consume(std::uint32_t count) noexcept
+        {
+            m_bitBuffer >>= count;
+            m_bitCount -= count;
+        }
+
+        /*
+            Reads count bits into value, count must be 32 or less.
+            Returns false if the compressed data ran out.
+        */
+        [[nodiscard]] bool read(std::uint32_t count, std::uint32_t& value) noexcept
+        {
+            if (m_bitCount < count)
+            {
+                refill();
+                if (m_bitCount < count)
+                    return false;
+            }
+            value = static_cast<std::uint32_t>(m_bitBuffer & ((std::uint64_t(1) << count) - 1));
+            consume(count);
+            return true;
+        }
+
+        void alignToByte() noexcept
+        {
+            consume(m_bitCount & 7);
+        }
+
+        /*
+            Copies count bytes of the compressed data as-is into dst. Must be at a byte boundary.
+            Returns false if the compressed data ran out.
+        */
+        [[nodiscard]] bool copyBytes(std::byte* dst, std::size_t count) noexcept
+        {
+            while (count > 0 && m_bitCount >= 8)
+            {
+                *dst = static_cast<std::byte>(m_bitBuffer & 0xff);
+                dst += 1;
+                consume(8);
+                count -= 1;
+            }
+            if (count == 0)
+                return true;
+
+            // The bits above m_bitCount are the bytes we are about to copy past.
+            m_bitBuffer = 0;
+            while (count > 0)
+            {
+                if (m_pos == m_end && !nextPiece())
+                    return false;
+                std::size_t amount = static_cast<std::size_t>(m_end - m_pos);
+                if (amount > count)
+                    amount = count;
+                std::memcpy(dst, m_pos, amount);
+                dst += amount;
+                m_pos += amount;
+                count -= amount;
+            }
+            return true;
+        }
+
+    private:
+        [[nodiscard]] static std::uint64_t loadU64(std::byte const* ptr) noexcept
+        {
+            std::uint64_t value = 0;
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+            // GCC only merges the loop below into one load when it unrolls it, which it does not at -O2.
+            std::memcpy(&value, ptr, sizeof(value));
+#else
+            for (std::uint32_t i = 0; i < 8; i++)
+                value |= std::uint64_t(ptr[i]) << (i * 8);
+#endif
+            return value;
+        }
+
+        [[nodiscard]] bool nextPiece() noexcept
+        {
+            if (m_sourceEnded)
+                return false;
+            ConstByteSpan const data = m_source->next();
+            if (data.size() == 0)
+            {
+                m_sourceEnded = true;
+                return false;
+            }
+            m_pos = data.data();
+            m_end = data.data() + data.size();
+            return true;
+        }
+
+        void refillSlow() noexcept
+        {
+            while (m_bitCount < 56)
+            {
+                if (m_pos == m_end && !nextPiece())
+                    return;
+                m_bitBuffer |= std::uint64_t(*m_pos) << m_bitCount;
+                m_pos += 1;
+                m_bitCount += 8;
+            }
+        }
+
+        FastInflateSource* m_source = nullptr;
+        bool m_sourceEnded = false;
+        std::byte const* m_pos = nullptr;
+        std::byte const* m_end = nullptr;
+        std::uint64_t m_bitBuffer = 0;
+        std::uint32_t m_bitCount = 0;
+    };
+
+    struct InflateTables
+    {
+        std::uint32_t litLen[litLenTableSize];
+        std::uint32_t dist[distTableSize];
+    };
+
+    [[nodiscard]] static std::uint32_t makeEntry(CodeKind kind, std::uint32_t symbol) noexcept;
+
+    /*
+        Builds a decode table for the canonical Huffman code described by codeLengths.
+        Returns false if the code-lengths do not make up a valid code.
+    */
+    [[nodiscard]] static bool buildDecodeTable(
+        std::uint8_t const* codeLengths,
+        std::uint32_t symbolCount,
+        CodeKind kind,
+        std::uint32_t* table,
+        std::uint32_t tableBits) noexcept;
+
+    // Merges literals whose codes fit in the main table together with the literal after them.
+    static void pairLiterals(std::uint32_t* litLenTable) noexcept;
+
+    static void buildFixedTables(InflateTables& tables) noexcept;
+
+    [[nodiscard]] static Result readDynamicTables(InflateBitReader& reader, InflateTables& tables) noexcept;
+
+    /*
+        Looks up the next code in table. The reader must have been refilled.
+        Returns false if the compressed data ran out.
+
+        This and copyMatch run for every symbol, so they are marked inline. Otherwise GCC does not
+        inline this into inflateHuffmanBlock at -O2, and the reader has to be kept in memory.
+    */
+    [[nodiscard]] static inline bool decodeSymbol(
+        InflateBitReader& reader,
+        std::uint32_t const* table,
+        std::uint32_t tableBits,
+        std::uint32_t& entry) noexcept;
+
+    // dst has room for atleast length bytes, and distance bytes have been written before it.
+    static inline void copyMatch(std::byte* dst, std::size_t distance, std::size_t length, std::byte const* dstEnd) noexcept;
+
+    [[nodiscard]] static Result inflateStoredBlock(
+        InflateBitReader& reader,
+        std::byte*& out,
+        std::byte* outEnd) noexcept;
+
+    [[nodiscard]] static Result inflateHuffmanBlock(
+        InflateBitReader& reader,
+        InflateTables const& tables,
+        std::byte const* outStart,
+        std::byte*& out,
+        std::byte* outEnd) noexcept;
+
+    constexpr Result truncatedResult = { ResultType::CorruptFileData, "zLib data-stream ended before all of it was decompressed." };
+    constexpr Result tooMuchDataResult = { ResultType::CorruptFileData, "zLib data-stream decompresses to more data than the destination can hold." };
+}
+
+Texas::Result Texas::detail::fastInflate(FastInflateSource& source, ByteSpan dst) noexcept
+{
+    InflateBitReader reader(source);
+
+    std::uint32_t cmf = 0;
+    std::uint32_t flg = 0;
+    if (!reader.read(8, cmf) || !reader.read(8, flg))
+        return truncatedResult;
+    // Compression method must be deflate, with a window of atmost 32K.
+    if ((cmf & 0xf) != 8 || (cmf >> 4) > 7 || (cmf * 256 + flg) % 31 != 0)
+        return { ResultType::CorruptFileData, "zLib data-stream has an invalid header." };
+    if ((flg & 0x20) != 0)
+        return { ResultType::CorruptFileData, "zLib data-stream asks for a preset dictionary, which is not supported." };
+
+    std::byte* const outStart = dst.data();
+    std::byte* const outEnd = dst.data() + dst.size();
+    std::byte* out = outStart;
+
+    // Large, but this keeps decompression free of allocations.
+    InflateTables tables;
+
+    bool isFinalBlock = false;
+    while (!isFinalBlock)
+    {
+        std::uint32_t blockHeader = 0;
+        if (!reader.read(3, blockHeader))
+            return truncatedResult;
+        isFinalBlock = (blockHeader & 1) != 0;
+
+        Result result{};
+        switch (blockHeader >> 1)
+        {
+        case 0:
+            result = inflateStoredBlock(reader, out, outEnd);
+            break;
+        case 1:
+            buildFixedTables(tables);
+            result = inflateHuffmanBlock(reader, tables, outStart, out, outEnd);
+            break;
+        case 2:
+            result = readDynamicTables(reader, tables);
+            if (result.isSuccessful())
+                result = inflateHuffmanBlock(reader, tables, outStart, out, outEnd);
+            break;
+        default:
+            return { ResultType::CorruptFileData, "zLib data-stream has a block of invalid type." };
+        }
+        if (!result.isSuccessful())
+            return result;
+    }
+
+    if (out != outEnd)
+        return { ResultType::CorruptFileData, "zLib data-stream ended before the destination was filled." };
+
+    // The Adler-32 checksum is stored big-endian, at the next byte boundary.
+    reader.alignToByte();
+    std::uint32_t checksum = 0;
+    for (std::uint32_t i = 0; i < 4; i++)
+    {
+        std::uint32_t checksumByte = 0;
+        if (!reader.read(8, checksumByte))
+            return truncatedResult;
+        checksum = checksum << 8 | checksumByte;
+    }
+    if (checksum != adler32(dst))
+        return { ResultType::CorruptFileData, "zLib data-stream does not match its Adler-32 checksum." };
+
+    return { ResultType::Success, nullptr };
+}
+
+std::uint32_t Texas::detail::adler32(ConstByteSpan data) noexcept
+{
+    constexpr std::uint32_t modulo = 65521;
+    constexpr std::size_t laneCount = 16;
+    // laneSumTotals below grow with the square of the block size, and stay within 32 bits up to this.
+    constexpr std::size_t maxBlockSize = 1 << 16;
+
+    std::uint32_t a = 1;
+    std::uint32_t b = 0;
+    std::byte const* ptr = data.data();
+    std::size_t remaining = data.size();
+    while (remaining >= laneCount)
+    {
+        std::size_t blockSize = remaining < maxBlockSize ? remaining : maxBlockSize;
+        blockSize -= blockSize % laneCount;
+        remaining -= blockSize;
+        std::size_t const groupCount = blockSize / laneCount;
+
+        /*
+            We sum each of the 16 byte positions of every 16-byte group separately, 
+            which the compiler can turn into vector instructions.
+            laneSums[j] is the sum of byte j of every group so far, and laneSumTotals[j] 
+            the sum of laneSums[j] from before each group. 
+            Byte j of group g is counted in b once for every byte from it to the end of the block,
+            which is 16 * (groupCount - g) - j times.
+        */
+        std::uint32_t laneSums[laneCount] = {};
+        std::uint32_t laneSumTotals[laneCount] = {};
+        for (std::size_t group = 0; group < groupCount; group++)
+        {
+            for (std::size_t j = 0; j < laneCount; j++)
+            {
+                laneSumTotals[j] += laneSums[j];
+                laneSums[j] += std::uint32_t(ptr[j]);
+            }
+            ptr += laneCount;
+        }
+
+        std::uint64_t byteSum = 0;
+        std::uint64_t weightedSum = 0;
+        for (std::size_t j = 0; j < laneCount; j++)
+        {
+            byteSum += laneSums[j];
+            weightedSum += std::uint64_t(laneSums[j] + laneSumTotals[j]) * laneCount - std::uint64_t(laneSums[j]) * j;
+        }
+        b = static_cast<std::uint32_t>((b + std::uint64_t(a) * blockSize + weightedSum) % modulo);
+        a = static_cast<std::uint32_t>((a + byteSum) % modulo);
+    }
+    while (remaining > 0)
+    {
+        a += std::uint32_t(*ptr);
+        b += a;
+        ptr += 1;
+        remaining -= 1;
+    }
+    return (b % modulo) << 16 | (a % modulo);
+}
+
+static std::uint32_t Texas::detail::makeEntry(CodeKind kind, std::uint32_t symbol) noexcept
+{
+    switch (kind)
+    {
+    case CodeKind::CodeLen:
+        return symbol << 16;
+    case CodeKind::LitLen:
+        if (symbol < endOfBlockSymbol)
+            return entryLiteral | symbol << 16;
+        if (symbol == endOfBlockSymbol)
+            return entryEndOfBlock;
+        if (symbol - 257 < sizeof(lengthBases) / sizeof(lengthBases[0]))
+            return std::uint32_t(lengthBases[symbol - 257]) << 16 | std::uint32_t(lengthExtraBits[symbol - 257]) << 5;
+        return entryInvalid;
+    case CodeKind::Dist:
+        if (symbol < sizeof(distBases) / sizeof(distBases[0]))
+            return std::uint32_t(distBases[symbol]) << 16 | std::uint32_t(distExtraBits[symbol]) << 5;
+        return entryInvalid;
+    default:
+        return entryInvalid;
+    }
+}
+
+static bool Texas::detail::buildDecodeTable(
+    std::uint8_t const* codeLengths,
+    std::uint32_t symbolCount,
+    CodeKind kind,
+    std::uint32_t* table,
+    std::uint32_t tableBits) noexcept
+{
+    std::uint32_t lengthCounts[maxCodeLength + 1] = {};
+    for (std::uint32_t symbol = 0; symbol < symbolCount; symbol++)
+        lengthCounts[codeLengths[symbol]] += 1;
+    lengthCounts[0] = 0;
+
+    std::uint32_t maxLength = 0;
+    std::int32_t codesLeft = 1;
+    for (std::uint32_t length = 1; length <= maxCodeLength; length++)
+    {
+        codesLeft = codesLeft * 2 - std::int32_t(lengthCounts[length]);
+        if (codesLeft < 0)
+            return false;
+        if (lengthCounts[length] > 0)
+            maxLength = length;
+    }
+    // Same as zLib, codes can only be incomplete if they consist of a single code.
+    if (maxLength > 0 && codesLeft > 0 && (kind == CodeKind::CodeLen || maxLength != 1))
+        return false;
+
+    std::uint32_t const tableSize = std::uint32_t(1) << tableBits;
+    for (std::uint32_t i = 0; i < tableSize; i++)
+        table[i] = entryInvalid;
+
+    // The first code of every length, as described in RFC 1951.
+    std::uint32_t nextCodes[maxCodeLength + 1] = {};
+    std::uint32_t code = 0;
+    for (std::uint32_t length = 1; length <= maxCodeLength; length++)
+    {
+        code = (code + lengthCounts[length - 1]) << 1;
+        nextCodes[length] = code;
+    }
+
+    std::uint32_t const subtableBits = maxCodeLength - tableBits;
+    std::uint32_t nextSubtableOffset = tableSize;
+    for (std::uint32_t symbol = 0; symbol < symbolCount; symbol++)
+    {
+        std::uint32_t const length = codeLengths[symbol];
+        if (length == 0)
+            continue;
+
+        // Codes are packed starting with their most significant bit,
+        // while we read bits starting with the least significant one.
+        std::uint32_t const code = nextCodes[length];
+        nextCodes[length] += 1;
+        std::uint32_t reversedCode = 0;
+        for (std::uint32_t i = 0; i < length; i++)
+            reversedCode |= ((code >> i) & 1) << (length - 1 - i);
+
+        std::uint32_t const entry = makeEntry(kind, symbol);
+        if (length <= tableBits)
+        {
+            // Fill every slot whose low bits are this code.
+            for (std::uint32_t i = reversedCode; i < tableSize; i += std::uint32_t(1) << length)
+                table[i] = entry | length;
+        }
+        else
+        {
+            std::uint32_t const prefix = reversedCode & (tableSize - 1);
+            if ((table[prefix] & entrySubtable) == 0)
+            {
+                table[prefix] = entrySubtable | nextSubtableOffset << 16 | subtableBits << 5 | tableBits;
+                for (std::uint32_t i = 0; i < (std::uint32_t(1) << subtableBits); i++)
+                    table[nextSubtableOffset + i] = entryInvalid;
+                nextSubtableOffset += std::uint32_t(1) << subtableBits;
+            }
+            std::uint32_t const subtableOffset = table[prefix] >> 16;
+            std::uint32_t const subtableLength = length - tableBits;
+            for (std::uint32_t i = reversedCode >> tableBits; i < (std::uint32_t(1) << subtableBits); i += std::uint32_t(1) << subtableLength)
+                table[subtableOffset + i] = entry | subtableLength;
+        }
+    }
+    return true;
+}
+
+static void Texas::detail::pairLiterals(std::uint32_t* litLenTable) noexcept
+{
+    // Going backwards, the entry we pair with has a lower index and has not been paired yet.
+    for (std::uint32_t i = (std::uint32_t(1) << litLenTableBits); i-- > 0;)
+    {
+        std::uint32_t const entry = litLenTable[i];
+        if ((entry & entryLiteral) == 0)
+            continue;
+        std::uint32_t const length = entryLength(entry);
+        if (length >= litLenTableBits)
+            continue;
+        // The bits after the first code are known up to the size of the table,
+        // which is enough to look up any code that fits in them.
+        std::uint32_t const nextEntry = litLenTable[i >> length];
+        if ((nextEntry & entryLiteral) == 0 || entryLength(nextEntry) > litLenTableBits - length)
+            continue;
+        litLenTable[i] =
+            entryLiteral | entryLiteralPair |
+            (entry >> 16) << 16 | (nextEntry >> 16) << 24 |
+            (length + entryLength(nextEntry));
+    }
+}
+
+static void Texas::detail::buildFixedTables(InflateTables& tables) noexcept
+{
+    std::uint8_t litLenLengths[litLenSymbolCount] = {};
+    std::memset(litLenLengths, 8, 144);
+    std::memset(litLenLengths + 144, 9, 256 - 144);
+    std::memset(litLenLengths + 256, 7, 280 - 256);
+    std::memset(litLenLengths + 280, 8, litLenSymbolCount - 280);
+    std::uint8_t distLengths[distSymbolCount] = {};
+    std::memset(distLengths, 5, distSymbolCount);
+
+    // The fixed code-lengths are always valid.
+    (void)buildDecodeTable(litLenLengths, litLenSymbolCount, CodeKind::LitLen, tables.litLen, litLenTableBits);
+    pairLiterals(tables.litLen);
+    (void)buildDecodeTable(distLengths, distSymbolCount, CodeKind::Dist, tables.dist, distTableBits);
+}
+
+static Texas::Result Texas::detail::readDynamicTables(InflateBitReader& reader, InflateTables& tables) noexcept
+{
+    std::uint32_t litLenCount = 0;
+    std::uint32_t distCount = 0;
+    std::uint32_t codeLenCount = 0;
+    if (!reader.read(5, litLenCount) || !reader.read(5, distCount) || !reader.read(4, codeLenCount))
+        return truncatedResult;
+    litLenCount += 257;
+    distCount += 1;
+    codeLenCount += 4;
+    if (litLenCount > maxDynamicLitLenCount || distCount > maxDynamicDistCount)
+        return { ResultType::CorruptFileData, "zLib data-stream has too many length or distance symbols." };
+
+    std::uint8_t codeLenLengths[codeLenSymbolCount] = {};
+    for (std::uint32_t i = 0; i < codeLenCount; i++)
+    {
+        std::uint32_t length = 0;
+        if (!reader.read(3, length))
+            return truncatedResult;
+        codeLenLengths[codeLenOrder[i]] = static_cast<std::uint8_t>(length);
+    }
+    std::uint32_t codeLenTable[codeLenTableSize];
+    if (!buildDecodeTable(codeLenLengths, codeLenSymbolCount, CodeKind::CodeLen, codeLenTable, codeLenTableBits))
+        return { ResultType::CorruptFileData, "zLib data-stream has an invalid code-length code." };
+
+    // The code-lengths of both codes are stored as one sequence, and repeats can cross from one to the other.
+    std::uint8_t lengths[maxDynamicLitLenCount + maxDynamicDistCount] = {};
+    std::uint32_t const totalCount = litLenCount + distCount;
+    std::uint32_t index = 0;
+    while (index < totalCount)
+    {
+        reader.refill();
+        std::uint32_t entry = 0;
+        if (!decodeSymbol(reader, codeLenTable, codeLenTableBits, entry))
+            return truncatedResult;
+        if ((entry & entryInvalid) != 0)
+            return { ResultType::CorruptFileData, "zLib data-stream has an invalid code-length." };
+
+        std::uint32_t const symbol = entry >> 16;
+        if (symbol < 16)
+        {
+            lengths[index] = static_cast<std::uint8_t>(symbol);
+            index += 1;
+            continue;
+        }
+
+        std::uint8_t repeatedLength = 0;
+        std::uint32_t repeatCount = 0;
+        bool readSuccess = false;
+        if (symbol == 16)
+        {
+            if (index == 0)
+                return { ResultType::CorruptFileData, "zLib data-stream repeats a code-length before the first one." };
+            repeatedLength = lengths[index - 1];
+            readSuccess = reader.read(2, repeatCount);
+            repeatCount += 3;
+        }
+        else if (symbol == 17)
+        {
+            readSuccess = reader.read(3, repeatCount);
+            repeatCount += 3;
+        }
+        else
+        {
+            readSuccess = reader.read(7, repeatCount);
+            repeatCount += 11;
+        }
+        if (!readSuccess)
+            return truncatedResult;
+        if (repeatCount > totalCount - index)
+            return { ResultType::CorruptFileData, "zLib data-stream repeats code-lengths past the last symbol." };
+        std::memset(lengths + index, repeatedLength, repeatCount);
+        index += repeatCount;
+    }
+
+    if (lengths[endOfBlockSymbol] == 0)
+        return { ResultType::CorruptFileData, "zLib data-stream has a block without an end-of-block code." };
+
+    std::uint8_t litLenLengths[litLenSymbolCount] = {};
+    std::memcpy(litLenLengths, lengths, litLenCount);
+    std::uint8_t distLengths[distSymbolCount] = {};
+    std::memcpy(distLengths, lengths + litLenCount, distCount);
+
+    if (!buildDecodeTable(litLenLengths, litLenSymbolCount, CodeKind::LitLen, tables.litLen, litLenTableBits))
+        return { ResultType::CorruptFileData, "zLib data-stream has an invalid literal/length code." };
+    pairLiterals(tables.litLen);
+    if (!buildDecodeTable(distLengths, distSymbolCount, CodeKind::Dist, tables.dist, distTableBits))
+        return { ResultType::CorruptFileData, "zLib data-stream has an invalid distance code." };
+
+    return { ResultType::Success, nullptr };
+}
+
+static inline bool Texas::detail::decodeSymbol(
+    InflateBitReader& reader,
+    std::uint32_t const* table,
+    std::uint32_t tableBits,
+    std::uint32_t& entry) noexcept
+{
+    // Bits past bitCount() are either zero or the bytes that come next, but codes never
+    // depend on bits past their own length, so we only have to check the length we find.
+    std::uint32_t found = table[reader.bits() & ((std::uint32_t(1) << tableBits) - 1)];
+    if ((found & entrySubtable) != 0)
+    {
+        if (reader.bitCount() < tableBits)
+            return false;
+        reader.consume(tableBits);
+        std::uint32_t const subtableMask = (std::uint32_t(1) << entryExtraBits(found)) - 1;
+        found = table[(found >> 16) + (reader.bits() & subtableMask)];
+    }
+    if (entryLength(found) > reader.bitCount())
+        return false;
+    reader.consume(entryLength(found));
+    entry = found;
+    return true;
+}
+
+static inline void Texas::detail::copyMatch(std::byte* dst, std::size_t distance, std::size_t length, std::byte const* dstEnd) noexcept
+{
+    std::byte const* src = dst - distance;
+    std::byte* const matchEnd = dst + length;
+    // When there's room, we copy whole blocks and let the last one run past the match.
+    // Whatever it writes there is overwritten by the data that comes next.
+    if (distance >= 16 && dstEnd - matchEnd >= 16)
+    {
+        do
+        {
+            std::memcpy(dst, src, 16);
+            dst += 16;
+            src += 16;
+        } while (dst < matchEnd);
+    }
+    else if (distance >= 8 && dstEnd - matchEnd >= 8)
+    {
+        do
+        {
+            std::memcpy(dst, src, 8);
+            dst += 8;
+            src += 8;
+        } while (dst < matchEnd);
+    }
+    else if (distance == 1)
+        std::memset(dst, static_cast<int>(*src), length);
+    else if (dstEnd - matchEnd >= 8)
+    {
+        // A pattern shorter than 8 bytes repeats. Once we have the first 8 bytes of it,
+        // the same bytes are also found a whole number of repeats back, atleast 8 bytes behind.
+        for (std::uint32_t i = 0; i < 8; i++)
+            dst[i] = src[i];
+        dst += 8;
+        src = dst - distance * ((8 + distance - 1) / distance);
+        while (dst < matchEnd)
+        {
+            std::memcpy(dst, src, 8);
+            dst += 8;
+            src += 8;
+        }
+    }
+    else
+    {
+        // The match overlaps itself, so it has to be copied one byte at a time.
+        while (dst < matchEnd)
+        {
+            *dst = *src;
+            dst += 1;
+            src += 1;
+        }
+    }
+}
+
+static Texas::Result Texas::detail::inflateStoredBlock(
+    InflateBitReader& reader,
+    std::byte*& out,
+    std::byte* outEnd) noexcept
+{
+    reader.alignToByte();
+    std::uint32_t length = 0;
+    std::uint32_t lengthComplement = 0;
+    if (!reader.read(16, length) || !reader.read(16, lengthComplement))
+        return truncatedResult;
+    if (length != (~lengthComplement & 0xffff))
+        return { ResultType::CorruptFileData, "zLib data-stream has a stored block whose length does not match its complement." };
+    if (length > std::size_t(outEnd - out))
+        return tooMuchDataResult;
+    if (!reader.copyBytes(out, length))
+        return truncatedResult;
+    out += length;
+    return { ResultType::Success, nullptr };
+}
+
+static Texas::Result Texas::detail::inflateHuffmanBlock(
+    InflateBitReader& reader,
+    InflateTables const& tables,
+    std::byte const* outStart,
+    std::byte*& out,
+    std::byte* outEnd) noexcept
+{
+    /*
+        We work on copies of reader and out. Writes to the output are writes through std::byte,
+        which may alias anything, so the compiler would otherwise reload both after every one of them.
+
+        After a refill we have atleast 56 bits, unless we are at the end of the data.
+        The most a length and a distance take up together is 15 + 5 + 15 + 13 = 48 bits,
+        so there is only one refill per symbol.
+    */
+    InflateBitReader localReader = reader;
+    std::byte* dst = out;
+    Result result = { ResultType::Success, nullptr };
+    while (true)
+    {
+        localReader.refill();
+        std::uint32_t entry = 0;
+        if (!decodeSymbol(localReader, tables.litLen, litLenTableBits, entry))
+        {
+            result = truncatedResult;
+            break;
+        }
+
+        if ((entry & entryLiteral) != 0)
+        {
+            if ((entry & entryLiteralPair) != 0)
+            {
+                if (outEnd - dst < 2)
+                {
+                    result = tooMuchDataResult;
+                    break;
+                }
+                dst[0] = static_cast<std::byte>(entry >> 16);
+                dst[1] = static_cast<std::byte>(entry >> 24);
+                dst += 2;
+            }
+            else
+            {
+                if (dst == outEnd)
+                {
+                    result = tooMuchDataResult;
+                    break;
+                }
+                *dst = static_cast<std::byte>(entry >> 16);
+                dst += 1;
+            }
+            continue;
+        }
+        if ((entry & entryEndOfBlock) != 0)
+            break;
+        if ((entry & entryInvalid) != 0)
+        {
+            result = { ResultType::CorruptFileData, "zLib data-stream has an invalid literal/length code." };
+            break;
+        }
+
+        std::uint32_t length = entry >> 16;
+        std::uint32_t extraBits = entryExtraBits(entry);
+        if (extraBits > localReader.bitCount())
+        {
+            result = truncatedResult;
+            break;
+        }
+        length += static_cast<std::uint32_t>(localReader.bits() & ((std::uint32_t(1) << extraBits) - 1));
+        localReader.consume(extraBits);
+
+        if (!decodeSymbol(localReader, tables.dist, distTableBits, entry))
+        {
+            result = truncatedResult;
+            break;
+        }
+        if ((entry & entryInvalid) != 0)
+        {
+            result = { ResultType::CorruptFileData, "zLib data-stream has an invalid distance code." };
+            break;
+        }
+        std::uint32_t distance = entry >> 16;
+        extraBits = entryExtraBits(entry);
+        if (extraBits > localReader.bitCount())
+        {
+            result = truncatedResult;
+            break;
+        }
+        distance += static_cast<std::uint32_t>(localReader.bits() & ((std::uint32_t(1) << extraBits) - 1));
+        localReader.consume(extraBits);
+
+        if (distance > std::size_t(dst - outStart))
+        {
+            result = { ResultType::CorruptFileData, "zLib data-stream refers to data before its start." };
+            break;
+        }
+        if (length > std::size_t(outEnd - dst))
+        {
+            result = tooMuchDataResult;
+            break;
+        }
+        copyMatch(dst, distance, length, outEnd);
+        dst += length;
+    }
+    reader = localReader;
+    out = dst;
+    return result;
+}
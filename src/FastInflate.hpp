@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Texas/Result.hpp"
+#include "Texas/Span.hpp"
+
+#include <cstdint>
+
+namespace Texas::detail
+{
+    /*
+        Hands the compressed data of a zLib data-stream to fastInflate, one piece at a time.
+    */
+    class FastInflateSource
+    {
+    public:
+        /*
+            Returns the next piece of compressed data. It must stay valid until next() is called again.
+            Returns an empty span when there is no more data.
+        */
+        [[nodiscard]] virtual ConstByteSpan next() noexcept = 0;
+    };
+
+    /*
+        Decompresses an entire zLib data-stream from source into dst,
+        and checks it against the Adler-32 checksum at its end.
+
+        Built for decompressing into a buffer that holds all of the output, unlike zLib's inflate().
+        The whole buffer is the sliding window, so nothing is copied into a separate window.
+        It reads the input through a 64-bit bit buffer, decodes most literals two at a time,
+        and copies matches 16 bytes at a time.
+
+        Fails if the data-stream decompresses to anything but exactly dst.size() bytes.
+    */
+    [[nodiscard]] Result fastInflate(FastInflateSource& source, ByteSpan dst) noexcept;
+
+    [[nodiscard]] std::uint32_t adler32(ConstByteSpan data) noexcept;
+}
@@ -1,4 +1,5 @@
 #include "Texas/FileInfo.hpp"
+#include "Texas/Tools.hpp"
 
 Texas::TextureInfo const& Texas::FileInfo::textureInfo() const noexcept
 {
@@ -10,7 +11,27 @@ std::uint64_t Texas::FileInfo::memoryRequired() const noexcept
     return m_memoryRequired;
 }
 
+std::uint64_t Texas::FileInfo::memoryRequired(ImageDataRange const& range) const noexcept
+{
+    if (range.mipCount == 0 || range.layerCount == 0)
+        return 0;
+    if (std::uint32_t(range.baseMip) + range.mipCount > m_textureInfo.mipCount)
+        return 0;
+    if (range.baseLayer >= m_textureInfo.layerCount || range.layerCount > m_textureInfo.layerCount - range.baseLayer)
+        return 0;
+
+    std::uint64_t sum = 0;
+    for (std::uint8_t mipIndex = range.baseMip; mipIndex < range.baseMip + range.mipCount; mipIndex++)
+        sum += calculateSingleImageSize(calculateMipDimensions(m_textureInfo.baseDimensions, mipIndex), m_textureInfo.pixelFormat);
+    return sum * range.layerCount;
+}
+
 std::uint64_t Texas::FileInfo::workingMemoryRequired() const noexcept
 {
     return m_workingMemoryRequired;
 }
+
+std::uint64_t Texas::FileInfo::minWorkingMemoryRequired() const noexcept
+{
+    return m_minWorkingMemoryRequired;
+}
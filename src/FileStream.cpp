@@ -0,0 +1,548 @@
+// Makes off_t 64-bit on 32-bit POSIX systems, so pread can reach past 2 GiB.
+#if !defined(_WIN32) && !defined(_FILE_OFFSET_BITS)
+#   define _FILE_OFFSET_BITS 64
+#endif
+
+#include "Texas/FileStream.hpp"
+
+// For std::memcpy
+#include <cstring>
+
+#if defined(_WIN32)
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <Windows.h>
+#else
+#   include <cerrno>
+#   include <fcntl.h>
+#   include <sys/stat.h>
+#   include <sys/uio.h>
+#   include <unistd.h>
+// For IOV_MAX
+#   include <climits>
+#endif
+
+#if !defined(_WIN32)
+namespace Texas::detail
+{
+    // Amount of spans handed to a single preadv() call.
+#   if defined(IOV_MAX) && IOV_MAX < 128
+    constexpr int fileReadMaxIovecCount = IOV_MAX;
+#   else
+    constexpr int fileReadMaxIovecCount = 128;
+#   endif
+}
+#endif
+
+Texas::FileHandle::FileHandle(FileHandle&& other) noexcept :
+    m_nativeHandle(other.m_nativeHandle),
+    m_directHandle(other.m_directHandle),
+    m_size(other.m_size)
+{
+    other.m_nativeHandle = -1;
+    other.m_directHandle = -1;
+    other.m_size = 0;
+}
+
+Texas::FileHandle& Texas::FileHandle::operator=(FileHandle&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    close();
+    m_nativeHandle = other.m_nativeHandle;
+    m_directHandle = other.m_directHandle;
+    m_size = other.m_size;
+    other.m_nativeHandle = -1;
+    other.m_directHandle = -1;
+    other.m_size = 0;
+
+    return *this;
+}
+
+Texas::FileHandle::~FileHandle()
+{
+    close();
+}
+
+Texas::Result Texas::FileHandle::open(char const* path, bool enableDirectReads) noexcept
+{
+    close();
+
+#if defined(_WIN32)
+    HANDLE const file = CreateFileA(
+        path,
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return { ResultType::CouldNotOpenFile, "Failed to open this file for reading." };
+
+    LARGE_INTEGER fileSize{};
+    if (GetFileSizeEx(file, &fileSize) == 0)
+    {
+        CloseHandle(file);
+        return { ResultType::CouldNotOpenFile, "Failed to query the size of this file." };
+    }
+
+    m_nativeHandle = reinterpret_cast<std::intptr_t>(file);
+    m_size = static_cast<std::uint64_t>(fileSize.QuadPart);
+
+    if (enableDirectReads)
+    {
+        HANDLE const directFile = CreateFileA(
+            path,
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING,
+            nullptr);
+        if (directFile != INVALID_HANDLE_VALUE)
+            m_directHandle = reinterpret_cast<std::intptr_t>(directFile);
+    }
+#else
+    int const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        return { ResultType::CouldNotOpenFile, "Failed to open this file for reading." };
+
+    struct stat fileStat{};
+    if (::fstat(fd, &fileStat) != 0)
+    {
+        ::close(fd);
+        return { ResultType::CouldNotOpenFile, "Failed to query the size of this file." };
+    }
+
+    m_nativeHandle = fd;
+    m_size = static_cast<std::uint64_t>(fileStat.st_size);
+
+    if (enableDirectReads)
+    {
+        // Filesystems like tmpfs refuse O_DIRECT, then we go without.
+#   if defined(O_DIRECT)
+        int const directFd = ::open(path, O_RDONLY | O_CLOEXEC | O_DIRECT);
+#   elif defined(F_NOCACHE)
+        int directFd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (directFd != -1 && ::fcntl(directFd, F_NOCACHE, 1) == -1)
+        {
+            ::close(directFd);
+            directFd = -1;
+        }
+#   else
+        int const directFd = -1;
+#   endif
+        if (directFd != -1)
+            m_directHandle = directFd;
+    }
+#endif
+
+    return { ResultType::Success, nullptr };
+}
+
+void Texas::FileHandle::close() noexcept
+{
+    if (m_nativeHandle == -1)
+        return;
+#if defined(_WIN32)
+    CloseHandle(reinterpret_cast<HANDLE>(m_nativeHandle));
+    if (m_directHandle != -1)
+        CloseHandle(reinterpret_cast<HANDLE>(m_directHandle));
+#else
+    ::close(static_cast<int>(m_nativeHandle));
+    if (m_directHandle != -1)
+        ::close(static_cast<int>(m_directHandle));
+#endif
+    m_nativeHandle = -1;
+    m_directHandle = -1;
+    m_size = 0;
+}
+
+bool Texas::FileHandle::isOpen() const noexcept
+{
+    return m_nativeHandle != -1;
+}
+
+bool Texas::FileHandle::hasDirectReads() const noexcept
+{
+    return m_directHandle != -1;
+}
+
+std::uint64_t Texas::FileHandle::size() const noexcept
+{
+    return m_size;
+}
+
+Texas::Result Texas::FileHandle::readAt(std::uint64_t offset, ByteSpan dst) const noexcept
+{
+    if (m_nativeHandle == -1)
+        return { ResultType::InvalidLibraryUsage, "Attempted to read from a file that is not open." };
+
+    // The OS can return fewer bytes than we asked for, so we keep going until dst is full.
+    std::size_t amountRead = 0;
+    while (amountRead < dst.size())
+    {
+        std::size_t const amountRemaining = dst.size() - amountRead;
+        std::uint64_t const readOffset = offset + amountRead;
+#if defined(_WIN32)
+        // ReadFile can only read 4 GiB at a time.
+        DWORD const amountToRead = amountRemaining > 0xFFFFFFFF ? 0xFFFFFFFF : static_cast<DWORD>(amountRemaining);
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(readOffset);
+        overlapped.OffsetHigh = static_cast<DWORD>(readOffset >> 32);
+        DWORD bytesRead = 0;
+        BOOL const success = ReadFile(
+            reinterpret_cast<HANDLE>(m_nativeHandle),
+            dst.data() + amountRead,
+            amountToRead,
+            &bytesRead,
+            &overlapped);
+        if (success == 0)
+        {
+            if (GetLastError() == ERROR_HANDLE_EOF)
+                return { ResultType::PrematureEndOfFile, "Reached premature end of file." };
+            return { ResultType::UnknownError, "The OS reported an error when reading from file." };
+        }
+#else
+        ssize_t const bytesRead = ::pread(
+            static_cast<int>(m_nativeHandle),
+            dst.data() + amountRead,
+            amountRemaining,
+            static_cast<off_t>(readOffset));
+        if (bytesRead == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            return { ResultType::UnknownError, "The OS reported an error when reading from file." };
+        }
+#endif
+        if (bytesRead == 0)
+            return { ResultType::PrematureEndOfFile, "Reached premature end of file." };
+        amountRead += static_cast<std::size_t>(bytesRead);
+    }
+
+    return { ResultType::Success, nullptr };
+}
+
+Texas::Result Texas::FileHandle::readAtVectored(std::uint64_t offset, Span<ByteSpan const> dsts) const noexcept
+{
+    if (m_nativeHandle == -1)
+        return { ResultType::InvalidLibraryUsage, "Attempted to read from a file that is not open." };
+
+#if defined(_WIN32)
+    // ReadFileScatter only works on unbuffered files with page-sized spans, so every span is its own read.
+    for (std::size_t i = 0; i < dsts.size(); i++)
+    {
+        Result const result = readAt(offset, dsts.data()[i]);
+        if (!result.isSuccessful())
+            return result;
+        offset += dsts.data()[i].size();
+    }
+#else
+    // The span we're at, and how much of it has been filled so far.
+    std::size_t dstIndex = 0;
+    std::size_t dstAmountRead = 0;
+    while (true)
+    {
+        iovec iovecs[detail::fileReadMaxIovecCount];
+        int iovecCount = 0;
+        for (std::size_t i = dstIndex; i < dsts.size() && iovecCount < detail::fileReadMaxIovecCount; i++)
+        {
+            ByteSpan const dst = dsts.data()[i];
+            std::size_t const skipAmount = i == dstIndex ? dstAmountRead : 0;
+            if (dst.size() == skipAmount)
+                continue;
+            iovecs[iovecCount].iov_base = dst.data() + skipAmount;
+            iovecs[iovecCount].iov_len = dst.size() - skipAmount;
+            iovecCount += 1;
+        }
+        if (iovecCount == 0)
+            break;
+
+        ssize_t const bytesRead = ::preadv(
+            static_cast<int>(m_nativeHandle),
+            iovecs,
+            iovecCount,
+            static_cast<off_t>(offset));
+        if (bytesRead == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            return { ResultType::UnknownError, "The OS reported an error when reading from file." };
+        }
+        if (bytesRead == 0)
+            return { ResultType::PrematureEndOfFile, "Reached premature end of file." };
+        offset += static_cast<std::uint64_t>(bytesRead);
+
+        // The OS can return fewer bytes than we asked for, so we pick up where it stopped.
+        std::size_t amountRemaining = static_cast<std::size_t>(bytesRead);
+        while (amountRemaining > 0)
+        {
+            std::size_t const dstRemaining = dsts.data()[dstIndex].size() - dstAmountRead;
+            if (amountRemaining < dstRemaining)
+            {
+                dstAmountRead += amountRemaining;
+                break;
+            }
+            amountRemaining -= dstRemaining;
+            dstIndex += 1;
+            dstAmountRead = 0;
+        }
+    }
+#endif
+
+    return { ResultType::Success, nullptr };
+}
+
+void Texas::FileHandle::hint(std::uint64_t offset, std::uint64_t length, InputStream::AccessHint access) const noexcept
+{
+    if (m_nativeHandle == -1)
+        return;
+#if defined(_WIN32)
+    (void)offset;
+    (void)length;
+    (void)access;
+#elif defined(POSIX_FADV_WILLNEED)
+    int advice = POSIX_FADV_NORMAL;
+    switch (access)
+    {
+    case InputStream::AccessHint::Sequential:
+        advice = POSIX_FADV_SEQUENTIAL;
+        break;
+    case InputStream::AccessHint::WillNeed:
+        advice = POSIX_FADV_WILLNEED;
+        break;
+    case InputStream::AccessHint::DontNeed:
+        advice = POSIX_FADV_DONTNEED;
+        break;
+    }
+    // This is only advice, so there is nothing to do if the OS turns it down.
+    (void)::posix_fadvise(
+        static_cast<int>(m_nativeHandle),
+        static_cast<off_t>(offset),
+        static_cast<off_t>(length),
+        advice);
+#else
+    // macOS has no posix_fadvise.
+    (void)offset;
+    (void)length;
+    (void)access;
+#endif
+}
+
+Texas::Result Texas::FileHandle::readAtDirect(
+    std::uint64_t offset,
+    Span<ByteSpan const> dsts,
+    ByteSpan bounceBuffer) const noexcept
+{
+    if (m_directHandle == -1)
+        return { ResultType::InvalidLibraryUsage, "Attempted a direct read from a file that was not opened with direct reads." };
+    if (reinterpret_cast<std::uintptr_t>(bounceBuffer.data()) % directReadAlignment != 0 ||
+        bounceBuffer.size() % directReadAlignment != 0 ||
+        bounceBuffer.size() == 0)
+        return { ResultType::InvalidLibraryUsage, "Bounce buffer for direct reads is not aligned to FileHandle::directReadAlignment." };
+
+    std::uint64_t totalSize = 0;
+    for (std::size_t i = 0; i < dsts.size(); i++)
+        totalSize += dsts.data()[i].size();
+    std::uint64_t const endOffset = offset + totalSize;
+    // The direct reads have to cover the unaligned start and end of the range too.
+    std::uint64_t blockOffset = offset - offset % directReadAlignment;
+    std::uint64_t const blocksEndOffset = (endOffset + directReadAlignment - 1) / directReadAlignment * directReadAlignment;
+
+    // The span we're at, and how much of it has been filled so far.
+    std::size_t dstIndex = 0;
+    std::size_t dstAmountRead = 0;
+    while (blockOffset < endOffset)
+    {
+        std::size_t blocksSize = bounceBuffer.size();
+        if (blocksSize > blocksEndOffset - blockOffset)
+            blocksSize = static_cast<std::size_t>(blocksEndOffset - blockOffset);
+
+        // The last block of the file comes back short, everything else comes back whole.
+        std::size_t amountRead = 0;
+        while (amountRead < blocksSize && amountRead % directReadAlignment == 0)
+        {
+            std::size_t const amountRemaining = blocksSize - amountRead;
+            std::uint64_t const readOffset = blockOffset + amountRead;
+#if defined(_WIN32)
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(readOffset);
+            overlapped.OffsetHigh = static_cast<DWORD>(readOffset >> 32);
+            DWORD bytesRead = 0;
+            BOOL const success = ReadFile(
+                reinterpret_cast<HANDLE>(m_directHandle),
+                bounceBuffer.data() + amountRead,
+                static_cast<DWORD>(amountRemaining),
+                &bytesRead,
+                &overlapped);
+            if (success == 0)
+            {
+                if (GetLastError() == ERROR_HANDLE_EOF)
+                    break;
+                return { ResultType::UnknownError, "The OS reported an error when reading from file." };
+            }
+#else
+            ssize_t const bytesRead = ::pread(
+                static_cast<int>(m_directHandle),
+                bounceBuffer.data() + amountRead,
+                amountRemaining,
+                static_cast<off_t>(readOffset));
+            if (bytesRead == -1)
+            {
+                if (errno == EINTR)
+                    continue;
+                return { ResultType::UnknownError, "The OS reported an error when reading from file." };
+            }
+#endif
+            if (bytesRead == 0)
+                break;
+            amountRead += static_cast<std::size_t>(bytesRead);
+        }
+
+        // Copy the part of the blocks that is inside the range into the spans.
+        std::size_t const skipAmount = blockOffset < offset ? static_cast<std::size_t>(offset - blockOffset) : 0;
+        std::size_t usefulEnd = blocksSize;
+        if (blockOffset + usefulEnd > endOffset)
+            usefulEnd = static_cast<std::size_t>(endOffset - blockOffset);
+        if (amountRead < usefulEnd)
+            return { ResultType::PrematureEndOfFile, "Reached premature end of file." };
+        std::size_t copyOffset = skipAmount;
+        while (copyOffset < usefulEnd)
+        {
+            ByteSpan const dst = dsts.data()[dstIndex];
+            std::size_t amountToCopy = dst.size() - dstAmountRead;
+            if (amountToCopy > usefulEnd - copyOffset)
+                amountToCopy = usefulEnd - copyOffset;
+            if (amountToCopy > 0)
+                std::memcpy(dst.data() + dstAmountRead, bounceBuffer.data() + copyOffset, amountToCopy);
+            copyOffset += amountToCopy;
+            dstAmountRead += amountToCopy;
+            if (dstAmountRead == dst.size())
+            {
+                dstIndex += 1;
+                dstAmountRead = 0;
+            }
+        }
+
+        blockOffset += blocksSize;
+    }
+
+    return { ResultType::Success, nullptr };
+}
+
+Texas::FileStream::FileStream(FileHandle const& file, std::uint64_t startOffset) noexcept :
+    m_file(&file),
+    m_offset(startOffset)
+{
+}
+
+Texas::Result Texas::FileStream::read(ByteSpan dst) noexcept
+{
+    if (m_file == nullptr)
+        return { ResultType::InvalidLibraryUsage, "Attempted to read from a FileStream without a file." };
+    if (useDirectRead(dst.size()))
+        return readDirect({ &dst, 1 }, dst.size());
+    Result const result = m_file->readAt(m_offset, dst);
+    if (!result.isSuccessful())
+        return result;
+    m_offset += dst.size();
+    return { ResultType::Success, nullptr };
+}
+
+Texas::Result Texas::FileStream::readVectored(Span<ByteSpan const> dsts) noexcept
+{
+    if (m_file == nullptr)
+        return { ResultType::InvalidLibraryUsage, "Attempted to read from a FileStream without a file." };
+    std::size_t totalSize = 0;
+    for (std::size_t i = 0; i < dsts.size(); i++)
+        totalSize += dsts.data()[i].size();
+    if (useDirectRead(totalSize))
+        return readDirect(dsts, totalSize);
+    Result const result = m_file->readAtVectored(m_offset, dsts);
+    if (!result.isSuccessful())
+        return result;
+    m_offset += totalSize;
+    return { ResultType::Success, nullptr };
+}
+
+void Texas::FileStream::ignore(std::size_t amount) noexcept
+{
+    m_offset += amount;
+}
+
+std::size_t Texas::FileStream::tell() noexcept
+{
+    return static_cast<std::size_t>(m_offset);
+}
+
+void Texas::FileStream::seek(std::size_t pos) noexcept
+{
+    m_offset = pos;
+}
+
+std::size_t Texas::FileStream::size() noexcept
+{
+    if (m_file == nullptr)
+        return unknownSize;
+    if constexpr (sizeof(std::uint64_t) > sizeof(std::size_t))
+    {
+        // Positions past this can't be represented by the InputStream interface.
+        if (m_file->size() > static_cast<std::size_t>(-1))
+            return unknownSize;
+    }
+    return static_cast<std::size_t>(m_file->size());
+}
+
+void Texas::FileStream::hint(std::size_t pos, std::size_t length, AccessHint access) noexcept
+{
+    if (m_file == nullptr)
+        return;
+    if (access == AccessHint::DontNeed && !m_dropConsumedPages)
+        return;
+    m_file->hint(pos, length, access);
+}
+
+void Texas::FileStream::setDropConsumedPages(bool enabled) noexcept
+{
+    m_dropConsumedPages = enabled;
+}
+
+void Texas::FileStream::enableDirectReads(Allocator& allocator, std::size_t minReadSize) noexcept
+{
+    m_directReadAllocator = &allocator;
+    m_minDirectReadSize = minReadSize;
+}
+
+bool Texas::FileStream::useDirectRead(std::size_t readSize) const noexcept
+{
+    return m_directReadAllocator != nullptr && readSize >= m_minDirectReadSize && m_file->hasDirectReads();
+}
+
+Texas::Result Texas::FileStream::readDirect(Span<ByteSpan const> dsts, std::size_t totalSize) noexcept
+{
+    constexpr std::size_t alignment = FileHandle::directReadAlignment;
+    // Room for the whole read, including the unaligned blocks at either end.
+    std::size_t bounceBufferSize = (totalSize + 2 * alignment - 1) / alignment * alignment;
+    if (bounceBufferSize > maxDirectReadBufferSize)
+        bounceBufferSize = maxDirectReadBufferSize;
+    std::byte* const bounceBuffer = m_directReadAllocator->allocateAligned(
+        bounceBufferSize,
+        alignment,
+        Allocator::MemoryType::WorkingData);
+    if (bounceBuffer == nullptr)
+        return { ResultType::InvalidLibraryUsage, "Allocator returned nullptr when attempting to allocate working-memory." };
+
+    Result const result = m_file->readAtDirect(m_offset, dsts, { bounceBuffer, bounceBufferSize });
+    m_directReadAllocator->deallocateAligned(bounceBuffer, alignment, Allocator::MemoryType::WorkingData);
+    if (!result.isSuccessful())
+        return result;
+    m_offset += totalSize;
+    return { ResultType::Success, nullptr };
+}
@@ -0,0 +1,447 @@
+#include "Texas/IncrementalDecoder.hpp"
+
+#include "PrivateAccessor.hpp"
+
+#include "Texas/Tools.hpp"
+
+#if defined(TEXAS_ENABLE_KTX_READ)
+#   include "KTX.hpp"
+#endif
+
+#if defined(TEXAS_ENABLE_PNG_READ)
+#   include "PNG.hpp"
+#   include "Inflate.hpp"
+#endif
+
+// For std::memcpy
+#include <cstring>
+#include <new>
+
+namespace Texas::detail
+{
+    /*
+        Reads from the bytes an IncrementalDecoder has been fed so far,
+        so that the regular parsers can be used on them.
+        Remembers how far into the file the parser tried to read.
+    */
+    class FedBytesStream : public InputStream
+    {
+    public:
+        explicit FedBytesStream(ConstByteSpan data) noexcept :
+            m_data(data)
+        {
+        }
+
+        [[nodiscard]] virtual Result read(ByteSpan dst) noexcept override
+        {
+            std::size_t const end = m_pos + dst.size();
+            if (end > m_streamPosRequired)
+                m_streamPosRequired = end;
+            if (end > m_data.size())
+                return { ResultType::PrematureEndOfFile, "Not enough of the file has been fed to parse it." };
+            std::memcpy(dst.data(), m_data.data() + m_pos, dst.size());
+            m_pos = end;
+            return { ResultType::Success, nullptr };
+        }
+
+        virtual void ignore(std::size_t amount) noexcept override
+        {
+            m_pos += amount;
+        }
+
+        [[nodiscard]] virtual std::size_t tell() noexcept override
+        {
+            return m_pos;
+        }
+
+        virtual void seek(std::size_t pos) noexcept override
+        {
+            m_pos = pos;
+        }
+
+        // The amount of bytes the parser needed to get further than it did.
+        [[nodiscard]] std::size_t streamPosRequired() const noexcept
+        {
+            return m_streamPosRequired;
+        }
+
+    private:
+        ConstByteSpan m_data = {};
+        std::size_t m_pos = 0;
+        std::size_t m_streamPosRequired = 0;
+    };
+}
+
+Texas::IncrementalDecoder::IncrementalDecoder(Allocator& allocator) noexcept :
+    m_allocator(&allocator)
+{
+}
+
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+Texas::IncrementalDecoder::IncrementalDecoder() noexcept = default;
+#endif
+
+Texas::IncrementalDecoder::IncrementalDecoder(IncrementalDecoder&& other) noexcept :
+    m_allocator(other.m_allocator),
+    m_buffer(other.m_buffer),
+    m_bufferSize(other.m_bufferSize),
+    m_streamPos(other.m_streamPos),
+    m_parseStreamPosRequired(other.m_parseStreamPosRequired),
+    m_imageDataStreamPos(other.m_imageDataStreamPos),
+    m_hasFileInfo(other.m_hasFileInfo),
+    m_fileInfo(other.m_fileInfo),
+    m_dstBuffer(other.m_dstBuffer),
+    m_workingMem(other.m_workingMem),
+    m_inflateContext(other.m_inflateContext),
+    m_backendData(other.m_backendData),
+    m_error(other.m_error)
+{
+    other.m_buffer = {};
+    other.m_workingMem = {};
+    other.m_inflateContext = nullptr;
+    other.reset();
+}
+
+Texas::IncrementalDecoder& Texas::IncrementalDecoder::operator=(IncrementalDecoder&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    releaseMemory();
+    m_allocator = other.m_allocator;
+    m_buffer = other.m_buffer;
+    m_bufferSize = other.m_bufferSize;
+    m_streamPos = other.m_streamPos;
+    m_parseStreamPosRequired = other.m_parseStreamPosRequired;
+    m_imageDataStreamPos = other.m_imageDataStreamPos;
+    m_hasFileInfo = other.m_hasFileInfo;
+    m_fileInfo = other.m_fileInfo;
+    m_dstBuffer = other.m_dstBuffer;
+    m_workingMem = other.m_workingMem;
+    m_inflateContext = other.m_inflateContext;
+    m_backendData = other.m_backendData;
+    m_error = other.m_error;
+    other.m_buffer = {};
+    other.m_workingMem = {};
+    other.m_inflateContext = nullptr;
+    other.reset();
+
+    return *this;
+}
+
+Texas::IncrementalDecoder::~IncrementalDecoder()
+{
+    releaseMemory();
+}
+
+Texas::Result Texas::IncrementalDecoder::feed(ConstByteSpan data) noexcept
+{
+    if (!m_error.isSuccessful())
+        return m_error;
+
+    Result result{};
+    if (m_dstBuffer.data() != nullptr)
+        result = detail::PrivateAccessor::decodeIncremental(*this, data);
+    else
+    {
+        // Nowhere to put the image-data yet, so we hold on to the bytes.
+        result = reserveBuffer(m_bufferSize + data.size());
+        if (result.isSuccessful())
+        {
+            std::memcpy(m_buffer.data() + m_bufferSize, data.data(), data.size());
+            m_bufferSize += data.size();
+            m_streamPos += data.size();
+            if (!m_hasFileInfo && m_streamPos >= m_parseStreamPosRequired)
+                result = detail::PrivateAccessor::parseIncremental(*this);
+        }
+    }
+
+    if (!result.isSuccessful())
+        m_error = result;
+    return result;
+}
+
+bool Texas::IncrementalDecoder::hasFileInfo() const noexcept
+{
+    return m_hasFileInfo;
+}
+
+Texas::FileInfo const& Texas::IncrementalDecoder::fileInfo() const noexcept
+{
+    return m_fileInfo;
+}
+
+Texas::Result Texas::IncrementalDecoder::setDstBuffer(ByteSpan dstBuffer) noexcept
+{
+    if (!m_error.isSuccessful())
+        return m_error;
+    if (!m_hasFileInfo)
+        return { ResultType::InvalidLibraryUsage, "The destination buffer can't be set before the file has been parsed." };
+    if (m_dstBuffer.data() != nullptr)
+        return { ResultType::InvalidLibraryUsage, "The destination buffer has already been set for this file." };
+    if (dstBuffer.data() == nullptr)
+        return { ResultType::InvalidLibraryUsage, "You need to send in a destination buffer." };
+    if (dstBuffer.size() < m_fileInfo.memoryRequired())
+        return { ResultType::InvalidLibraryUsage,
+                 "Destination buffer is not large enough to hold the image-data. "
+                 "Query FileInfo::memoryRequired() for the minimum size." };
+
+    Result result = detail::PrivateAccessor::beginIncremental(*this);
+    if (result.isSuccessful())
+    {
+        m_dstBuffer = dstBuffer;
+        // Decode everything that was held on to, starting over from the start of the file
+        // so that decodeIncremental skips everything before the image-data.
+        m_streamPos = 0;
+        result = detail::PrivateAccessor::decodeIncremental(*this, { m_buffer.data(), m_bufferSize });
+        m_bufferSize = 0;
+    }
+
+    if (!result.isSuccessful())
+        m_error = result;
+    return result;
+}
+
+std::uint8_t Texas::IncrementalDecoder::mipsReady() const noexcept
+{
+    if (m_dstBuffer.data() == nullptr)
+        return 0;
+    switch (m_fileInfo.textureInfo().fileFormat)
+    {
+#if defined(TEXAS_ENABLE_KTX_READ)
+    case FileFormat::KTX:
+        return m_backendData.ktx.mipsReady;
+#endif
+#if defined(TEXAS_ENABLE_PNG_READ)
+    case FileFormat::PNG:
+        return m_backendData.png.section == detail::IncrementalDecoder_PNG_BackendData::Section::Done ? 1 : 0;
+#endif
+    default:
+        return 0;
+    }
+}
+
+std::uint64_t Texas::IncrementalDecoder::rowsReady() const noexcept
+{
+    if (m_dstBuffer.data() == nullptr || isDone())
+        return 0;
+    switch (m_fileInfo.textureInfo().fileFormat)
+    {
+#if defined(TEXAS_ENABLE_KTX_READ)
+    case FileFormat::KTX:
+    {
+        TextureInfo const& textureInfo = m_fileInfo.textureInfo();
+        Dimensions const mipDims = calculateMipDimensions(textureInfo.baseDimensions, m_backendData.ktx.mipsReady);
+        return m_backendData.ktx.mipBytesWritten / calculateRowSize(mipDims, textureInfo.pixelFormat);
+    }
+#endif
+#if defined(TEXAS_ENABLE_PNG_READ)
+    case FileFormat::PNG:
+        return m_backendData.png.rowsReady;
+#endif
+    default:
+        return 0;
+    }
+}
+
+bool Texas::IncrementalDecoder::isDone() const noexcept
+{
+    return m_hasFileInfo && mipsReady() == m_fileInfo.textureInfo().mipCount;
+}
+
+void Texas::IncrementalDecoder::reset() noexcept
+{
+    m_bufferSize = 0;
+    m_streamPos = 0;
+    m_parseStreamPosRequired = 0;
+    m_imageDataStreamPos = 0;
+    m_hasFileInfo = false;
+    m_fileInfo = {};
+    m_dstBuffer = {};
+    m_backendData = {};
+    m_error = { ResultType::Success, nullptr };
+}
+
+void Texas::IncrementalDecoder::releaseMemory() noexcept
+{
+    reset();
+
+    if (m_buffer.data() != nullptr)
+        deallocateWorkingMemory(m_buffer.data());
+    m_buffer = {};
+    if (m_workingMem.data() != nullptr)
+        deallocateWorkingMemory(m_workingMem.data());
+    m_workingMem = {};
+
+#if defined(TEXAS_ENABLE_PNG_READ)
+    if (m_inflateContext != nullptr)
+    {
+        m_inflateContext->~InflateContext();
+        deallocateWorkingMemory(reinterpret_cast<std::byte*>(m_inflateContext));
+        m_inflateContext = nullptr;
+    }
+#endif
+}
+
+Texas::Result Texas::IncrementalDecoder::reserveBuffer(std::size_t size) noexcept
+{
+    if (size <= m_buffer.size())
+        return { ResultType::Success, nullptr };
+
+    // Grow geometrically so feeding many small pieces doesn't reallocate every time.
+    std::size_t newSize = m_buffer.size() * 2;
+    if (newSize < size)
+        newSize = size;
+
+    std::byte* const mem = allocateWorkingMemory(newSize);
+    if (mem == nullptr)
+        return { ResultType::InvalidLibraryUsage, "Allocator returned nullptr when attempting to allocate working-memory." };
+    if (m_buffer.data() != nullptr)
+    {
+        std::memcpy(mem, m_buffer.data(), m_bufferSize);
+        deallocateWorkingMemory(m_buffer.data());
+    }
+    m_buffer = { mem, newSize };
+    return { ResultType::Success, nullptr };
+}
+
+std::byte* Texas::IncrementalDecoder::allocateWorkingMemory(std::size_t size) noexcept
+{
+    if (m_allocator != nullptr)
+        return m_allocator->allocate(size, Allocator::MemoryType::WorkingData);
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+    return new(std::nothrow) std::byte[size];
+#else
+    // This path should never be reached!
+    return nullptr;
+#endif
+}
+
+void Texas::IncrementalDecoder::deallocateWorkingMemory(std::byte* ptr) noexcept
+{
+    if (m_allocator != nullptr)
+    {
+        m_allocator->deallocate(ptr, Allocator::MemoryType::WorkingData);
+        return;
+    }
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+    delete[] ptr;
+#endif
+}
+
+Texas::Result Texas::detail::PrivateAccessor::parseIncremental(IncrementalDecoder& decoder) noexcept
+{
+    FedBytesStream stream({ decoder.m_buffer.data(), decoder.m_bufferSize });
+    ResultValue<FileInfo> parseResult = parseStream(stream, true);
+    if (!parseResult.isSuccessful())
+    {
+        // Wait until the parser can get further than it did this time.
+        if (parseResult.resultType() == ResultType::PrematureEndOfFile)
+        {
+            decoder.m_parseStreamPosRequired = stream.streamPosRequired();
+            return { ResultType::Success, nullptr };
+        }
+        return parseResult.toResult();
+    }
+
+    decoder.m_fileInfo = parseResult.value();
+    decoder.m_hasFileInfo = true;
+    // The parser stops right where the image-data starts.
+    decoder.m_imageDataStreamPos = stream.tell();
+    return { ResultType::Success, nullptr };
+}
+
+Texas::Result Texas::detail::PrivateAccessor::beginIncremental(IncrementalDecoder& decoder) noexcept
+{
+    FileInfo const& file = decoder.m_fileInfo;
+    switch (file.m_textureInfo.fileFormat)
+    {
+#if defined(TEXAS_ENABLE_KTX_READ)
+    case FileFormat::KTX:
+        decoder.m_backendData.ktx = {};
+        return KTX::beginIncremental(decoder.m_backendData.ktx, file.m_textureInfo);
+#endif
+#if defined(TEXAS_ENABLE_PNG_READ)
+    case FileFormat::PNG:
+    {
+        std::uint64_t const workingMemRequired = PNG::calcWorkingMemRequired_Incremental(
+            file.m_textureInfo,
+            file.m_backendData.png);
+        if constexpr (sizeof(std::uint64_t) > sizeof(std::size_t))
+        {
+            if (workingMemRequired > static_cast<std::size_t>(-1))
+                return { ResultType::FileNotSupported,
+                         "Texture requires more working memory than the system can possibly allocate." };
+        }
+        if (decoder.m_workingMem.size() < workingMemRequired)
+        {
+            if (decoder.m_workingMem.data() != nullptr)
+                decoder.deallocateWorkingMemory(decoder.m_workingMem.data());
+            decoder.m_workingMem = {};
+            std::byte* const mem = decoder.allocateWorkingMemory(static_cast<std::size_t>(workingMemRequired));
+            if (mem == nullptr)
+                return { ResultType::InvalidLibraryUsage, "Allocator returned nullptr when attempting to allocate working-memory." };
+            decoder.m_workingMem = { mem, static_cast<std::size_t>(workingMemRequired) };
+        }
+        if (decoder.m_inflateContext == nullptr)
+        {
+            std::byte* const mem = decoder.allocateWorkingMemory(sizeof(InflateContext));
+            if (mem == nullptr)
+                return { ResultType::InvalidLibraryUsage, "Allocator returned nullptr when attempting to allocate working-memory." };
+            decoder.m_inflateContext = new(mem) InflateContext(decoder.m_allocator);
+        }
+
+        decoder.m_backendData.png = {};
+        return PNG::beginIncremental(
+            decoder.m_backendData.png,
+            *decoder.m_inflateContext,
+            file.m_backendData.png,
+            decoder.m_workingMem);
+    }
+#endif
+    default:
+        break;
+    }
+
+    return { ResultType::InvalidLibraryUsage, "Passed in an invalid FileInfo object." };
+}
+
+Texas::Result Texas::detail::PrivateAccessor::decodeIncremental(IncrementalDecoder& decoder, ConstByteSpan data) noexcept
+{
+    // Skip what's left before the image-data, such as KTX key-value data.
+    std::size_t skipAmount = 0;
+    if (decoder.m_streamPos < decoder.m_imageDataStreamPos)
+        skipAmount = decoder.m_imageDataStreamPos - decoder.m_streamPos;
+    if (skipAmount > data.size())
+        skipAmount = data.size();
+    decoder.m_streamPos += data.size();
+    ConstByteSpan const imageData = { data.data() + skipAmount, data.size() - skipAmount };
+    if (imageData.size() == 0)
+        return { ResultType::Success, nullptr };
+
+    FileInfo const& file = decoder.m_fileInfo;
+    switch (file.m_textureInfo.fileFormat)
+    {
+#if defined(TEXAS_ENABLE_KTX_READ)
+    case FileFormat::KTX:
+        return KTX::decodeIncremental(
+            decoder.m_backendData.ktx,
+            file.m_textureInfo,
+            decoder.m_dstBuffer,
+            imageData);
+#endif
+#if defined(TEXAS_ENABLE_PNG_READ)
+    case FileFormat::PNG:
+        return PNG::decodeIncremental(
+            decoder.m_backendData.png,
+            file.m_textureInfo,
+            file.m_backendData.png,
+            decoder.m_dstBuffer,
+            imageData);
+#endif
+    default:
+        break;
+    }
+
+    return { ResultType::InvalidLibraryUsage, "Passed in an invalid FileInfo object." };
+}
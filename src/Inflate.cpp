@@ -0,0 +1,66 @@
+#include "Inflate.hpp"
+
+namespace Texas::detail
+{
+    static voidpf zLibAllocate(voidpf opaque, uInt items, uInt size)
+    {
+        Allocator* const allocator = static_cast<Allocator*>(opaque);
+        return allocator->allocate(static_cast<std::size_t>(items) * size, Allocator::MemoryType::WorkingData);
+    }
+
+    static void zLibDeallocate(voidpf opaque, voidpf address)
+    {
+        Allocator* const allocator = static_cast<Allocator*>(opaque);
+        allocator->deallocate(static_cast<std::byte*>(address), Allocator::MemoryType::WorkingData);
+    }
+}
+
+Texas::detail::InflateContext::InflateContext(Allocator* allocator) noexcept :
+    m_allocator(allocator)
+{
+}
+
+Texas::detail::InflateContext::~InflateContext()
+{
+    if (m_initialized)
+        inflateEnd(&m_stream);
+}
+
+Texas::Result Texas::detail::InflateContext::begin() noexcept
+{
+    if (m_initialized)
+    {
+        if (inflateReset(&m_stream) == Z_OK)
+        {
+            m_stream.next_in = nullptr;
+            m_stream.avail_in = 0;
+            m_stream.next_out = nullptr;
+            m_stream.avail_out = 0;
+            return { ResultType::Success, nullptr };
+        }
+        // The stream is in a bad state, so we start over.
+        inflateEnd(&m_stream);
+        m_initialized = false;
+    }
+
+    m_stream = z_stream{};
+    if (m_allocator != nullptr)
+    {
+        m_stream.zalloc = &zLibAllocate;
+        m_stream.zfree = &zLibDeallocate;
+        m_stream.opaque = m_allocator;
+    }
+    int const initErr = inflateInit(&m_stream);
+    if (initErr != Z_OK)
+    {
+        inflateEnd(&m_stream);
+        return { ResultType::CorruptFileData, "During PNG decompression, zLib failed to initialize the decompression job." };
+    }
+    m_initialized = true;
+    return { ResultType::Success, nullptr };
+}
+
+z_stream& Texas::detail::InflateContext::stream() noexcept
+{
+    return m_stream;
+}
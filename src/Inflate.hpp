@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Texas/Allocator.hpp"
+#include "Texas/Result.hpp"
+
+#include "zlib/zlib.h"
+
+namespace Texas::detail
+{
+    /*
+        A zLib inflate stream that can be reused for many decompression jobs.
+
+        The first job initializes the stream and every job after that only resets it,
+        so zLib's internal state and sliding window are only allocated once.
+        If an allocator is supplied, zLib's allocations go through it as working-memory.
+    */
+    class InflateContext
+    {
+    public:
+        InflateContext() noexcept = default;
+        explicit InflateContext(Allocator* allocator) noexcept;
+        InflateContext(InflateContext const&) = delete;
+        InflateContext(InflateContext&&) = delete;
+        InflateContext& operator=(InflateContext const&) = delete;
+        InflateContext& operator=(InflateContext&&) = delete;
+        ~InflateContext();
+
+        /*
+            Prepares the stream for decompressing a new zLib data-stream.
+        */
+        [[nodiscard]] Result begin() noexcept;
+
+        [[nodiscard]] z_stream& stream() noexcept;
+
+    private:
+        z_stream m_stream{};
+        Allocator* m_allocator = nullptr;
+        bool m_initialized = false;
+    };
+}
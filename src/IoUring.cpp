@@ -0,0 +1,227 @@
+#include "IoUring.hpp"
+
+#include <linux/io_uring.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+// For std::memset
+#include <cstring>
+
+namespace Texas::detail
+{
+    // How often submitAndWait() retries when the kernel is out of resources and there's nothing to wait for.
+    constexpr std::uint32_t maxBusyRetries = 64;
+
+    [[nodiscard]] static int ioUringSetup(std::uint32_t entryCount, io_uring_params* params) noexcept
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_setup, entryCount, params));
+    }
+
+    [[nodiscard]] static int ioUringEnter(
+        int ringFd,
+        std::uint32_t submitCount,
+        std::uint32_t minCompletions,
+        std::uint32_t flags) noexcept
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, submitCount, minCompletions, flags, nullptr, 0));
+    }
+
+    // The kernel reads and writes the ring indices from the other side,
+    // so they need the same ordering guarantees as atomics.
+    [[nodiscard]] static std::uint32_t loadAcquire(std::uint32_t const* ptr) noexcept
+    {
+        return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+    }
+
+    static void storeRelease(std::uint32_t* ptr, std::uint32_t value) noexcept
+    {
+        __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+    }
+
+    template<typename T>
+    [[nodiscard]] static T* ringMember(void* ring, std::uint32_t offset) noexcept
+    {
+        return reinterpret_cast<T*>(static_cast<std::byte*>(ring) + offset);
+    }
+}
+
+Texas::detail::IoUring::~IoUring()
+{
+    if (m_sqes != nullptr)
+        ::munmap(m_sqes, m_sqesSize);
+    if (m_cqRing != nullptr && m_cqRing != m_sqRing)
+        ::munmap(m_cqRing, m_cqRingSize);
+    if (m_sqRing != nullptr)
+        ::munmap(m_sqRing, m_sqRingSize);
+    if (m_ringFd != -1)
+        ::close(m_ringFd);
+}
+
+bool Texas::detail::IoUring::init(std::uint32_t entryCount) noexcept
+{
+    io_uring_params params{};
+    int const ringFd = ioUringSetup(entryCount, &params);
+    if (ringFd < 0)
+        return false;
+    m_ringFd = ringFd;
+
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    // Newer kernels let both rings share a single mapping.
+    bool const singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMapping && m_cqRingSize > m_sqRingSize)
+        m_sqRingSize = m_cqRingSize;
+
+    void* const sqRing = ::mmap(
+        nullptr,
+        m_sqRingSize,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        m_ringFd,
+        IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED)
+        return false;
+    m_sqRing = sqRing;
+
+    if (singleMapping)
+        m_cqRing = m_sqRing;
+    else
+    {
+        void* const cqRing = ::mmap(
+            nullptr,
+            m_cqRingSize,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            m_ringFd,
+            IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED)
+            return false;
+        m_cqRing = cqRing;
+    }
+
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* const sqes = ::mmap(
+        nullptr,
+        m_sqesSize,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        m_ringFd,
+        IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+        return false;
+    m_sqes = sqes;
+
+    m_sqHead = ringMember<std::uint32_t>(m_sqRing, params.sq_off.head);
+    m_sqTail = ringMember<std::uint32_t>(m_sqRing, params.sq_off.tail);
+    m_sqRingMask = *ringMember<std::uint32_t>(m_sqRing, params.sq_off.ring_mask);
+    m_sqEntryCount = params.sq_entries;
+    m_sqArray = ringMember<std::uint32_t>(m_sqRing, params.sq_off.array);
+    m_cqHead = ringMember<std::uint32_t>(m_cqRing, params.cq_off.head);
+    m_cqTail = ringMember<std::uint32_t>(m_cqRing, params.cq_off.tail);
+    m_cqRingMask = *ringMember<std::uint32_t>(m_cqRing, params.cq_off.ring_mask);
+    m_cqes = ringMember<void>(m_cqRing, params.cq_off.cqes);
+
+    return true;
+}
+
+bool Texas::detail::IoUring::queueRead(
+    int fd,
+    std::uint64_t offset,
+    std::byte* dst,
+    std::uint32_t size,
+    std::uint64_t userData) noexcept
+{
+    // We are the only ones writing the tail, so it does not need to be synchronized.
+    std::uint32_t const tail = *m_sqTail;
+    if (tail - loadAcquire(m_sqHead) >= m_sqEntryCount)
+        return false;
+
+    std::uint32_t const index = tail & m_sqRingMask;
+    io_uring_sqe* const sqe = static_cast<io_uring_sqe*>(m_sqes) + index;
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->off = offset;
+    sqe->addr = reinterpret_cast<std::uint64_t>(dst);
+    sqe->len = size;
+    sqe->user_data = userData;
+    m_sqArray[index] = index;
+    storeRelease(m_sqTail, tail + 1);
+    m_queuedCount++;
+
+    return true;
+}
+
+bool Texas::detail::IoUring::submitAndWait(std::uint32_t minCompletions) noexcept
+{
+    std::uint32_t busyRetries = 0;
+    while (true)
+    {
+        std::uint32_t const flags = minCompletions > 0 ? IORING_ENTER_GETEVENTS : 0;
+        int const result = ioUringEnter(m_ringFd, m_queuedCount, minCompletions, flags);
+        if (result >= 0)
+        {
+            m_queuedCount -= static_cast<std::uint32_t>(result);
+            m_inFlightCount += static_cast<std::uint32_t>(result);
+            return true;
+        }
+        if (errno == EINTR)
+            continue;
+        if (errno != EAGAIN && errno != EBUSY)
+            return false;
+
+        // Both clear up as reads complete and their completions are popped.
+        if (*m_cqHead != loadAcquire(m_cqTail))
+            return true;
+        if (m_inFlightCount > 0)
+        {
+            // Only wait this time, the queued reads are handed over on the next call.
+            while (ioUringEnter(m_ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0)
+            {
+                if (errno != EINTR)
+                    return false;
+            }
+            return true;
+        }
+
+        // Nothing in flight to wait for, so the kernel is briefly out of memory.
+        if (busyRetries >= maxBusyRetries)
+            return false;
+        busyRetries++;
+        ::sched_yield();
+    }
+}
+
+bool Texas::detail::IoUring::unqueueRead(std::uint64_t& userData) noexcept
+{
+    if (m_queuedCount == 0)
+        return false;
+
+    // The kernel only looks at the queue inside io_uring_enter, so moving the tail back is safe.
+    std::uint32_t const tail = *m_sqTail - 1;
+    io_uring_sqe const& sqe = static_cast<io_uring_sqe const*>(m_sqes)[tail & m_sqRingMask];
+    userData = sqe.user_data;
+    storeRelease(m_sqTail, tail);
+    m_queuedCount--;
+
+    return true;
+}
+
+bool Texas::detail::IoUring::popCompletion(std::uint64_t& userData, std::int32_t& result) noexcept
+{
+    // We are the only ones writing the head, so it does not need to be synchronized.
+    std::uint32_t const head = *m_cqHead;
+    if (head == loadAcquire(m_cqTail))
+        return false;
+
+    io_uring_cqe const& cqe = static_cast<io_uring_cqe const*>(m_cqes)[head & m_cqRingMask];
+    userData = cqe.user_data;
+    result = cqe.res;
+    storeRelease(m_cqHead, head + 1);
+    m_inFlightCount--;
+
+    return true;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Texas::detail
+{
+    /*
+        A Linux io_uring instance that can only read from files.
+
+        It's set up with raw system calls, so Texas does not depend on liburing.
+        Reads are queued up with queueRead() and handed to the kernel all at once
+        by submitAndWait(), so many reads can be in flight with a single system call.
+    */
+    class IoUring
+    {
+    public:
+        IoUring() noexcept = default;
+        IoUring(IoUring const&) = delete;
+        IoUring(IoUring&&) = delete;
+        IoUring& operator=(IoUring const&) = delete;
+        IoUring& operator=(IoUring&&) = delete;
+        ~IoUring();
+
+        /*
+            Creates the ring with room for atleast entryCount reads in flight.
+            Returns false if the kernel does not support io_uring, or if it has been blocked.
+        */
+        [[nodiscard]] bool init(std::uint32_t entryCount) noexcept;
+
+        /*
+            Queues a read of size bytes at offset in the file fd into dst.
+            userData is handed back with the completion of the read.
+            Returns false if the submission queue is full.
+        */
+        [[nodiscard]] bool queueRead(
+            int fd,
+            std::uint64_t offset,
+            std::byte* dst,
+            std::uint32_t size,
+            std::uint64_t userData) noexcept;
+
+        /*
+            Hands every queued read to the kernel, then waits until
+            atleast minCompletions reads have completed.
+
+            If the kernel is short on resources or its completion queue is full,
+            the reads stay queued and we return once there are completions to pop instead.
+            They are handed over by the next call.
+            Returns false if the kernel reported an error.
+        */
+        [[nodiscard]] bool submitAndWait(std::uint32_t minCompletions) noexcept;
+
+        /*
+            Takes back the most recently queued read that has not been handed to the kernel yet.
+            Reads that have been handed over can't be taken back, they have to be waited for.
+            Returns false if there are no queued reads left.
+        */
+        [[nodiscard]] bool unqueueRead(std::uint64_t& userData) noexcept;
+
+        /*
+            Takes the next completed read. result is the amount of bytes read, or a negated errno value.
+            Returns false if there are no completed reads waiting.
+        */
+        [[nodiscard]] bool popCompletion(std::uint64_t& userData, std::int32_t& result) noexcept;
+
+    private:
+        int m_ringFd = -1;
+
+        void* m_sqRing = nullptr;
+        std::size_t m_sqRingSize = 0;
+        void* m_cqRing = nullptr;
+        std::size_t m_cqRingSize = 0;
+        void* m_sqes = nullptr;
+        std::size_t m_sqesSize = 0;
+
+        std::uint32_t* m_sqHead = nullptr;
+        std::uint32_t* m_sqTail = nullptr;
+        std::uint32_t m_sqRingMask = 0;
+        std::uint32_t m_sqEntryCount = 0;
+        std::uint32_t* m_sqArray = nullptr;
+        std::uint32_t* m_cqHead = nullptr;
+        std::uint32_t* m_cqTail = nullptr;
+        std::uint32_t m_cqRingMask = 0;
+        void* m_cqes = nullptr;
+
+        // Reads that have been queued, but not handed to the kernel yet.
+        std::uint32_t m_queuedCount = 0;
+        // Reads the kernel has, whose completions have not been popped yet.
+        std::uint32_t m_inFlightCount = 0;
+    };
+}
@@ -1,11 +1,17 @@
 #pragma once
 
 #include "Texas/InputStream.hpp"
+#include "Texas/MemoryInputStream.hpp"
 #include "Texas/ResultValue.hpp"
 #include "Texas/Result.hpp"
 #include "Texas/TextureInfo.hpp"
 #include "Texas/Span.hpp"
 #include "Texas/FileInfo.hpp"
+#include "Texas/ImageDataLayout.hpp"
+#include "Texas/ImageDataRange.hpp"
+#include "Texas/Tools.hpp"
+
+#include "Texas/detail/IncrementalDecoder_BackendData.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -14,16 +20,96 @@ namespace Texas::detail::KTX
 {
     constexpr std::uint8_t identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
 
+    /*
+        fileStart holds the first bytes of the file, which have already been read
+        from the stream to identify the file-format. Can not be larger than the KTX header.
+    */
+    template<typename StreamT>
     [[nodiscard]] Result loadFromStream(
-        InputStream& stream,
-        TextureInfo& textureInfo);
+        StreamT& stream,
+        TextureInfo& textureInfo,
+        FileInfo_KTX_BackendData& backendData,
+        ConstByteSpan fileStart);
 
+    template<typename StreamT>
     [[nodiscard]] Result loadImageData(
-        InputStream& stream,
+        StreamT& stream,
         ByteSpan dstBuffer,
         TextureInfo const& textureInfo,
         FileInfo_KTX_BackendData const& backendData);
 
+    /*
+        Loads the mip levels and array layers in range into dstBuffer, where each mip level, 
+        array layer, depth slice and row is placed as described by dstLayout.
+        Layer indices in dstLayout are relative to range.baseLayer.
+        The range and layout must already have been validated against textureInfo and dstBuffer.
+
+        Mip levels before the range are skipped over, and nothing after the range is read.
+    */
+    template<typename StreamT>
+    [[nodiscard]] Result loadImageData(
+        StreamT& stream,
+        ByteSpan dstBuffer,
+        ImageDataLayout const& dstLayout,
+        ImageDataRange const& range,
+        TextureInfo const& textureInfo,
+        FileInfo_KTX_BackendData const& backendData);
+
+    /*
+        Gets state ready to decode image-data that is pushed in as it arrives.
+        The first byte passed to decodeIncremental must be the first 'imageSize' field.
+    */
+    [[nodiscard]] Result beginIncremental(
+        IncrementalDecoder_KTX_BackendData& state,
+        TextureInfo const& textureInfo) noexcept;
+
+    /*
+        Copies the image-data in the next piece of the file to dstBuffer, tightly packed.
+        Bytes after the last mip level are ignored.
+    */
+    [[nodiscard]] Result decodeIncremental(
+        IncrementalDecoder_KTX_BackendData& state,
+        TextureInfo const& textureInfo,
+        ByteSpan dstBuffer,
+        ConstByteSpan data) noexcept;
+
+    /*
+        Returns a span over the image-data section of a KTX file that is held entirely in memory,
+        as long as every mip level is stored exactly where calcMipPayloadOffset places it.
+        This lets the image-data be used in-place without copying it.
+
+        imageDataOffset is the offset from the start of the file to the first 'imageSize' field.
+    */
+    [[nodiscard]] ResultValue<ConstByteSpan> getImageDataInPlace(
+        ConstByteSpan fileData,
+        std::size_t imageDataOffset,
+        TextureInfo const& textureInfo) noexcept;
+
+    /*
+        Returns the offset from the start of the image-data section of a KTX file,
+        which starts at the first 'imageSize' field, to the payload of the specified mip level.
+
+        Assumes every 'imageSize' field matches the size Texas calculates for that mip level.
+    */
+    [[nodiscard]] inline std::uint64_t calcMipPayloadOffset(
+        TextureInfo const& textureInfo, 
+        std::uint8_t mipIndex) noexcept
+    {
+        std::uint64_t offset = 0;
+        for (std::uint8_t i = 0; i < mipIndex; i += 1)
+        {
+            std::uint64_t const mipDataSize = calculateTotalSize(
+                calculateMipDimensions(textureInfo.baseDimensions, i),
+                textureInfo.pixelFormat,
+                1,
+                textureInfo.layerCount);
+            // The 'imageSize' field, the data itself and the mip padding.
+            offset += sizeof(std::uint32_t) + mipDataSize + (3 - ((mipDataSize + 3) % 4));
+        }
+        // Jump over the 'imageSize' field of this mip level.
+        return offset + sizeof(std::uint32_t);
+    }
+
     namespace Header
     {
         constexpr std::uint32_t correctEndian = 0x04030201;
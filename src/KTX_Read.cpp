@@ -64,18 +64,96 @@ namespace Texas::detail::KTX
     {
         return texType == TextureType::Cubemap || texType == TextureType::ArrayCubemap;
     }
+
+    /*
+        Returns true if the index in backendData can be trusted to find mipIndex.
+        Every entry of the index has to be in order, and every mip level it describes
+        has to fit inside the stream. On top of that, the 'imageSize' field at
+        backendData.mipStreamPos[mipIndex] has to hold the size we calculate for that mip level.
+        The stream is then left right after the 'imageSize' field.
+        Otherwise the stream is left at an unspecified position.
+
+        Returns false if the stream does not know its own size,
+        since the index can't be checked against it.
+    */
+    template<typename StreamT>
+    [[nodiscard]] static bool isMipStreamPosValid(
+        StreamT& stream,
+        TextureInfo const& textureInfo,
+        FileInfo_KTX_BackendData const& backendData,
+        std::uint8_t mipIndex) noexcept
+    {
+        std::size_t const streamSize = stream.size();
+        if (streamSize == InputStream::unknownSize)
+            return false;
+        std::size_t prevMipEnd = backendData.imageDataStreamPos;
+        for (std::uint8_t i = 0; i < textureInfo.mipCount; i += 1)
+        {
+            std::size_t const mipStreamPos = backendData.mipStreamPos[i];
+            if (mipStreamPos < prevMipEnd || mipStreamPos > streamSize)
+                return false;
+            std::uint64_t const mipDataSize = calculateTotalSize(
+                calculateMipDimensions(textureInfo.baseDimensions, i),
+                textureInfo.pixelFormat,
+                1,
+                textureInfo.layerCount);
+            // The 'imageSize' field and the data itself. The padding of the last mip level may be missing.
+            if (sizeof(std::uint32_t) + mipDataSize > streamSize - mipStreamPos)
+                return false;
+            prevMipEnd = mipStreamPos + static_cast<std::size_t>(sizeof(std::uint32_t) + mipDataSize);
+        }
+
+        stream.seek(backendData.mipStreamPos[mipIndex]);
+        std::uint32_t mipDataSize = 0;
+        Result const result = stream.read({ reinterpret_cast<std::byte*>(&mipDataSize), sizeof(mipDataSize) });
+        if (!result.isSuccessful())
+            return false;
+        std::uint64_t const expectedSize = calculateTotalSize(
+            calculateMipDimensions(textureInfo.baseDimensions, mipIndex),
+            textureInfo.pixelFormat,
+            1,
+            textureInfo.layerCount);
+        return mipDataSize == expectedSize;
+    }
+
+    /*
+        Passes access on to the stream as a hint for where the mip levels in [baseMip, endMip) are in it.
+        Uses the index in backendData, which is only a guess until it has been checked,
+        but that is good enough for a hint.
+    */
+    template<typename StreamT>
+    static void hintMipRange(
+        StreamT& stream,
+        TextureInfo const& textureInfo,
+        FileInfo_KTX_BackendData const& backendData,
+        std::uint32_t baseMip,
+        std::uint32_t endMip,
+        InputStream::AccessHint access) noexcept
+    {
+        std::size_t const beginStreamPos = backendData.mipStreamPos[baseMip];
+        // The last mip level goes to the end of the stream.
+        std::size_t length = 0;
+        if (endMip < textureInfo.mipCount)
+            length = backendData.mipStreamPos[endMip] - beginStreamPos;
+        stream.hint(beginStreamPos, length, access);
+    }
 }
 
+template<typename StreamT>
 Texas::Result Texas::detail::KTX::loadFromStream(
-    InputStream& stream, 
-    TextureInfo& textureInfo)
+    StreamT& stream, 
+    TextureInfo& textureInfo,
+    FileInfo_KTX_BackendData& backendData,
+    ConstByteSpan fileStart)
 {
     Result result{};
 
     textureInfo.fileFormat = FileFormat::KTX;
 
+    // The start of the file has already been read to identify it.
     std::byte headerBuffer[Header::totalSize] = {};
-    result = stream.read({ headerBuffer, Header::totalSize });
+    std::memcpy(headerBuffer, fileStart.data(), fileStart.size());
+    result = stream.read({ headerBuffer + fileStart.size(), Header::totalSize - fileStart.size() });
     if (!result.isSuccessful())
         return result;
 
@@ -160,10 +238,11 @@ Texas::Result Texas::detail::KTX::loadFromStream(
         textureInfo.layerCount = 1;
     // Grab amount of mip levels
     // Usually, mipCount = 0 means a mipmap pyramid should be generated at loadtime. But we ignore it.
-    textureInfo.mipCount = KTX::toU32(headerBuffer + Header::numberOfMipmapLevels_Offset);
+    std::uint32_t const origMipCount = KTX::toU32(headerBuffer + Header::numberOfMipmapLevels_Offset);
     // KTX supports 32 mip levels maximally
-    if (textureInfo.mipCount > 32)
-        return { ResultType::Success, "KTX specification doesn't allow mip-level count higher than 32." };
+    if (origMipCount > FileInfo_KTX_BackendData::maxMipCount)
+        return { ResultType::CorruptFileData, "KTX specification doesn't allow mip-level count higher than 32." };
+    textureInfo.mipCount = static_cast<std::uint8_t>(origMipCount);
     if (textureInfo.mipCount == 0)
         textureInfo.mipCount = 1;
 
@@ -173,11 +252,22 @@ Texas::Result Texas::detail::KTX::loadFromStream(
 
     stream.ignore(totalKeyValueDataSize);
 
+    // Build the index of where each mip level starts, so that a single mip level
+    // can be reached with one seek instead of reading through every level before it.
+    backendData.imageDataStreamPos = stream.tell();
+    for (std::uint8_t mipIndex = 0; mipIndex < textureInfo.mipCount; mipIndex += 1)
+    {
+        // calcMipPayloadOffset jumps over the 'imageSize' field, the index points at it.
+        std::uint64_t const mipFieldOffset = calcMipPayloadOffset(textureInfo, mipIndex) - sizeof(std::uint32_t);
+        backendData.mipStreamPos[mipIndex] = backendData.imageDataStreamPos + static_cast<std::size_t>(mipFieldOffset);
+    }
+
     return Texas::successResult;
 }
 
+template<typename StreamT>
 Texas::Result Texas::detail::KTX::loadImageData(
-    InputStream& stream,
+    StreamT& stream,
     ByteSpan dstBuffer,
     TextureInfo const& textureInfo,
     FileInfo_KTX_BackendData const& backendData)
@@ -191,27 +281,338 @@ Texas::Result Texas::detail::KTX::loadImageData(
     }
     else
     {
-        for (std::uint32_t mipIndex = 0; mipIndex < textureInfo.mipCount; mipIndex += 1)
+        // Streams that can't seek are fine, as long as the image-data is loaded right after parsing.
+        if (stream.tell() != backendData.imageDataStreamPos)
+            stream.seek(backendData.imageDataStreamPos);
+        hintMipRange(stream, textureInfo, backendData, 0, textureInfo.mipCount, InputStream::AccessHint::WillNeed);
+
+        /*
+            The size of every mip level is known up front, so the entire payload is read with
+            a single vectored read. It goes straight into dstBuffer, with the 'imageSize' fields
+            and mip padding in between going into scratch space. The 'imageSize' fields are
+            checked afterwards.
+        */
+        constexpr std::uint8_t maxMipCount = FileInfo_KTX_BackendData::maxMipCount;
+        std::uint32_t mipDataSizes[maxMipCount] = {};
+        std::uint64_t expectedMipDataSizes[maxMipCount] = {};
+        std::byte paddingScratch[3] = {};
+        ByteSpan dsts[maxMipCount * 3] = {};
+        std::size_t dstCount = 0;
+        for (std::uint8_t mipIndex = 0; mipIndex < textureInfo.mipCount; mipIndex += 1)
+        {
+            std::uint64_t const mipDataSize = calculateTotalSize(
+                calculateMipDimensions(textureInfo.baseDimensions, mipIndex),
+                textureInfo.pixelFormat,
+                1,
+                textureInfo.layerCount);
+            // The 'imageSize' field is 32-bit, so no file can hold a larger mip level.
+            if (mipDataSize > 0xFFFFFFFF)
+                return { ResultType::CorruptFileData, "KTX mip-level size does not match its dimensions and pixel-format." };
+            expectedMipDataSizes[mipIndex] = mipDataSize;
+
+            dsts[dstCount] = { reinterpret_cast<std::byte*>(&mipDataSizes[mipIndex]), sizeof(std::uint32_t) };
+            dsts[dstCount + 1] = { dstBuffer.data() + dstMemOffset, static_cast<std::size_t>(mipDataSize) };
+            dstCount += 2;
+            dstMemOffset += static_cast<std::size_t>(mipDataSize);
+
+            // The padding after the last mip level is left out, in case the file was written without it.
+            std::uint8_t const padding = (3 - ((mipDataSize + 3) % 4));
+            if (padding > 0 && mipIndex + 1 < textureInfo.mipCount)
+            {
+                dsts[dstCount] = { paddingScratch, padding };
+                dstCount += 1;
+            }
+        }
+
+        result = stream.readVectored({ dsts, dstCount });
+        if (!result.isSuccessful())
+            return result;
+
+        for (std::uint8_t mipIndex = 0; mipIndex < textureInfo.mipCount; mipIndex += 1)
+        {
+            if (mipDataSizes[mipIndex] == 0)
+                return { ResultType::CorruptFileData , "KTX spec doesn't allow a mip-level to have size 0." };
+            if (mipDataSizes[mipIndex] != expectedMipDataSizes[mipIndex])
+                return { ResultType::CorruptFileData, "KTX mip-level size does not match its dimensions and pixel-format." };
+        }
+        std::uint64_t const lastMipDataSize = expectedMipDataSizes[textureInfo.mipCount - 1];
+        stream.ignore(3 - ((lastMipDataSize + 3) % 4));
+        hintMipRange(stream, textureInfo, backendData, 0, textureInfo.mipCount, InputStream::AccessHint::DontNeed);
+    }
+
+    return Texas::successResult;
+}
+
+template<typename StreamT>
+Texas::Result Texas::detail::KTX::loadImageData(
+    StreamT& stream,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout,
+    ImageDataRange const& range,
+    TextureInfo const& textureInfo,
+    FileInfo_KTX_BackendData const& backendData)
+{
+    if (isCubemap(textureInfo.textureType))
+        return Result(ResultType::FileNotSupported, "KTX cubemaps not yet supported.");
+
+    std::uint32_t const endMip = std::uint32_t(range.baseMip) + range.mipCount;
+    hintMipRange(stream, textureInfo, backendData, range.baseMip, endMip, InputStream::AccessHint::WillNeed);
+
+    // Jump straight to the first mip level of the range when the index can be trusted,
+    // otherwise walk through the 'imageSize' fields of every mip level before it.
+    std::uint8_t startMip = 0;
+    if (range.baseMip > 0 && isMipStreamPosValid(stream, textureInfo, backendData, range.baseMip))
+        startMip = range.baseMip;
+    else if (stream.tell() != backendData.imageDataStreamPos)
+        stream.seek(backendData.imageDataStreamPos);
+
+    Result result{};
+    for (std::uint8_t mipIndex = startMip; mipIndex < endMip; mipIndex += 1)
+    {
+        std::uint32_t mipDataSize = 0;
+        if (mipIndex > 0 && mipIndex == startMip)
+        {
+            // The 'imageSize' field was already read when checking the index.
+            mipDataSize = static_cast<std::uint32_t>(calculateTotalSize(
+                calculateMipDimensions(textureInfo.baseDimensions, mipIndex),
+                textureInfo.pixelFormat,
+                1,
+                textureInfo.layerCount));
+        }
+        else
         {
-            // Contains the amount of data from all array images of this mip level
-            std::uint32_t mipDataSize = 0;
             result = stream.read({ reinterpret_cast<std::byte*>(&mipDataSize), sizeof(mipDataSize) });
             if (!result.isSuccessful())
                 return result;
-            if (mipDataSize == 0)
-                return { ResultType::CorruptFileData , "KTX spec doesn't allow a mip-level to have size 0." };
-            // TODO: Maybe add some validation to check if size is correct multiple...
+        }
+        std::uint8_t const padding = (3 - ((mipDataSize + 3) % 4));
 
-            // Copy all the data of this mip-level.
-            result = stream.read({ dstBuffer.data() + dstMemOffset, mipDataSize });
+        if (mipIndex < range.baseMip)
+        {
+            stream.ignore(std::size_t(mipDataSize) + padding);
+            continue;
+        }
+
+        Dimensions const mipDims = calculateMipDimensions(textureInfo.baseDimensions, mipIndex);
+        std::uint64_t const rowSize = calculateRowSize(mipDims, textureInfo.pixelFormat);
+        std::uint64_t const rowCount = calculateRowCount(mipDims, textureInfo.pixelFormat);
+        std::uint64_t const sliceSize = rowSize * rowCount;
+        std::uint64_t const layerSize = sliceSize * mipDims.depth;
+        // Unlike the tightly packed path, we have to know where every row goes,
+        // so the size in the file has to match the one we calculate.
+        if (mipDataSize != layerSize * textureInfo.layerCount)
+            return { ResultType::CorruptFileData, "KTX mip-level size does not match its dimensions and pixel-format." };
+
+        MipLayout const& mipLayout = dstLayout.mips[mipIndex];
+        std::byte* const mipDst = dstBuffer.data() + mipLayout.offset;
+        bool const isTightSlice = mipLayout.rowPitch == rowSize;
+        bool const isTightLayer = isTightSlice && mipLayout.slicePitch == sliceSize;
+        if (isTightLayer && mipLayout.layerPitch == layerSize && range.layerCount == textureInfo.layerCount)
+        {
+            // Nothing in this mip level is padded, so we can copy it all at once.
+            result = stream.read({ mipDst, mipDataSize });
             if (!result.isSuccessful())
                 return result;
-
-            std::uint8_t const padding = (3 - ((mipDataSize + 3) % 4));
             stream.ignore(padding);
-            dstMemOffset += mipDataSize;
+            continue;
         }
+
+        stream.ignore(static_cast<std::size_t>(range.baseLayer * layerSize));
+        for (std::uint64_t layerIndex = 0; layerIndex < range.layerCount; layerIndex += 1)
+        {
+            std::byte* const layerDst = mipDst + layerIndex * mipLayout.layerPitch;
+            if (isTightLayer)
+            {
+                result = stream.read({ layerDst, static_cast<std::size_t>(layerSize) });
+                if (!result.isSuccessful())
+                    return result;
+                continue;
+            }
+            for (std::uint64_t sliceIndex = 0; sliceIndex < mipDims.depth; sliceIndex += 1)
+            {
+                std::byte* const sliceDst = layerDst + sliceIndex * mipLayout.slicePitch;
+                if (isTightSlice)
+                {
+                    result = stream.read({ sliceDst, static_cast<std::size_t>(sliceSize) });
+                    if (!result.isSuccessful())
+                        return result;
+                    continue;
+                }
+                for (std::uint64_t rowIndex = 0; rowIndex < rowCount; rowIndex += 1)
+                {
+                    result = stream.read({ sliceDst + rowIndex * mipLayout.rowPitch, static_cast<std::size_t>(rowSize) });
+                    if (!result.isSuccessful())
+                        return result;
+                }
+            }
+        }
+        std::uint64_t const layersAfterRange = textureInfo.layerCount - range.baseLayer - range.layerCount;
+        stream.ignore(static_cast<std::size_t>(layersAfterRange * layerSize) + padding);
     }
 
+    hintMipRange(stream, textureInfo, backendData, range.baseMip, endMip, InputStream::AccessHint::DontNeed);
+
+    return Texas::successResult;
+}
+
+Texas::Result Texas::detail::KTX::beginIncremental(
+    IncrementalDecoder_KTX_BackendData& state,
+    TextureInfo const& textureInfo) noexcept
+{
+    if (isCubemap(textureInfo.textureType))
+        return { ResultType::FileNotSupported, "KTX cubemaps not yet supported." };
+
+    state = {};
     return Texas::successResult;
-}
\ No newline at end of file
+}
+
+Texas::Result Texas::detail::KTX::decodeIncremental(
+    IncrementalDecoder_KTX_BackendData& state,
+    TextureInfo const& textureInfo,
+    ByteSpan dstBuffer,
+    ConstByteSpan data) noexcept
+{
+    using Section = IncrementalDecoder_KTX_BackendData::Section;
+
+    std::size_t offset = 0;
+    while (offset < data.size() && state.section != Section::Done)
+    {
+        std::size_t const bytesLeft = data.size() - offset;
+        if (state.section == Section::ImageSize)
+        {
+            std::size_t amount = sizeof(state.imageSizeBuffer) - state.imageSizeBytesRead;
+            if (amount > bytesLeft)
+                amount = bytesLeft;
+            std::memcpy(state.imageSizeBuffer + state.imageSizeBytesRead, data.data() + offset, amount);
+            state.imageSizeBytesRead += static_cast<std::uint8_t>(amount);
+            offset += amount;
+            if (state.imageSizeBytesRead < sizeof(state.imageSizeBuffer))
+                break;
+            state.imageSizeBytesRead = 0;
+
+            // The payload is written to the destination buffer as it arrives,
+            // so it can't be allowed to be any larger than we calculate.
+            std::uint32_t const mipDataSize = KTX::toU32(state.imageSizeBuffer);
+            std::uint64_t const expectedSize = calculateTotalSize(
+                calculateMipDimensions(textureInfo.baseDimensions, state.mipsReady),
+                textureInfo.pixelFormat,
+                1,
+                textureInfo.layerCount);
+            if (mipDataSize != expectedSize)
+                return { ResultType::CorruptFileData, "KTX mip-level size does not match its dimensions and pixel-format." };
+            state.section = Section::Payload;
+            state.sectionRemaining = mipDataSize;
+        }
+        else if (state.section == Section::Payload)
+        {
+            std::uint64_t amount = state.sectionRemaining;
+            if (amount > bytesLeft)
+                amount = bytesLeft;
+            std::memcpy(dstBuffer.data() + state.dstOffset, data.data() + offset, static_cast<std::size_t>(amount));
+            offset += static_cast<std::size_t>(amount);
+            state.dstOffset += amount;
+            state.mipBytesWritten += amount;
+            state.sectionRemaining -= amount;
+            if (state.sectionRemaining == 0)
+            {
+                state.section = Section::Padding;
+                state.sectionRemaining = 3 - ((state.mipBytesWritten + 3) % 4);
+                state.mipsReady += 1;
+                state.mipBytesWritten = 0;
+            }
+        }
+        else if (state.section == Section::Padding)
+        {
+            std::uint64_t amount = state.sectionRemaining;
+            if (amount > bytesLeft)
+                amount = bytesLeft;
+            offset += static_cast<std::size_t>(amount);
+            state.sectionRemaining -= amount;
+        }
+
+        if (state.section == Section::Padding && state.sectionRemaining == 0)
+            state.section = Section::ImageSize;
+        if (state.mipsReady == textureInfo.mipCount)
+            state.section = Section::Done;
+    }
+
+    return Texas::successResult;
+}
+
+Texas::ResultValue<Texas::ConstByteSpan> Texas::detail::KTX::getImageDataInPlace(
+    ConstByteSpan fileData,
+    std::size_t imageDataOffset,
+    TextureInfo const& textureInfo) noexcept
+{
+    if (isCubemap(textureInfo.textureType))
+        return { ResultType::FileNotSupported, "KTX cubemaps not yet supported." };
+    if (imageDataOffset > fileData.size())
+        return { ResultType::PrematureEndOfFile, "KTX image-data starts past the end of the file." };
+
+    std::byte const* const imageData = fileData.data() + imageDataOffset;
+    std::uint64_t const imageDataAvailable = fileData.size() - imageDataOffset;
+    std::uint64_t imageDataSize = 0;
+    for (std::uint8_t mipIndex = 0; mipIndex < textureInfo.mipCount; mipIndex += 1)
+    {
+        std::uint64_t const mipDataSize = calculateTotalSize(
+            calculateMipDimensions(textureInfo.baseDimensions, mipIndex),
+            textureInfo.pixelFormat,
+            1,
+            textureInfo.layerCount);
+        std::uint64_t const payloadOffset = calcMipPayloadOffset(textureInfo, mipIndex);
+        if (payloadOffset + mipDataSize > imageDataAvailable)
+            return { ResultType::PrematureEndOfFile, "KTX mip-level extends past the end of the file." };
+
+        // The 'imageSize' field sits right in front of the payload.
+        std::uint32_t const fileMipDataSize = KTX::toU32(imageData + payloadOffset - sizeof(std::uint32_t));
+        if (fileMipDataSize != mipDataSize)
+            return { ResultType::FileNotSupported, 
+                     "KTX field 'imageSize' does not match the size of the mip-level Texas calculates. "
+                     "The image-data can not be used in-place." };
+
+        imageDataSize = payloadOffset + mipDataSize;
+    }
+
+    return ConstByteSpan{ imageData, static_cast<std::size_t>(imageDataSize) };
+}
+
+namespace Texas::detail::KTX
+{
+    // Texas has entry points for both of these stream types.
+    template Result loadFromStream<InputStream>(
+        InputStream& stream,
+        TextureInfo& textureInfo,
+        FileInfo_KTX_BackendData& backendData,
+        ConstByteSpan fileStart);
+    template Result loadFromStream<MemoryInputStream>(
+        MemoryInputStream& stream,
+        TextureInfo& textureInfo,
+        FileInfo_KTX_BackendData& backendData,
+        ConstByteSpan fileStart);
+
+    template Result loadImageData<InputStream>(
+        InputStream& stream,
+        ByteSpan dstBuffer,
+        TextureInfo const& textureInfo,
+        FileInfo_KTX_BackendData const& backendData);
+    template Result loadImageData<MemoryInputStream>(
+        MemoryInputStream& stream,
+        ByteSpan dstBuffer,
+        TextureInfo const& textureInfo,
+        FileInfo_KTX_BackendData const& backendData);
+
+    template Result loadImageData<InputStream>(
+        InputStream& stream,
+        ByteSpan dstBuffer,
+        ImageDataLayout const& dstLayout,
+        ImageDataRange const& range,
+        TextureInfo const& textureInfo,
+        FileInfo_KTX_BackendData const& backendData);
+    template Result loadImageData<MemoryInputStream>(
+        MemoryInputStream& stream,
+        ByteSpan dstBuffer,
+        ImageDataLayout const& dstLayout,
+        ImageDataRange const& range,
+        TextureInfo const& textureInfo,
+        FileInfo_KTX_BackendData const& backendData);
+}
@@ -210,11 +210,11 @@ Texas::ResultValue<std::uint64_t> Texas::detail::PrivateAccessor::KTX_calcFileSi
         totalSize += 4;
 
         // Add the total size of this mip-level. Includes 3D depth, array-layers, 
-        //Dimensions mipDims = calculateMipDimensions(texInfo.baseDimensions, mipLevel);
-        totalSize += calculateTotalSize(texInfo.baseDimensions, texInfo.pixelFormat, 1, texInfo.layerCount);
+        Dimensions const mipDims = calculateMipDimensions(texInfo.baseDimensions, mipLevel);
+        totalSize += calculateTotalSize(mipDims, texInfo.pixelFormat, 1, texInfo.layerCount);
 
         // Align to 4 bytes
-        totalSize += totalSize % 4;
+        totalSize += (4 - totalSize % 4) % 4;
     }
 
     return totalSize;
@@ -408,7 +408,7 @@ Texas::Result Texas::KTX::saveToStream(
         memOffsetTracker += imageSize;
 
         constexpr char const paddingBuffer[3] = {};
-        std::uint8_t paddingAmount = memOffsetTracker % 4;
+        std::uint8_t const paddingAmount = static_cast<std::uint8_t>((4 - memOffsetTracker % 4) % 4);
         // Add padding to align to 4 bytes
         result = stream.write(paddingBuffer, paddingAmount);
         if (!result.isSuccessful())
@@ -0,0 +1,105 @@
+#include "Texas/MappedFileStream.hpp"
+
+#include "MemoryMapping.hpp"
+
+// For std::memcpy
+#include <cstring>
+
+Texas::MappedFileStream::MappedFileStream(MappedFileStream&& other) noexcept
+{
+    m_mapping = other.m_mapping;
+    m_offset = other.m_offset;
+
+    other.m_mapping = detail::MemoryMapping{};
+    other.m_offset = 0;
+}
+
+Texas::MappedFileStream& Texas::MappedFileStream::operator=(MappedFileStream&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+    close();
+
+    m_mapping = other.m_mapping;
+    m_offset = other.m_offset;
+
+    other.m_mapping = detail::MemoryMapping{};
+    other.m_offset = 0;
+
+    return *this;
+}
+
+Texas::MappedFileStream::~MappedFileStream()
+{
+    close();
+}
+
+Texas::Result Texas::MappedFileStream::open(char const* path) noexcept
+{
+    close();
+
+    ResultValue<detail::MemoryMapping> mapResult = detail::mapFile(path);
+    if (!mapResult.isSuccessful())
+        return mapResult.toResult();
+    m_mapping = mapResult.value();
+    return { ResultType::Success, nullptr };
+}
+
+void Texas::MappedFileStream::close() noexcept
+{
+    detail::unmapFile(m_mapping);
+    m_mapping = detail::MemoryMapping{};
+    m_offset = 0;
+}
+
+Texas::ConstByteSpan Texas::MappedFileStream::data() const noexcept
+{
+    return { m_mapping.data, m_mapping.size };
+}
+
+Texas::Result Texas::MappedFileStream::read(ByteSpan dst) noexcept
+{
+    if (m_offset > m_mapping.size || dst.size() > m_mapping.size - m_offset)
+        return { ResultType::PrematureEndOfFile, "Reached premature end of mapped file." };
+    std::memcpy(dst.data(), m_mapping.data + m_offset, dst.size());
+    m_offset += dst.size();
+    return { ResultType::Success, nullptr };
+}
+
+void Texas::MappedFileStream::ignore(std::size_t amount) noexcept
+{
+    m_offset += amount;
+}
+
+Texas::ConstByteSpan Texas::MappedFileStream::acquire(std::size_t amount) noexcept
+{
+    if (m_offset > m_mapping.size || amount > m_mapping.size - m_offset)
+        return {};
+    ConstByteSpan const returnVal = { m_mapping.data + m_offset, amount };
+    m_offset += amount;
+    return returnVal;
+}
+
+std::size_t Texas::MappedFileStream::tell() noexcept
+{
+    return m_offset;
+}
+
+void Texas::MappedFileStream::seek(std::size_t pos) noexcept
+{
+    m_offset = pos;
+}
+
+std::size_t Texas::MappedFileStream::size() noexcept
+{
+    return m_mapping.size;
+}
+
+void Texas::MappedFileStream::hint(std::size_t pos, std::size_t length, AccessHint access) noexcept
+{
+    if (pos >= m_mapping.size)
+        return;
+    if (length == 0 || length > m_mapping.size - pos)
+        length = m_mapping.size - pos;
+    detail::adviseMapping(m_mapping, pos, length, access);
+}
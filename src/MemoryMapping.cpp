@@ -0,0 +1,149 @@
+#include "MemoryMapping.hpp"
+
+#if defined(_WIN32)
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <Windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#include <cstdint>
+
+Texas::ResultValue<Texas::detail::MemoryMapping> Texas::detail::mapFile(char const* path) noexcept
+{
+    MemoryMapping mapping{};
+
+#if defined(_WIN32)
+    HANDLE const file = CreateFileA(
+        path, 
+        GENERIC_READ, 
+        FILE_SHARE_READ, 
+        nullptr, 
+        OPEN_EXISTING, 
+        FILE_ATTRIBUTE_NORMAL, 
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return { ResultType::CouldNotOpenFile, "Failed to open this file for reading." };
+
+    LARGE_INTEGER fileSize{};
+    if (GetFileSizeEx(file, &fileSize) == 0)
+    {
+        CloseHandle(file);
+        return { ResultType::CouldNotOpenFile, "Failed to query the size of this file." };
+    }
+    if (static_cast<std::uint64_t>(fileSize.QuadPart) > static_cast<std::size_t>(-1))
+    {
+        CloseHandle(file);
+        return { ResultType::FileNotSupported, "File is larger than the system can map into memory." };
+    }
+    if (fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return { static_cast<MemoryMapping&&>(mapping) };
+    }
+
+    HANDLE const fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    // The view keeps the underlying file alive, so we can close the handles right away.
+    CloseHandle(file);
+    if (fileMapping == nullptr)
+        return { ResultType::CouldNotOpenFile, "Failed to map this file into memory." };
+    void* const view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(fileMapping);
+    if (view == nullptr)
+        return { ResultType::CouldNotOpenFile, "Failed to map this file into memory." };
+
+    mapping.data = static_cast<std::byte const*>(view);
+    mapping.size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int const fd = ::open(path, O_RDONLY);
+    if (fd == -1)
+        return { ResultType::CouldNotOpenFile, "Failed to open this file for reading." };
+
+    struct stat fileStat{};
+    if (::fstat(fd, &fileStat) != 0)
+    {
+        ::close(fd);
+        return { ResultType::CouldNotOpenFile, "Failed to query the size of this file." };
+    }
+    if (static_cast<std::uint64_t>(fileStat.st_size) > static_cast<std::size_t>(-1))
+    {
+        ::close(fd);
+        return { ResultType::FileNotSupported, "File is larger than the system can map into memory." };
+    }
+    if (fileStat.st_size == 0)
+    {
+        ::close(fd);
+        return { static_cast<MemoryMapping&&>(mapping) };
+    }
+
+    std::size_t const fileSize = static_cast<std::size_t>(fileStat.st_size);
+    void* const view = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the underlying file alive, so we can close the descriptor right away.
+    ::close(fd);
+    if (view == MAP_FAILED)
+        return { ResultType::CouldNotOpenFile, "Failed to map this file into memory." };
+
+    mapping.data = static_cast<std::byte const*>(view);
+    mapping.size = fileSize;
+#endif
+
+    return { static_cast<MemoryMapping&&>(mapping) };
+}
+
+void Texas::detail::unmapFile(MemoryMapping mapping) noexcept
+{
+    if (mapping.data == nullptr)
+        return;
+#if defined(_WIN32)
+    UnmapViewOfFile(mapping.data);
+#else
+    ::munmap(const_cast<std::byte*>(mapping.data), mapping.size);
+#endif
+}
+
+void Texas::detail::adviseMapping(
+    MemoryMapping mapping,
+    std::size_t offset,
+    std::size_t length,
+    InputStream::AccessHint access) noexcept
+{
+    if (mapping.data == nullptr || length == 0)
+        return;
+#if defined(_WIN32)
+    (void)offset;
+    (void)access;
+#else
+    std::uintptr_t const pageSize = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(mapping.data) + offset;
+    std::uintptr_t end = begin + length;
+    int advice = MADV_NORMAL;
+    if (access == InputStream::AccessHint::DontNeed)
+    {
+        // Only release pages that are entirely inside the range, the ones at the edges may still be read.
+        begin = (begin + pageSize - 1) / pageSize * pageSize;
+        end = end / pageSize * pageSize;
+        // The last page of the file can be released even though the mapping ends partway into it.
+        if (offset + length == mapping.size)
+            end = (reinterpret_cast<std::uintptr_t>(mapping.data) + mapping.size + pageSize - 1) / pageSize * pageSize;
+        advice = MADV_DONTNEED;
+    }
+    else
+    {
+        // madvise() wants the start to be page-aligned.
+        begin = begin / pageSize * pageSize;
+        advice = access == InputStream::AccessHint::Sequential ? MADV_SEQUENTIAL : MADV_WILLNEED;
+    }
+    if (begin >= end)
+        return;
+    // This is only advice, so there is nothing to do if the OS turns it down.
+    (void)::madvise(reinterpret_cast<void*>(begin), end - begin, advice);
+#endif
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Texas/InputStream.hpp"
+#include "Texas/ResultValue.hpp"
+#include "Texas/detail/MemoryMapping.hpp"
+
+namespace Texas::detail
+{
+    /*
+        Maps the entire file at the specified path into memory as read-only.
+
+        Mapping an empty file succeeds and returns an empty mapping.
+    */
+    [[nodiscard]] ResultValue<MemoryMapping> mapFile(char const* path) noexcept;
+
+    /*
+        Unmaps a mapping created by mapFile. Does nothing if the mapping is empty.
+    */
+    void unmapFile(MemoryMapping mapping) noexcept;
+
+    /*
+        Passes a hint for the length bytes starting at offset in the mapping on to the OS.
+        The range must be inside the mapping. Does nothing on Windows.
+    */
+    void adviseMapping(MemoryMapping mapping, std::size_t offset, std::size_t length, InputStream::AccessHint access) noexcept;
+}
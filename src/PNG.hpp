@@ -1,27 +1,117 @@
 #pragma once
 
 #include "Texas/InputStream.hpp"
+#include "Texas/MemoryInputStream.hpp"
 #include "Texas/Result.hpp"
 #include "Texas/TextureInfo.hpp"
 #include "Texas/Span.hpp"
 #include "Texas/FileInfo.hpp"
 
+#include "Texas/detail/IncrementalDecoder_BackendData.hpp"
+
 #include <cstdint>
 
+namespace Texas::detail
+{
+    class InflateContext;
+}
+
 namespace Texas::detail::PNG
 {
     constexpr std::uint8_t identifier[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
 
+    // Stored in the first byte of each row of filtered data.
+    enum class FilterType : char
+    {
+        None = 0,
+        Sub = 1,
+        Up = 2,
+        Average = 3,
+        Paeth = 4,
+    };
+
+    /*
+        Reads the PNG chunks up to IEND, validating their order along the way.
+
+        If stopAtFirstIdat is true, it stops reading once it reaches the first IDAT chunk.
+        Everything needed to decode the image appears before it, only the size of
+        the largest IDAT chunk is unknown, and the decoder does not depend on it.
+        The stream is then left at the data of the first IDAT chunk, so the image
+        can be decoded without seeking.
+
+        fileStart holds the first bytes of the file, which have already been read
+        from the stream to identify the file-format. Can not be larger than the PNG header.
+    */
+    template<typename StreamT>
     Result parseStream(
-        InputStream& stream,
+        StreamT& stream,
         TextureInfo& metaData,
         std::uint64_t& workingMemRequired,
-        detail::FileInfo_PNG_BackendData& backendData) noexcept;
+        std::uint64_t& minWorkingMemRequired,
+        detail::FileInfo_PNG_BackendData& backendData,
+        ConstByteSpan fileStart,
+        bool stopAtFirstIdat) noexcept;
+
+    /*
+        Decodes the image-data into dstImageBuffer.
 
+        If workingMem is smaller than the workingMemRequired reported by parseStream,
+        the image is decoded one row at a time. workingMem must still be atleast minWorkingMemRequired.
+        The zLib data-stream is decompressed with inflateContext.
+        Rows are written dstRowPitch bytes apart in dstImageBuffer.
+
+        If pipelined is true and workingMem is atleast calcWorkingMemRequired_Pipelined bytes,
+        rows are defiltered on another thread while this one inflates the next ones.
+        Files whose IDAT data is split in segments are instead decoded on one thread per segment,
+        if the stream can hand out all of its IDAT chunks with acquire().
+    */
+    template<typename StreamT>
     Result loadFromStream(
-        InputStream& stream,
+        StreamT& stream,
+        InflateContext& inflateContext,
         TextureInfo const& textureInfo,
         detail::FileInfo_PNG_BackendData const& backendData,
         ByteSpan dstImageBuffer,
+        std::size_t dstRowPitch,
+        ByteSpan workingMem,
+        bool pipelined = false) noexcept;
+
+    /*
+        Returns the amount of working memory loadFromStream needs to decode on more than one thread.
+        Returns 0 if the image is too small for that to be worth it,
+        or if TEXAS_ENABLE_PNG_PIPELINING is not defined.
+    */
+    [[nodiscard]] std::uint64_t calcWorkingMemRequired_Pipelined(
+        TextureInfo const& textureInfo,
+        detail::FileInfo_PNG_BackendData const& backendData) noexcept;
+
+    /*
+        Returns the amount of working memory decodeIncremental needs.
+    */
+    [[nodiscard]] std::uint64_t calcWorkingMemRequired_Incremental(
+        TextureInfo const& textureInfo,
+        detail::FileInfo_PNG_BackendData const& backendData) noexcept;
+
+    /*
+        Gets state ready to decode image-data that is pushed in as it arrives.
+        The first byte passed to decodeIncremental must be the first byte of data in the first IDAT chunk.
+        workingMem must be atleast calcWorkingMemRequired_Incremental bytes, 
+        and it must outlive the decoding just like inflateContext.
+    */
+    [[nodiscard]] Result beginIncremental(
+        detail::IncrementalDecoder_PNG_BackendData& state,
+        InflateContext& inflateContext,
+        detail::FileInfo_PNG_BackendData const& backendData,
         ByteSpan workingMem) noexcept;
-}
\ No newline at end of file
+
+    /*
+        Decodes as many rows as it can from the next piece of the file, and writes them to dstImageBuffer.
+        Rows are tightly packed. Bytes after the last row are ignored.
+    */
+    [[nodiscard]] Result decodeIncremental(
+        detail::IncrementalDecoder_PNG_BackendData& state,
+        TextureInfo const& textureInfo,
+        detail::FileInfo_PNG_BackendData const& backendData,
+        ByteSpan dstImageBuffer,
+        ConstByteSpan data) noexcept;
+}
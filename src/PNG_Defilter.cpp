@@ -0,0 +1,396 @@
+#include "PNG_Defilter.hpp"
+
+#include "CpuFeatures.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(TEXAS_HAS_SSE2)
+#   include <immintrin.h>
+#endif
+
+/*
+    The Sub, Average and Paeth filters depend on the reconstructed pixel to the left,
+    so they can only be parallelised inside a pixel, not across them. The exception is Sub,
+    which is a prefix-sum and can be done a whole 16-byte vector at a time.
+
+    The per-pixel SIMD kernels are only used where they beat the scalar ones,
+    which is Paeth from 3 byte pixels and Average from 4 byte pixels.
+*/
+
+namespace Texas::detail::PNG
+{
+    [[nodiscard]] static inline std::uint8_t paethPredictor(int a, int b, int c) noexcept
+    {
+        // p = a + b - c, so p - a = b - c, p - b = a - c and p - c = (b - c) + (a - c)
+        int const pa = std::abs(b - c);
+        int const pb = std::abs(a - c);
+        int const pc = std::abs(b - c + a - c);
+
+        // Ties are broken in the order a, b, c.
+        // The selection is done with masks so mispredictions can't stall the loop.
+        int const notA = -static_cast<int>((pa > pb) | (pa > pc));
+        int const pickC = -static_cast<int>(pb > pc);
+        int const bOrC = (b & ~pickC) | (c & pickC);
+        return static_cast<std::uint8_t>((a & ~notA) | (bOrC & notA));
+    }
+
+    template<std::uint8_t pixelWidth>
+    static void defilterSub_Scalar(
+        std::byte* dstRow,
+        std::byte const* filteredRow,
+        std::byte const*,
+        std::size_t rowWidth) noexcept
+    {
+        std::memmove(dstRow, filteredRow, pixelWidth);
+        for (std::size_t xByte = pixelWidth; xByte < rowWidth; xByte++)
+        {
+            std::uint8_t const filterX = std::uint8_t(filteredRow[xByte]);
+            std::uint8_t const reconA = std::uint8_t(dstRow[xByte - pixelWidth]);
+            dstRow[xByte] = std::byte(filterX + reconA);
+        }
+    }
+
+    static void defilterUp_Scalar(
+        std::byte* dstRow,
+        std::byte const* filteredRow,
+        std::byte const* prevRow,
+        std::size_t rowWidth) noexcept
+    {
+        for (std::size_t xByte = 0; xByte < rowWidth; xByte++)
+        {
+            std::uint8_t const filterX = std::uint8_t(filteredRow[xByte]);
+            std::uint8_t const reconB = std::uint8_t(prevRow[xByte]);
+            dstRow[xByte] = std::byte(filterX + reconB);
+        }
+    }
+
+    template<std::uint8_t pixelWidth>
+    static void defilterAverage_Scalar(
+        std::byte* dstRow,
+        std::byte const* filteredRow,
+        std::byte const* prevRow,
+        std::size_t rowWidth) noexcept
+    {
+        // Recon(a) is 0 for the first pixel.
+        for (std::size_t xByte = 0; xByte < pixelWidth; xByte++)
+        {
+            std::uint8_t const filterX = std::uint8_t(filteredRow[xByte]);
+            std::uint8_t const reconB = std::uint8_t(prevRow[xByte]);
+            dstRow[xByte] = std::byte(filterX + reconB / 2);
+        }
+        for (std::size_t xByte = pixelWidth; xByte < rowWidth; xByte++)
+        {
+            std::uint8_t const filterX = std::uint8_t(filteredRow[xByte]);
+            std::uint8_t const reconA = std::uint8_t(dstRow[xByte - pixelWidth]);
+            std::uint8_t const reconB = std::uint8_t(prevRow[xByte]);
+            dstRow[xByte] = std::byte(filterX + (reconA + reconB) / 2);
+        }
+    }
+
+    template<std::uint8_t pixelWidth>
+    static void defilterAverageFirstRow_Scalar(
+        std::byte* dstRow,
+        std::byte const* filteredRow,
+        std::byte const*,
+        std::size_t rowWidth) noexcept
+    {
+        std::memmove(dstRow, filteredRow, pixelWidth);
+        for (std::size_t xByte = pixelWidth; xByte < rowWidth; xByte++)
+        {
+            std::uint8_t const filterX = std::uint8_t(filteredRow[xByte]);
+            std::uint8_t const reconA = std::uint8_t(dstRow[xByte - pixelWidth]);
+            dstRow[xByte] = std::byte(filterX + reconA / 2);
+        }
+    }
+
+    template<std::uint8_t pixelWidth>
+    static void defilterPaeth_Scalar(
+        std::byte* dstRow,
+        std::byte const* filteredRow,
+        std::byte const* prevRow,
+        std::size_t rowWidth) noexcept
+    {
+        // Recon(a) and Recon(c) are 0 for the first pixel, so the predictor always picks Recon(b).
+        for (std::size_t xByte = 0; xByte < pixelWidth; xByte++)
+        {
+            std::uint8_t const filterX = std::uint8_t(filteredRow[xByte]);
+            std::uint8_t const reconB = std::uint8_t(prevRow[xByte]);
+            dstRow[xByte] = std::byte(filterX + reconB);
+        }
+        for (std::size_t xByte = pixelWidth; xByte < rowWidth; xByte++)
+        {
+            std::uint8_t const filterX = std::uint8_t(filteredRow[xByte]);
+            std::uint8_t const reconA = std::uint8_t(dstRow[xByte - pixelWidth]);
+            std::uint8_t const reconB = std::uint8_t(prevRow[xByte]);
+            std::uint8_t const reconC = std::uint8_t(prevRow[xByte - pixelWidth]);
+            dstRow[xByte] = std::byte(filterX + paethPredictor(reconA, reconB, reconC));
+        }
+    }
+
+#if defined(TEXAS_HAS_SSE2)
+    // Reads `byteCount` bytes as a little-endian integer.
+    // 3 and 6 byte reads are split into two reads that are combined in a register,
+    // the compiler would otherwise go through the stack and stall on store-forwarding.
+    template<std::size_t byteCount, typename T>
+    [[nodiscard]] static inline T readBytes(std::byte const* ptr) noexcept
+    {
+        if constexpr (byteCount == 3 || byteCount == 6)
+        {
+            constexpr std::size_t lowCount = byteCount * 2 / 3;
+            return readBytes<lowCount, T>(ptr) | (readBytes<byteCount - lowCount, T>(ptr + lowCount) << (lowCount * 8));
+        }
+        else
+        {
+            T value = 0;
+            std::memcpy(&value, ptr, byteCount);
+            return value;
+        }
+    }
+
+    template<std::size_t byteCount, typename T>
+    static inline void writeBytes(std::byte* ptr, T value) noexcept
+    {
+        if constexpr (byteCount == 3 || byteCount == 6)
+        {
+            constexpr std::size_t lowCount = byteCount * 2 / 3;
+            writeBytes<lowCount>(ptr, value);
+            writeBytes<byteCount - lowCount>(ptr + lowCount, static_cast<T>(value >> (lowCount * 8)));
+        }
+        else
+            std::memcpy(ptr, &value, byteCount);
+    }
+
+    // Loads a single pixel into the lowest bytes of the vector, the rest are zeroed.
+    template<std::uint8_t pixelWidth>
+    [[nodiscard]] static inline __m128i loadPixel(std::byte const* ptr) noexcept
+    {
+        if constexpr (pixelWidth <= 4)
+            return _mm_cvtsi32_si128(static_cast<int>(readBytes<pixelWidth, std::uint32_t>(ptr)));
+        else
+            return _mm_set_epi64x(0, static_cast<long long>(readBytes<pixelWidth, std::uint64_t>(ptr)));
+    }
+
+    template<std::uint8_t pixelWidth>
+    static inline void storePixel(std::byte* ptr, __m128i pixel) noexcept
+    {
+        if constexpr (pixelWidth <= 4)
+            writeBytes<pixelWidth>(ptr, static_cast<std::uint32_t>(_mm_cvtsi128_si32(pixel)));
+        else
+        {
+#   if defined(__x86_64__) || defined(_M_X64)
+            std::uint64_t const value = static_cast<std::uint64_t>(_mm_cvtsi128_si64(pixel));
+#   else
+            std::uint64_t value = 0;
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(&value), pixel);
+#   endif
+            writeBytes<pixelWidth>(ptr, value);
+        }
+    }
+
+    // Returns a mask where the lowest `byteCount` bytes are set.
+    [[nodiscard]] static inline __m128i lowBytesMask(std::size_t byteCount) noexcept
+    {
+        alignas(16) static constexpr std::uint8_t maskSource[32] = {
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        return _mm_loadu_si128(reinterpret_cast<__m128i const*>(maskSource + 16 - byteCount));
+    }
+
+    [[nodiscard]] static inline __m128i select(__m128i mask, __m128i a, __m128i b) noexcept
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    template<std::uint8_t pixelWidth>
+    static void defilterSub_SSE2(
+        std::byte* dstRow,
+        std::byte const* filteredRow,
+        std::byte const*,
+        std::size_t rowWidth) noexcept
+    {
+        // Only whole pixels are reconstructed per vector. For 3 and 6 byte pixels the remaining bytes
+        // are written back unchanged, so this still works when dstRow and filteredRow are the same.
+        constexpr std::size_t usedBytes = 16 - 16 % pixelWidth;
+        __m128i const usedMask = lowBytesMask(usedBytes);
+        __m128i const pixelMask = lowBytesMask(pixelWidth);
+
+        // The reconstructed pixel to the left, in the lowest bytes.
+        __m128i reconA = _mm_setzero_si128();
+        std::size_t xByte = 0;
+        for (; xByte + 16 <= rowWidth; xByte += usedBytes)
+        {
+            __m128i const filtered = _mm_loadu_si128(reinterpret_cast<__m128i const*>(filteredRow + xByte));
+            // Adding Recon(a) to the first pixel lets the prefix-sum carry it through the rest.
+            __m128i recon = _mm_add_epi8(filtered, reconA);
+            if constexpr (pixelWidth < usedBytes)
+                recon = _mm_add_epi8(recon, _mm_slli_si128(recon, pixelWidth));
+            if constexpr (pixelWidth * 2 < usedBytes)
+                recon = _mm_add_epi8(recon, _mm_slli_si128(recon, pixelWidth * 2));
+            if constexpr (pixelWidth * 4 < usedBytes)
+                recon = _mm_add_epi8(recon, _mm_slli_si128(recon, pixelWidth * 4));
+            if constexpr (pixelWidth * 8 < usedBytes)
+                recon = _mm_add_epi8(recon, _mm_slli_si128(recon, pixelWidth * 8));
+            if constexpr (usedBytes != 16)
+                recon = select(usedMask, recon, filtered);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dstRow + xByte), recon);
+            reconA = _mm_and_si128(_mm_srli_si128(recon, usedBytes - pixelWidth), pixelMask);
+        }
+
+        if (xByte == 0)
+        {
+            std::memmove(dstRow, filteredRow, pixelWidth);
+            xByte = pixelWidth;
+        }
+        for (; xByte < rowWidth; xByte++)
+        {
+            std::uint8_t const filterX = std::uint8_t(filteredRow[xByte]);
+            std::uint8_t const reconA = std::uint8_t(dstRow[xByte - pixelWidth]);
+            dstRow[xByte] = std::byte(filterX + reconA);
+        }
+    }
+
+    static void defilterUp_SSE2(
+        std::byte* dstRow,
+        std::byte const* filteredRow,
+        std::byte const* prevRow,
+        std::size_t rowWidth) noexcept
+    {
+        std::size_t xByte = 0;
+        for (; xByte + 16 <= rowWidth; xByte += 16)
+        {
+            __m128i const filtered = _mm_loadu_si128(reinterpret_cast<__m128i const*>(filteredRow + xByte));
+            __m128i const reconB = _mm_loadu_si128(reinterpret_cast<__m128i const*>(prevRow + xByte));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dstRow + xByte), _mm_add_epi8(filtered, reconB));
+        }
+        defilterUp_Scalar(dstRow + xByte, filteredRow + xByte, prevRow + xByte, rowWidth - xByte);
+    }
+
+    TEXAS_TARGET("avx2")
+    static void defilterUp_AVX2(
+        std::byte* dstRow,
+        std::byte const* filteredRow,
+        std::byte const* prevRow,
+        std::size_t rowWidth) noexcept
+    {
+        std::size_t xByte = 0;
+        for (; xByte + 32 <= rowWidth; xByte += 32)
+        {
+            __m256i const filtered = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(filteredRow + xByte));
+            __m256i const reconB = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(prevRow + xByte));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstRow + xByte), _mm256_add_epi8(filtered, reconB));
+        }
+        defilterUp_Scalar(dstRow + xByte, filteredRow + xByte, prevRow + xByte, rowWidth - xByte);
+    }
+
+    template<std::uint8_t pixelWidth>
+    static void defilterAverage_SSE2(
+        std::byte* dstRow,
+        std::byte const* filteredRow,
+        std::byte const* prevRow,
+        std::size_t rowWidth) noexcept
+    {
+        __m128i const ones = _mm_set1_epi8(1);
+        __m128i reconA = _mm_setzero_si128();
+        for (std::size_t xByte = 0; xByte < rowWidth; xByte += pixelWidth)
+        {
+            __m128i const reconB = loadPixel<pixelWidth>(prevRow + xByte);
+            __m128i const filtered = loadPixel<pixelWidth>(filteredRow + xByte);
+            // _mm_avg_epu8 rounds up, the filter rounds down.
+            __m128i const roundingError = _mm_and_si128(_mm_xor_si128(reconA, reconB), ones);
+            __m128i const average = _mm_sub_epi8(_mm_avg_epu8(reconA, reconB), roundingError);
+            reconA = _mm_add_epi8(filtered, average);
+            storePixel<pixelWidth>(dstRow + xByte, reconA);
+        }
+    }
+
+    template<std::uint8_t pixelWidth>
+    static void defilterPaeth_SSE2(
+        std::byte* dstRow,
+        std::byte const* filteredRow,
+        std::byte const* prevRow,
+        std::size_t rowWidth) noexcept
+    {
+        // The predictor is evaluated in 16-bit lanes so the differences can't overflow.
+        __m128i const zero = _mm_setzero_si128();
+        __m128i reconA = zero;
+        __m128i reconC = zero;
+        for (std::size_t xByte = 0; xByte < rowWidth; xByte += pixelWidth)
+        {
+            __m128i const reconB = _mm_unpacklo_epi8(loadPixel<pixelWidth>(prevRow + xByte), zero);
+            __m128i const filtered = loadPixel<pixelWidth>(filteredRow + xByte);
+
+            __m128i pa = _mm_sub_epi16(reconB, reconC);
+            __m128i pb = _mm_sub_epi16(reconA, reconC);
+            __m128i pc = _mm_add_epi16(pa, pb);
+            pa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+            pb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+            pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+
+            // Ties are broken in the order a, b, c.
+            __m128i const smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+            __m128i const nearest = select(
+                _mm_cmpeq_epi16(smallest, pa),
+                reconA,
+                select(_mm_cmpeq_epi16(smallest, pb), reconB, reconC));
+
+            __m128i const recon = _mm_add_epi8(filtered, _mm_packus_epi16(nearest, nearest));
+            storePixel<pixelWidth>(dstRow + xByte, recon);
+
+            reconA = _mm_unpacklo_epi8(recon, zero);
+            reconC = reconB;
+        }
+    }
+#endif
+
+    template<std::uint8_t pixelWidth>
+    [[nodiscard]] static DefilterKernels selectKernels(CpuFeatures const& cpuFeatures) noexcept
+    {
+        DefilterKernels kernels{};
+        kernels.sub = &defilterSub_Scalar<pixelWidth>;
+        kernels.up = &defilterUp_Scalar;
+        kernels.average = &defilterAverage_Scalar<pixelWidth>;
+        kernels.averageFirstRow = &defilterAverageFirstRow_Scalar<pixelWidth>;
+        kernels.paeth = &defilterPaeth_Scalar<pixelWidth>;
+
+#if defined(TEXAS_HAS_SSE2)
+        kernels.sub = &defilterSub_SSE2<pixelWidth>;
+        kernels.up = cpuFeatures.avx2 ? &defilterUp_AVX2 : &defilterUp_SSE2;
+        if constexpr (pixelWidth >= 4)
+            kernels.average = &defilterAverage_SSE2<pixelWidth>;
+        if constexpr (pixelWidth >= 3)
+            kernels.paeth = &defilterPaeth_SSE2<pixelWidth>;
+#else
+        (void)cpuFeatures;
+#endif
+
+        return kernels;
+    }
+
+    struct DefilterKernelTable
+    {
+        // Indexed by pixel-width.
+        DefilterKernels kernels[9] = {};
+    };
+
+    [[nodiscard]] static DefilterKernelTable buildKernelTable() noexcept
+    {
+        CpuFeatures const& cpuFeatures = getCpuFeatures();
+        DefilterKernelTable table{};
+        table.kernels[1] = selectKernels<1>(cpuFeatures);
+        table.kernels[2] = selectKernels<2>(cpuFeatures);
+        table.kernels[3] = selectKernels<3>(cpuFeatures);
+        table.kernels[4] = selectKernels<4>(cpuFeatures);
+        table.kernels[6] = selectKernels<6>(cpuFeatures);
+        table.kernels[8] = selectKernels<8>(cpuFeatures);
+        return table;
+    }
+}
+
+Texas::detail::PNG::DefilterKernels const* Texas::detail::PNG::getDefilterKernels(std::uint8_t pixelWidth) noexcept
+{
+    static DefilterKernelTable const table = buildKernelTable();
+    if (pixelWidth >= 9 || table.kernels[pixelWidth].sub == nullptr)
+        return nullptr;
+    return &table.kernels[pixelWidth];
+}
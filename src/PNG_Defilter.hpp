@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Texas::detail::PNG
+{
+    /*
+        Reconstructs a single filtered row.
+        filteredRow does not include the filter-type byte. dstRow may point to the same memory as filteredRow.
+        prevRow is the previous reconstructed row. It is not read by the Sub and AverageFirstRow kernels.
+    */
+    using DefilterRowFn = void(*)(
+        std::byte* dstRow,
+        std::byte const* filteredRow,
+        std::byte const* prevRow,
+        std::size_t rowWidth) noexcept;
+
+    struct DefilterKernels
+    {
+        DefilterRowFn sub = nullptr;
+        DefilterRowFn up = nullptr;
+        DefilterRowFn average = nullptr;
+        // Average filter on the first row, where Recon(b) is always 0.
+        DefilterRowFn averageFirstRow = nullptr;
+        DefilterRowFn paeth = nullptr;
+    };
+
+    /*
+        Returns the fastest defilter kernels supported by the CPU for the given pixel-width.
+        The kernels are specialised for every pixel-width a PNG can have: 1, 2, 3, 4, 6 and 8 bytes.
+        Returns nullptr for any other pixel-width.
+    */
+    [[nodiscard]] DefilterKernels const* getDefilterKernels(std::uint8_t pixelWidth) noexcept;
+}
@@ -1,12 +1,29 @@
 #include "PNG.hpp"
+#include "PNG_Defilter.hpp"
+#include "Inflate.hpp"
 
 #include "PrivateAccessor.hpp"
 
+#if defined(TEXAS_ENABLE_FAST_INFLATE)
+#   include "FastInflate.hpp"
+#endif
+
+#if defined(TEXAS_ENABLE_PNG_CRC_CHECK)
+#   include "Crc32.hpp"
+#endif
+
 #include "zlib/zlib.h"
 
 // For std::memcpy and std::memcmp
 #include <cstring>
 
+#if defined(TEXAS_ENABLE_PNG_PIPELINING)
+#   include <atomic>
+#   include <condition_variable>
+#   include <mutex>
+#   include <thread>
+#endif
+
 namespace Texas::detail::PNG
 {
     using ChunkSize_T = std::uint32_t;
@@ -25,6 +42,8 @@ namespace Texas::detail::PNG
     constexpr auto IHDR_ChunkTypeValue = setupChunkTypeValue(73, 72, 68, 82);
     constexpr auto PLTE_ChunkTypeValue = setupChunkTypeValue(80, 76, 84, 69);
     constexpr auto IDAT_ChunkTypeValue = setupChunkTypeValue(73, 68, 65, 84);
+    // The 'Chunk type' field of IDAT chunks, as it's stored in the file.
+    constexpr std::byte idatChunkType[4] = { std::byte(73), std::byte(68), std::byte(65), std::byte(84) };
     constexpr auto IEND_ChunkTypeValue = setupChunkTypeValue(73, 69, 78, 68);
     constexpr auto cHRM_ChunkTypeValue = setupChunkTypeValue(99, 72, 82, 77);
     constexpr auto gAMA_ChunkTypeValue = setupChunkTypeValue(103, 65, 77, 65);
@@ -40,6 +59,42 @@ namespace Texas::detail::PNG
     constexpr auto iTXt_ChunkTypeValue = setupChunkTypeValue(105, 84, 88, 116);
     constexpr auto tEXt_ChunkTypeValue = setupChunkTypeValue(116, 69, 88, 116);
     constexpr auto zTXt_ChunkTypeValue = setupChunkTypeValue(122, 84, 88, 116);
+    constexpr auto iDOT_ChunkTypeValue = setupChunkTypeValue(105, 68, 79, 84);
+    constexpr auto txSG_ChunkTypeValue = setupChunkTypeValue(116, 120, 83, 71);
+
+    /*
+        Apple's 'iDOT' chunk splits the IDAT data in two segments. It's not documented,
+        but is known to hold 7 big-endian uint32 fields:
+         - The amount of segments, always 2.
+         - Always 0.
+         - Half the height of the image.
+         - Always 40.
+         - The amount of rows in the first segment.
+         - The amount of rows in the second segment.
+         - Offset from the start of the 'iDOT' chunk to the IDAT chunk where the second segment starts.
+    */
+    namespace iDOT
+    {
+        constexpr std::uint32_t chunkDataLength = 28;
+        constexpr std::size_t segmentCountOffset = 0;
+        constexpr std::size_t firstRowCountOffset = 16;
+        constexpr std::size_t secondRowCountOffset = 20;
+        constexpr std::size_t secondChunkOffsetOffset = 24;
+    }
+
+    /*
+        'txSG' is Texas' own ancillary chunk, written by Texas::PNG::saveToStream.
+        It works the same way as 'iDOT', for any amount of segments.
+        It holds 8 bytes for each segment after the first, two big-endian uint32 fields:
+         - The first row the segment decompresses to.
+         - Offset from the start of the 'txSG' chunk to the IDAT chunk where the segment starts.
+    */
+    namespace txSG
+    {
+        constexpr std::uint32_t segmentEntrySize = 8;
+        constexpr std::uint32_t maxChunkDataLength = 
+            segmentEntrySize * (FileInfo_PNG_BackendData::maxSegmentCount - 1);
+    }
 
     namespace Header
     {
@@ -55,13 +110,14 @@ namespace Texas::detail::PNG
         constexpr std::size_t filterMethodOffset = 27;
         constexpr std::size_t interlaceMethodOffset = 28;
 
+        constexpr std::size_t ihdrChunkCrcOffset = 29;
+
         // Total size of all header data.
         constexpr std::size_t totalSize = 33;
     };
 
     enum class ColorType : char;
     enum class ChunkType : char;
-    enum class FilterType : char;
 
     // Turns a 32-bit unsigned integer into correct endian, regardless of system endianness.
     [[nodiscard]] static std::uint32_t toCorrectEndian_u32(std::byte const* ptr) noexcept;
@@ -70,17 +126,42 @@ namespace Texas::detail::PNG
 
     [[nodiscard]] static PNG::ChunkType getChunkType(std::byte const* in) noexcept;
 
+    // Ancillary chunks can be skipped by decoders that don't know them. The rest are critical.
+    [[nodiscard]] static bool isAncillaryChunk(std::byte const* chunkType) noexcept;
+
+    /*
+        Reads the segments of an 'iDOT' or 'txSG' chunk into backendData.
+        They are only a hint, so a chunk that doesn't make sense is ignored
+        and the image-data is decompressed as one.
+    */
+    static void parseSegmentChunk(
+        PNG::ChunkType chunkType,
+        ConstByteSpan chunkData,
+        std::size_t chunkStreamPos,
+        std::uint32_t height,
+        detail::FileInfo_PNG_BackendData& backendData) noexcept;
+
     [[nodiscard]] static PixelFormat toPixelFormat(PNG::ColorType colorType, std::uint8_t bitDepth) noexcept;
 
     [[nodiscard]] static std::uint8_t getPixelWidth(PixelFormat pixelFormat) noexcept;
 
-    [[nodiscard]] static inline std::uint8_t paethPredictor(std::uint8_t a, std::uint8_t b, std::uint8_t c) noexcept;
-
     [[nodiscard]] static std::uint64_t calcWorkingMemRequired_Stream(
         Dimensions baseDims,
         PixelFormat pFormat,
-        bool isIndexed,
-        detail::FileInfo_PNG_BackendData const& backendData) noexcept;
+        bool isIndexed) noexcept;
+
+    /*
+        Size of the buffer IDAT chunk data gets streamed through on its way to zLib.
+        IDAT chunks are read in pieces when they are larger than this buffer.
+        It's fixed, because a parsed FileInfo may only know about the first IDAT chunk,
+        and one small IDAT chunk says nothing about the size of the ones after it.
+    */
+    constexpr std::uint32_t idatInputBufferSize = 1 << 15;
+
+    [[nodiscard]] static std::uint64_t calcWorkingMemRequired_RowStreaming(
+        Dimensions baseDims,
+        PixelFormat pFormat,
+        bool isIndexed) noexcept;
 
     /*
         Defilters uncompressed data and immediately copies the result over to dstMem.
@@ -89,6 +170,7 @@ namespace Texas::detail::PNG
     [[nodiscard]] static Result defilterIntoDstBuffer(
         TextureInfo const& textureInfo, 
         ByteSpan dstMem, 
+        std::size_t dstRowPitch,
         ByteSpan uncompressedData) noexcept;
 
     /*
@@ -103,14 +185,346 @@ namespace Texas::detail::PNG
 
     [[nodiscard]] static Result deindexData(
         Dimensions baseDims,
-        ByteSpan paletteData,
+        ConstByteSpan paletteData,
         ByteSpan dstImageBuffer,
+        std::size_t dstRowPitch,
         ByteSpan defilteredIndices);
 
+    template<typename StreamT>
     [[nodiscard]] static Result decompressIdatChunks_Stream(
-        InputStream& stream,
+        StreamT& stream,
+        InflateContext& inflateContext,
+        detail::FileInfo_PNG_BackendData const& backendData,
         ByteSpan dst_filteredData,
+        ByteSpan inputBuffer) noexcept;
+
+    /*
+        Defilters a single row and writes the result to dstRow.
+        filteredRow does not include the filter-type byte. dstRow may point to the same memory as filteredRow.
+        prevRow is the previous defiltered row, or nullptr when defiltering the first row.
+    */
+    [[nodiscard]] static Result defilterRow(
+        PNG::FilterType filterType,
+        std::byte* dstRow,
+        std::byte const* filteredRow,
+        std::byte const* prevRow,
+        std::size_t rowWidth,
+        std::uint8_t pixelWidth) noexcept;
+
+    [[nodiscard]] static Result deindexRow(
+        ConstByteSpan paletteData,
+        std::byte* dstRow,
+        std::byte const* indices,
+        std::size_t width) noexcept;
+
+    /*
+        Moves the stream to the data of the first IDAT chunk.
+        Does not seek if the stream is already there, such as right after the file
+        has been probed, so streams that can not seek can still be decoded.
+    */
+    template<typename StreamT>
+    static void seekToFirstIdatData(
+        StreamT& stream,
+        detail::FileInfo_PNG_BackendData const& backendData) noexcept;
+
+    // Passes access on to the stream as a hint for where the IDAT chunks are in it.
+    template<typename StreamT>
+    static void hintIdatChunks(
+        StreamT& stream,
+        detail::FileInfo_PNG_BackendData const& backendData,
+        InputStream::AccessHint access) noexcept;
+
+    /*
+        Continues the CRC of a chunk's type and data over data.
+        Only does anything when TEXAS_ENABLE_PNG_CRC_CHECK is defined, CRCs are not checked otherwise.
+    */
+    [[nodiscard]] static std::uint32_t updateChunkCrc(std::uint32_t chunkCrc, ConstByteSpan data) noexcept;
+
+    // Compares a chunk's CRC field to the CRC calculated with updateChunkCrc.
+    [[nodiscard]] static Result checkChunkCrc(std::byte const* crcField, std::uint32_t chunkCrc) noexcept;
+
+    // Moves the stream past the CRC field at the end of a chunk, and checks it against chunkCrc.
+    template<typename StreamT>
+    [[nodiscard]] static Result endChunk(StreamT& stream, std::uint32_t chunkCrc) noexcept;
+
+    // Where we are in the chain of IDAT chunks, for readIdatData_Stream.
+    struct IdatCursor
+    {
+        // Amount of bytes left to read from the IDAT chunk we are currently in.
+        std::uint32_t chunkDataRemaining = 0;
+        // CRC of the current chunk's type and the data read from it so far, see updateChunkCrc.
+        std::uint32_t chunkCrc = 0;
+        // Set once the 'Length' and 'Chunk type' fields of the chunk after the IDAT chunks have been read.
+        bool chunksEnded = false;
+    };
+
+    // Cursor for a stream placed at the data of the first IDAT chunk.
+    [[nodiscard]] static IdatCursor makeIdatCursor(detail::FileInfo_PNG_BackendData const& backendData) noexcept;
+
+    /*
+        Points cursor at the data of the chunk whose 'Length' and 'Chunk type' fields are in chunkLengthAndType.
+        Returns false if it's not an IDAT chunk.
+    */
+    [[nodiscard]] static bool beginIdatChunk(std::byte const* chunkLengthAndType, IdatCursor& cursor) noexcept;
+
+    /*
+        Gets the next piece of IDAT data, moving on to the next
+        IDAT chunk when the current one has been used up.
+        idatData points straight into the stream if it can hand out the rest of the chunk
+        with acquire(), otherwise the data is read into inputBuffer.
+        The CRC of each chunk is checked once all of its data has been handed out.
+    */
+    template<typename StreamT>
+    [[nodiscard]] static Result readIdatData_Stream(
+        StreamT& stream,
+        ByteSpan inputBuffer,
+        IdatCursor& cursor,
+        ConstByteSpan& idatData) noexcept;
+
+#if defined(TEXAS_ENABLE_FAST_INFLATE)
+    // Hands the IDAT data to fastInflate through readIdatData_Stream.
+    template<typename StreamT>
+    class IdatInflateSource final : public FastInflateSource
+    {
+    public:
+        IdatInflateSource(StreamT& stream, ByteSpan inputBuffer, IdatCursor const& cursor) noexcept :
+            m_stream(&stream),
+            m_inputBuffer(inputBuffer),
+            m_cursor(cursor)
+        {
+        }
+
+        [[nodiscard]] virtual ConstByteSpan next() noexcept override
+        {
+            ConstByteSpan idatData = {};
+            m_result = readIdatData_Stream(*m_stream, m_inputBuffer, m_cursor, idatData);
+            if (!m_result.isSuccessful())
+                return {};
+            return idatData;
+        }
+
+        // The error from reading the IDAT chunks, if the data ran out because of one.
+        [[nodiscard]] Result const& result() const noexcept
+        {
+            return m_result;
+        }
+
+        // Where the source is in the IDAT chunks, after the data it handed out last.
+        [[nodiscard]] IdatCursor& cursor() noexcept
+        {
+            return m_cursor;
+        }
+
+    private:
+        StreamT* m_stream = nullptr;
+        ByteSpan m_inputBuffer = {};
+        IdatCursor m_cursor = {};
+        Result m_result = { ResultType::Success, nullptr };
+    };
+#endif
+
+    // Everything decodeRow needs to know about the image, that is the same for every row.
+    struct RowDecodeInfo
+    {
+        bool isIndexed = false;
+        // Size is in bytes.
+        std::uint8_t pixelWidth = 0;
+        std::size_t width = 0;
+        // Size is in bytes. Does not include the byte for filter-type.
+        std::size_t rowWidth = 0;
+        ConstByteSpan paletteData = {};
+        ByteSpan dstImageBuffer = {};
+        std::size_t dstRowPitch = 0;
+    };
+
+    [[nodiscard]] static RowDecodeInfo makeRowDecodeInfo(
+        TextureInfo const& textureInfo,
+        detail::FileInfo_PNG_BackendData const& backendData,
+        ByteSpan dstImageBuffer,
+        std::size_t dstRowPitch) noexcept;
+
+    /*
+        Decompresses the next row of filtered data, including its filter-type byte, into filteredRow.
+        IDAT data is read through inputBuffer whenever zLib has used up what it had.
+    */
+    template<typename StreamT>
+    [[nodiscard]] static Result inflateRow(
+        StreamT& stream,
+        z_stream& zLibDecompressJob,
+        ByteSpan inputBuffer,
+        IdatCursor& cursor,
+        std::byte* filteredRow,
+        std::size_t totalRowWidth) noexcept;
+
+    /*
+        Runs zLib on to the end of the data-stream once every row has been decompressed,
+        since that is where it checks the Adler-32. Fails if anything more decompresses out of it.
+        Then reads the rest of the IDAT chunks, see readRestOfIdatChunks_Stream.
+    */
+    template<typename StreamT>
+    [[nodiscard]] static Result finishInflate_Stream(
+        StreamT& stream,
+        detail::FileInfo_PNG_BackendData const& backendData,
+        z_stream& zLibDecompressJob,
+        ByteSpan inputBuffer,
+        IdatCursor& cursor) noexcept;
+
+    /*
+        zLib can be done with the IDAT data before the chunk it's in is, and files can have
+        IDAT chunks after the end of the data-stream. Reads the rest of those chunks,
+        so their CRCs get checked, and the stream ends up after the last one.
+        Probed files don't tell us where the IDAT chunks end, so with CRC checks on
+        we read the header of each chunk after the current one until it isn't an IDAT,
+        and the stream is left after that header. Without them only the rest of the
+        current chunk is read.
+    */
+    template<typename StreamT>
+    [[nodiscard]] static Result readRestOfIdatChunks_Stream(
+        StreamT& stream,
+        detail::FileInfo_PNG_BackendData const& backendData,
+        ByteSpan inputBuffer,
+        IdatCursor& cursor) noexcept;
+
+    /*
+        Defilters row y, which starts with its filter-type byte, and writes its pixels to the destination buffer.
+        For indexed colours the indices are defiltered in place, and prevFilteredRow 
+        must be the previous row, after it went through this function.
+    */
+    [[nodiscard]] static Result decodeRow(
+        RowDecodeInfo const& info,
+        std::uint32_t y,
+        std::byte* filteredRow,
+        std::byte const* prevFilteredRow) noexcept;
+
+    /*
+        Decodes the image one row at a time, so that only a few rows 
+        of filtered data have to be held in working memory.
+    */
+    template<typename StreamT>
+    [[nodiscard]] static Result loadRows_Stream(
+        StreamT& stream,
+        InflateContext& inflateContext,
+        TextureInfo const& textureInfo,
+        detail::FileInfo_PNG_BackendData const& backendData,
+        ByteSpan dstImageBuffer,
+        std::size_t dstRowPitch,
+        ByteSpan workingMem) noexcept;
+
+#if defined(TEXAS_ENABLE_PNG_PIPELINING)
+    // Images with less filtered data than this are not worth starting another thread for.
+    constexpr std::uint64_t minPipelinedFilteredDataSize = 1 << 22;
+    // About the amount of filtered data the ring buffer between the two threads holds.
+    constexpr std::size_t pipelineRingTargetSize = 1 << 18;
+    constexpr std::uint32_t pipelineRingMinRowCount = 4;
+
+    [[nodiscard]] static std::uint32_t calcPipelineRingRowCount(std::size_t totalRowWidth, std::uint32_t height) noexcept;
+
+    /*
+        Shared by the thread that inflates rows into the ring buffer, and the thread that defilters them.
+        Either side only locks the mutex when it has to wait, or when the other side is waiting.
+    */
+    struct RowPipeline
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::atomic<std::uint32_t> waiterCount{ 0 };
+        std::atomic<std::uint32_t> rowsInflated{ 0 };
+        std::atomic<std::uint32_t> rowsDecoded{ 0 };
+        std::atomic<bool> failed{ false };
+    };
+
+    // Stores value in counter, and wakes up the other side if it's waiting.
+    static void publishRowPipeline(
+        RowPipeline& pipeline,
+        std::atomic<std::uint32_t>& counter,
+        std::uint32_t value) noexcept;
+
+    // Tells the other side to stop, and wakes it up if it's waiting.
+    static void failRowPipeline(RowPipeline& pipeline) noexcept;
+
+    // Blocks until rowCount is more than minRowCount, or the pipeline has failed.
+    static void waitRowPipeline(
+        RowPipeline& pipeline,
+        std::atomic<std::uint32_t> const& rowCount,
+        std::uint32_t minRowCount) noexcept;
+
+    /*
+        Same as loadRows_Stream, but rows are defiltered on another thread 
+        while the calling thread inflates the next ones into a ring buffer.
+        workingMem must be atleast calcWorkingMemRequired_Pipelined bytes.
+    */
+    template<typename StreamT>
+    [[nodiscard]] static Result loadRows_Pipelined(
+        StreamT& stream,
+        InflateContext& inflateContext,
+        TextureInfo const& textureInfo,
+        detail::FileInfo_PNG_BackendData const& backendData,
+        ByteSpan dstImageBuffer,
+        std::size_t dstRowPitch,
+        ByteSpan workingMem) noexcept;
+
+    // One segment of IDAT data, and what became of it, for loadSegments_Parallel.
+    struct SegmentJob
+    {
+        // The IDAT chunks of the segment, including their length, type and CRC fields.
+        ConstByteSpan chunks = {};
+        std::uint32_t firstRow = 0;
+        std::uint32_t rowCount = 0;
+        bool isFirst = false;
+        bool isLast = false;
+
+        bool inflated = false;
+        // Adler-32 of the filtered rows the segment decompressed to.
+        std::uint32_t adler = 0;
+        // Only read by the last segment. The checksum at the end of the zLib data-stream.
+        std::uint32_t storedAdler = 0;
+        bool defiltered = false;
+    };
+
+    /*
+        Decompresses the segment into filteredRows, which must be exactly the size of its rows.
+        Returns false if it does not decompress to exactly that, on its own.
+    */
+    [[nodiscard]] static bool inflateSegment(SegmentJob& job, ByteSpan filteredRows) noexcept;
+
+    /*
+        Decompresses the segment into its rows of filteredData, then decodes them
+        if its first row does not depend on the row above it.
+    */
+    static void decodeSegment(SegmentJob& job, RowDecodeInfo const& info, std::byte* filteredData) noexcept;
+
+    /*
+        Decodes an image whose IDAT data is split in segments on one thread per segment.
+        Segments whose first row depends on the row above it are defiltered
+        on the calling thread, after all the others are done.
+
+        The stream must hand out all of its IDAT chunks with acquire(), 
+        workingMem must be atleast calcWorkingMemRequired_Stream bytes.
+        Returns false if the image could not be decoded this way, for example if 
+        the segments do not decompress on their own. The stream is left where it was,
+        so the image can be decoded the regular way, which reports what was wrong with it.
+        On success, the stream is left right after the last IDAT chunk.
+    */
+    template<typename StreamT>
+    [[nodiscard]] static bool loadSegments_Parallel(
+        StreamT& stream,
+        TextureInfo const& textureInfo,
+        detail::FileInfo_PNG_BackendData const& backendData,
+        ByteSpan dstImageBuffer,
+        std::size_t dstRowPitch,
         ByteSpan workingMem) noexcept;
+#endif
+
+    /*
+        Decompresses the piece of IDAT data in input, and decodes every row it finishes.
+        Stops early once every row has been decoded.
+    */
+    [[nodiscard]] static Result inflateRows_Incremental(
+        detail::IncrementalDecoder_PNG_BackendData& state,
+        TextureInfo const& textureInfo,
+        detail::FileInfo_PNG_BackendData const& backendData,
+        ByteSpan dstImageBuffer,
+        ConstByteSpan input) noexcept;
 }
 
 enum class Texas::detail::PNG::ColorType : char
@@ -152,16 +566,12 @@ enum class Texas::detail::PNG::ChunkType : char
     tEXt,
     zTXt,
 
-    COUNT
-};
+    // Segments of IDAT data that can be decompressed in parallel
 
-enum class Texas::detail::PNG::FilterType : char
-{
-    None = 0,
-    Sub = 1,
-    Up = 2,
-    Average = 3,
-    Paeth = 4,
+    iDOT,
+    txSG,
+
+    COUNT
 };
 
 static std::uint32_t Texas::detail::PNG::toCorrectEndian_u32(std::byte const* ptr)  noexcept
@@ -257,11 +667,76 @@ static Texas::detail::PNG::ChunkType Texas::detail::PNG::getChunkType(std::byte
         return ChunkType::tEXt;
     case zTXt_ChunkTypeValue:
         return ChunkType::zTXt;
+    case iDOT_ChunkTypeValue:
+        return ChunkType::iDOT;
+    case txSG_ChunkTypeValue:
+        return ChunkType::txSG;
     default:
         return ChunkType::Invalid;
     }
 }
 
+static bool Texas::detail::PNG::isAncillaryChunk(std::byte const* chunkType) noexcept
+{
+    // Bit 5 of the first byte, lowercase letters are ancillary.
+    return (static_cast<std::uint8_t>(chunkType[0]) & 0x20) != 0;
+}
+
+static void Texas::detail::PNG::parseSegmentChunk(
+    PNG::ChunkType chunkType,
+    ConstByteSpan chunkData,
+    std::size_t chunkStreamPos,
+    std::uint32_t height,
+    detail::FileInfo_PNG_BackendData& backendData) noexcept
+{
+    std::uint32_t segmentCount = 0;
+    std::uint32_t segmentFirstRows[FileInfo_PNG_BackendData::maxSegmentCount] = {};
+    std::size_t segmentChunkStreamPos[FileInfo_PNG_BackendData::maxSegmentCount] = {};
+    if (chunkType == ChunkType::iDOT)
+    {
+        if (chunkData.size() != iDOT::chunkDataLength)
+            return;
+        std::uint32_t const firstRowCount = PNG::toCorrectEndian_u32(chunkData.data() + iDOT::firstRowCountOffset);
+        std::uint32_t const secondRowCount = PNG::toCorrectEndian_u32(chunkData.data() + iDOT::secondRowCountOffset);
+        if (PNG::toCorrectEndian_u32(chunkData.data() + iDOT::segmentCountOffset) != 2 ||
+            firstRowCount == 0 || 
+            secondRowCount == 0 ||
+            std::uint64_t(firstRowCount) + secondRowCount != height)
+            return;
+        segmentCount = 2;
+        segmentFirstRows[1] = firstRowCount;
+        segmentChunkStreamPos[1] = chunkStreamPos + PNG::toCorrectEndian_u32(chunkData.data() + iDOT::secondChunkOffsetOffset);
+    }
+    else
+    {
+        if (chunkData.size() == 0 || chunkData.size() % txSG::segmentEntrySize != 0)
+            return;
+        segmentCount = static_cast<std::uint32_t>(chunkData.size() / txSG::segmentEntrySize) + 1;
+        for (std::uint32_t i = 1; i < segmentCount; i++)
+        {
+            std::byte const* const entry = chunkData.data() + (i - 1) * txSG::segmentEntrySize;
+            segmentFirstRows[i] = PNG::toCorrectEndian_u32(entry);
+            segmentChunkStreamPos[i] = chunkStreamPos + PNG::toCorrectEndian_u32(entry + 4);
+        }
+    }
+
+    // Every segment must have rows of its own, and start after the one before it.
+    for (std::uint32_t i = 1; i < segmentCount; i++)
+    {
+        if (segmentFirstRows[i] <= segmentFirstRows[i - 1] || segmentFirstRows[i] >= height)
+            return;
+        if (segmentChunkStreamPos[i] <= segmentChunkStreamPos[i - 1] || segmentChunkStreamPos[i] <= chunkStreamPos)
+            return;
+    }
+
+    backendData.segmentCount = segmentCount;
+    for (std::uint32_t i = 0; i < segmentCount; i++)
+    {
+        backendData.segmentFirstRows[i] = segmentFirstRows[i];
+        backendData.segmentChunkStreamPos[i] = segmentChunkStreamPos[i];
+    }
+}
+
 static Texas::PixelFormat Texas::detail::PNG::toPixelFormat(
     PNG::ColorType colorType, 
     std::uint8_t bitDepth) noexcept
@@ -325,18 +800,14 @@ static Texas::PixelFormat Texas::detail::PNG::toPixelFormat(
 static std::uint64_t Texas::detail::PNG::calcWorkingMemRequired_Stream(
     Dimensions baseDims,
     PixelFormat pFormat,
-    bool isIndexed,
-    detail::FileInfo_PNG_BackendData const& backendData) noexcept
+    bool isIndexed) noexcept
 {
     std::uint64_t sum = 0;
         
-    sum += backendData.maxIdatChunkDataLength;
+    sum += idatInputBufferSize;
 
     if (isIndexed)
     {
-        if (backendData.plteChunkDataLength > backendData.maxIdatChunkDataLength)
-            sum += backendData.plteChunkDataLength - backendData.maxIdatChunkDataLength;
-
         // One byte per index, one byte extra per row for filter-method.
         sum += baseDims.width * baseDims.height + baseDims.height;
     }
@@ -351,6 +822,31 @@ static std::uint64_t Texas::detail::PNG::calcWorkingMemRequired_Stream(
     return sum;
 }
 
+static std::uint64_t Texas::detail::PNG::calcWorkingMemRequired_RowStreaming(
+    Dimensions baseDims,
+    PixelFormat pFormat,
+    bool isIndexed) noexcept
+{
+    std::uint64_t sum = 0;
+
+    sum += idatInputBufferSize;
+
+    if (isIndexed)
+    {
+        // We need the current and the previous row of indices, 
+        // each with one byte extra for the filter-method.
+        sum += 2 * (baseDims.width + 1);
+    }
+    else
+    {
+        // Only the current filtered row needs to be stored,
+        // the previous row has already been defiltered into the destination buffer.
+        sum += baseDims.width * getPixelWidth(pFormat) + 1;
+    }
+
+    return sum;
+}
+
 static std::uint8_t Texas::detail::PNG::getPixelWidth(PixelFormat pixelFormat) noexcept
 {
     switch (pixelFormat)
@@ -368,36 +864,15 @@ static std::uint8_t Texas::detail::PNG::getPixelWidth(PixelFormat pixelFormat) n
     }
 }
 
-static std::uint8_t Texas::detail::PNG::paethPredictor(
-    std::uint8_t a, 
-    std::uint8_t b, 
-    std::uint8_t c) noexcept
-{
-    std::int32_t const p = std::int32_t(a) + b - c;
-
-    std::int32_t pa = p - a;
-    if (pa < 0)
-        pa = -pa;
-    std::int32_t pb = p - b;
-    if (pb < 0)
-        pb = -pb;
-    std::int32_t pc = p - c;
-    if (pc < 0)
-        pc = -pc;
-
-    if (pa <= pb && pa <= pc)
-        return a;
-    else if (pb <= pc)
-        return b;
-    else
-        return c;
-}
-
+template<typename StreamT>
 Texas::Result Texas::detail::PNG::parseStream(
-    InputStream& stream,
+    StreamT& stream,
     TextureInfo& textureInfo,
     std::uint64_t& workingMemRequired,
-    detail::FileInfo_PNG_BackendData& backendData) noexcept
+    std::uint64_t& minWorkingMemRequired,
+    detail::FileInfo_PNG_BackendData& backendData,
+    ConstByteSpan fileStart,
+    bool stopAtFirstIdat) noexcept
 {
     backendData = detail::FileInfo_PNG_BackendData();
     textureInfo.fileFormat = FileFormat::PNG;
@@ -410,8 +885,10 @@ Texas::Result Texas::detail::PNG::parseStream(
 
     Result result{};
 
+    // The start of the file has already been read to identify it.
     std::byte headerBuffer[Header::totalSize] = {};
-    result = stream.read({ headerBuffer, Header::totalSize });
+    std::memcpy(headerBuffer, fileStart.data(), fileStart.size());
+    result = stream.read({ headerBuffer + fileStart.size(), Header::totalSize - fileStart.size() });
     if (!result.isSuccessful())
         return result;
 
@@ -427,6 +904,12 @@ Texas::Result Texas::detail::PNG::parseStream(
                  "PNG first chunk is not of type 'IHDR'. "
                  "PNG requires the 'IHDR' chunk to appear first in the filestream." };
 
+    result = PNG::checkChunkCrc(
+        headerBuffer + Header::ihdrChunkCrcOffset, 
+        PNG::updateChunkCrc(0, { ihdrChunkType, sizeof(ChunkType_T) + Header::ihdrChunkDataSize }));
+    if (!result.isSuccessful())
+        return result;
+
     // Dimensions are stored in big endian, we must convert to correct endian.
     std::uint32_t const origWidth = PNG::toCorrectEndian_u32(headerBuffer + Header::widthOffset);
     if (origWidth == 0)
@@ -483,9 +966,14 @@ Texas::Result Texas::detail::PNG::parseStream(
         std::uint32_t const chunkDataLength = PNG::toCorrectEndian_u32(chunkLengthAndTypeBuffer);
         // Chunk type appears after chunk-data-length, so we offset 4 bytes extra.
         PNG::ChunkType const chunkType = PNG::getChunkType(chunkLengthAndTypeBuffer + sizeof(PNG::ChunkSize_T));
-        if (chunkType == PNG::ChunkType::Invalid)
+        // Decoders are required to skip ancillary chunks they don't know.
+        if (chunkType == PNG::ChunkType::Invalid && !PNG::isAncillaryChunk(chunkLengthAndTypeBuffer + sizeof(PNG::ChunkSize_T)))
             return { ResultType::CorruptFileData, 
-                     "Encountered a PNG chunk type not defined in the PNG specification." };
+                     "Encountered a critical PNG chunk type not defined in the PNG specification." };
+        // Amount of the chunk's data we have read so far.
+        std::uint32_t chunkDataRead = 0;
+        // The CRC can only be checked for chunks we read all of, which are the ones we use.
+        std::uint32_t chunkCrc = PNG::updateChunkCrc(0, { chunkLengthAndTypeBuffer + sizeof(PNG::ChunkSize_T), sizeof(ChunkType_T) });
 
         switch (chunkType)
         {
@@ -499,10 +987,13 @@ Texas::Result Texas::detail::PNG::parseStream(
                          "PNG IDAT chunk's `Length' field is 0. PNG specification requires it to be >0." };
 
             if (chunkTypeCounts[(std::size_t)PNG::ChunkType::IDAT] == 0)
+            {
                 // We subtract 8 because the chunk started 8 bytes ago.
                 backendData.firstIdatChunkStreamPos = stream.tell() - 8;
-            if (chunkDataLength > backendData.maxIdatChunkDataLength)
-                backendData.maxIdatChunkDataLength = chunkDataLength;
+                backendData.firstIdatChunkDataLength = chunkDataLength;
+                if (backendData.segmentCount != 0)
+                    backendData.segmentChunkStreamPos[0] = backendData.firstIdatChunkStreamPos;
+            }
             break;
 
         case ChunkType::IEND:
@@ -529,7 +1020,7 @@ Texas::Result Texas::detail::PNG::parseStream(
                 return { ResultType::CorruptFileData , 
                          "PNG PLTE chunk has field 'Data length' equal to 0. "
                          "PNG specification requires PLTE data length to be non-zero. " };
-            if (chunkDataLength > 768)
+            if (chunkDataLength > FileInfo_PNG_BackendData::maxPlteChunkDataLength)
                 return { ResultType::CorruptFileData , 
                          "PNG PLTE chunk has field 'Data length' higher than 768 bytes. "
                          "PNG specification requires PLTE data length to be smaller than or equal to 768 bytes." };
@@ -538,8 +1029,15 @@ Texas::Result Texas::detail::PNG::parseStream(
                          "PNG PLTE chunk field 'Data length' value not divisible by 3. "
                          "PNG specification requires PLTE data length be divisible by 3." };
 
-            // We subtract 8 bytes to get back to the start of the chunk
-            backendData.plteChunkStreamPos = stream.tell() - 8;
+            // Truecolour images can have a suggested palette, we have no use for it.
+            if (colorType != PNG::ColorType::Indexed_colour)
+                break;
+            // Keep the colours so we don't have to come back for them when decoding.
+            result = stream.read({ backendData.plteChunkData, chunkDataLength });
+            if (!result.isSuccessful())
+                return result;
+            chunkDataRead = chunkDataLength;
+            chunkCrc = PNG::updateChunkCrc(chunkCrc, { backendData.plteChunkData, chunkDataLength });
             backendData.plteChunkDataLength = chunkDataLength;
             break;
 
@@ -590,13 +1088,54 @@ Texas::Result Texas::detail::PNG::parseStream(
 
             break;
 
+        case ChunkType::iDOT:
+        case ChunkType::txSG:
+        {
+            // Segments only make sense before the data they describe, and a file can only have one set of them.
+            if (chunkTypeCounts[(std::size_t)PNG::ChunkType::IDAT] > 0 || backendData.segmentCount != 0)
+                break;
+            if (chunkDataLength > txSG::maxChunkDataLength)
+                break;
+            std::byte segmentChunkData[txSG::maxChunkDataLength] = {};
+            result = stream.read({ segmentChunkData, chunkDataLength });
+            if (!result.isSuccessful())
+                return result;
+            chunkDataRead = chunkDataLength;
+            chunkCrc = PNG::updateChunkCrc(chunkCrc, { segmentChunkData, chunkDataLength });
+            // We subtract 8 because the chunk started 8 bytes ago, and we have read its data since.
+            std::size_t const chunkStreamPos = stream.tell() - chunkDataLength - 8;
+            PNG::parseSegmentChunk(
+                chunkType, 
+                { segmentChunkData, chunkDataLength }, 
+                chunkStreamPos, 
+                origHeight, 
+                backendData);
+            break;
+        }
+
         default:
             break;
         };
 
+        if (stopAtFirstIdat && chunkType == ChunkType::IDAT)
+        {
+            // Everything we need to know appears before the first IDAT chunk.
+            chunkTypeCounts[(std::size_t)chunkType] += 1;
+            break;
+        }
         
-        // We ignore the chunk data and CRC part of the chunk
-        stream.ignore(chunkDataLength + sizeof(ChunkType_T));
+        // We ignore the rest of the chunk data and CRC part of the chunk, unless we read all of its data.
+        // IDAT chunks are checked when they are decompressed instead.
+        if (chunkDataRead < chunkDataLength)
+            stream.ignore(chunkDataLength - chunkDataRead + sizeof(ChunkCRC_T));
+        else
+        {
+            result = PNG::endChunk(stream, chunkCrc);
+            if (!result.isSuccessful())
+                return result;
+        }
+        if (chunkType == ChunkType::IDAT)
+            backendData.idatChunksEndStreamPos = stream.tell();
         chunkTypeCounts[(std::size_t)chunkType] += 1;
         previousChunkType = chunkType;
     }
@@ -605,7 +1144,7 @@ Texas::Result Texas::detail::PNG::parseStream(
         return { ResultType::CorruptFileData, 
                  "Found no IDAT chunk in PNG file. "
                  "PNG specification requires the file to have atleast one IDAT chunk." };
-    if (chunkTypeCounts[(std::size_t)PNG::ChunkType::IEND] == 0)
+    if (!stopAtFirstIdat && chunkTypeCounts[(std::size_t)PNG::ChunkType::IEND] == 0)
         return { ResultType::CorruptFileData, 
                  "Found no IEND chunk in PNG file. "
                  "PNG specification requires the file to have exactly one IEND chunk." };
@@ -620,16 +1159,23 @@ Texas::Result Texas::detail::PNG::parseStream(
     workingMemRequired = calcWorkingMemRequired_Stream(
         textureInfo.baseDimensions,
         textureInfo.pixelFormat,
-        isIndexedColor,
-        backendData);
+        isIndexedColor);
+    minWorkingMemRequired = calcWorkingMemRequired_RowStreaming(
+        textureInfo.baseDimensions,
+        textureInfo.pixelFormat,
+        isIndexedColor);
+    // Tiny images can need less memory when decoded all at once.
+    if (workingMemRequired < minWorkingMemRequired)
+        minWorkingMemRequired = workingMemRequired;
 
     return { ResultType::Success, nullptr };
 }
 
 static Texas::Result Texas::detail::PNG::deindexData(
     Dimensions baseDims,
-    ByteSpan paletteData,
+    ConstByteSpan paletteData,
     ByteSpan dstImageBuffer,
+    std::size_t dstRowPitch,
     ByteSpan defilteredIndices)
 {
     std::byte const* const paletteColors = paletteData.data();
@@ -637,7 +1183,7 @@ static Texas::Result Texas::detail::PNG::deindexData(
 
     for (std::uint32_t y = 0; y < static_cast<std::uint32_t>(baseDims.height); y++)
     {
-        std::size_t const rowIndicesOffset = 1 + (y * (baseDims.height + 1));
+        std::size_t const rowIndicesOffset = 1 + (y * (baseDims.width + 1));
         // Pointer to the row of indices, does not include the filter-type byte.
         std::byte const* const rowIndices = defilteredIndices.data() + rowIndicesOffset;
 
@@ -648,7 +1194,7 @@ static Texas::Result Texas::detail::PNG::deindexData(
                 return { ResultType::CorruptFileData, "Encountered an out-of-bounds index while de-indexing PNG file." };
             std::byte const* colorPalettePtr = paletteColors + static_cast<std::size_t>(paletteIndex) * 3;
 
-            std::size_t const dstBufferOffset = (y * static_cast<std::size_t>(baseDims.height) + x) * 3;
+            std::size_t const dstBufferOffset = y * dstRowPitch + static_cast<std::size_t>(x) * 3;
             std::memcpy(dstImageBuffer.data() + dstBufferOffset, colorPalettePtr, 3);
         }
     }
@@ -659,6 +1205,7 @@ static Texas::Result Texas::detail::PNG::deindexData(
 static Texas::Result Texas::detail::PNG::defilterIntoDstBuffer(
     TextureInfo const& textureInfo, 
     ByteSpan dstMem, 
+    std::size_t dstRowPitch,
     ByteSpan filteredData) noexcept
 {
     std::byte const* const filteredDataPtr = filteredData.data();
@@ -673,141 +1220,16 @@ static Texas::Result Texas::detail::PNG::defilterIntoDstBuffer(
     // Includes the byte for filter-type.
     std::size_t const totalRowWidth = rowWidth + 1;
 
-    // Unfilter first row
-    {
-        PNG::FilterType const filterType = static_cast<PNG::FilterType>(filteredDataPtr[0]);
-        switch (filterType)
-        {
-        case FilterType::None:
-        case FilterType::Up:
-            // If FilterType is None, then we just copy the entire row as it is over.
-            // If FilterType is Up, we copy all the bytes of the previous, but since there is no row above, 
-            // it just adds 0 to the entire row, so we just copy all of it over to destination buffer.
-            std::memcpy(dstBuffer, &filteredDataPtr[1], rowWidth);
-            break;
-        case FilterType::Sub:
-            // Copy first pixel of the row.
-            std::memcpy(dstBuffer, &filteredDataPtr[1], pixelWidth);
-            // Then do the Sub defiltering on all the rest of the pixels in the row
-            for (std::size_t widthByte = pixelWidth; widthByte < rowWidth; widthByte++)
-            {
-                // We offset by 1 because we have to jump over the byte that contains filtertype
-                std::uint8_t const filtX = std::uint8_t(filteredDataPtr[1 + widthByte]);
-                std::uint8_t const reconA = std::uint8_t(dstBuffer[widthByte - pixelWidth]);
-                dstBuffer[widthByte] = std::byte(filtX + reconA);
-            }
-            break;
-        case FilterType::Average:
-            // This Filter does work based on the pixel to the left, and the pixel above.
-            // Neither exists for the first pixel on the first row, so we just copy it over.
-            std::memcpy(dstBuffer, &filteredDataPtr[1], pixelWidth);
-            // Do Average defiltering on the rest of the bytes.
-            // We don't use the Recon(b) value because it's always 0 inside the first row.
-            for (std::size_t widthByte = pixelWidth; widthByte < rowWidth; widthByte++)
-            {
-                // We offset by 1 to jump over the byte containing filtertype
-                std::uint8_t const filtX = std::uint8_t(filteredDataPtr[1 + widthByte]);
-                std::uint8_t const reconA = std::uint8_t(dstBuffer[widthByte - pixelWidth]);
-                dstBuffer[widthByte] = std::byte(filtX + reconA / 2);
-            }
-            break;
-        case FilterType::Paeth:
-            // We have no work to do on the first pixel of the first row, so we just copy it over
-            // We offset by one to take the filtertype into account
-            std::memcpy(dstBuffer, &filteredDataPtr[1], pixelWidth);
-            // Traverse every byte of this row after the first pixel
-            // widthByte does not take into account the first byte of the scanline that holds filtertype
-            // Recon(b) and Recon(c) exist on the previous scanline,
-            // but there is not previous scanline for first row. So we just use 0.
-            for (std::size_t widthByte = pixelWidth; widthByte < rowWidth; widthByte++)
-            {
-                // We offset by 1 to jump over the byte containing filtertype
-                std::uint8_t const filtX = std::uint8_t(filteredDataPtr[1 + widthByte]);
-                std::uint8_t const reconA = std::uint8_t(dstBuffer[widthByte - pixelWidth]); // Visual Studio says there's something wrong with this line.
-                dstBuffer[widthByte] = std::byte(filtX + reconA);
-            }
-            break;
-        default:
-            return { ResultType::CorruptFileData, "Encountered unknown filter-type when defiltering PNG imagedata." };
-        }
-    }
-
-    // Defilter rest of the rows
-    for (std::uint32_t y = 1; y < textureInfo.baseDimensions.height; y++)
+    for (std::uint32_t y = 0; y < textureInfo.baseDimensions.height; y++)
     {
-        std::size_t const filterTypeOffset = y * totalRowWidth;
-        
-        // This is where the filtered data start after the filtertype-byte starts.
-        std::size_t const filterRowOffset = filterTypeOffset + 1;
-        // This is where the unfiltered data starts.
-        std::size_t const unfilterRowOffset = filterTypeOffset - y;
+        std::byte const* const filteredRow = filteredDataPtr + y * totalRowWidth;
+        std::byte* const dstRow = dstBuffer + y * dstRowPitch;
+        std::byte const* const prevRow = y == 0 ? nullptr : dstRow - dstRowPitch;
 
-        PNG::FilterType const filterType = static_cast<PNG::FilterType>(filteredDataPtr[filterTypeOffset]);
-        switch (filterType)
-        {
-        case FilterType::None:
-            // Copy all the pixels in the row
-            std::memcpy(&dstBuffer[unfilterRowOffset], &filteredDataPtr[filterRowOffset], rowWidth);
-            break;
-        case FilterType::Sub:
-            // Copy first pixel of the row, since Recon(b) is 0 anyways.
-            std::memcpy(&dstBuffer[unfilterRowOffset], &filteredDataPtr[filterRowOffset], pixelWidth);
-            // Then defilter the rest of the row.
-            for (std::size_t widthByte = pixelWidth; widthByte < rowWidth + 1; widthByte++)
-            {
-                std::uint8_t const filterX = std::uint8_t(filteredDataPtr[filterRowOffset + widthByte]);
-                std::uint8_t const reconA = std::uint8_t(dstBuffer[unfilterRowOffset + widthByte - pixelWidth]);
-                dstBuffer[unfilterRowOffset + widthByte] = std::byte(filterX + reconA);
-            }
-            break;
-        case FilterType::Up:
-            for (std::size_t widthByte = 0; widthByte < rowWidth; widthByte++)
-            {
-                std::uint8_t const filterX = std::uint8_t(filteredDataPtr[filterRowOffset + widthByte]);
-                std::uint8_t const reconB = std::uint8_t(dstBuffer[unfilterRowOffset + widthByte - rowWidth]);
-                dstBuffer[unfilterRowOffset + widthByte] = std::byte(filterX + reconB);
-            }
-            break;
-        case FilterType::Average:
-            // First traverse the first pixel of this row.
-            // We do this because for the first pixel, Recon(a) will always be 0.
-            for (std::size_t widthByte = 0; widthByte < pixelWidth; widthByte++)
-            {
-                std::uint8_t const filterX = std::uint8_t(filteredDataPtr[filterRowOffset + widthByte]);
-                std::uint8_t const reconB = std::uint8_t(dstBuffer[unfilterRowOffset + widthByte - rowWidth]);
-                dstBuffer[unfilterRowOffset + widthByte] = std::byte(filterX + reconB / 2);
-            }
-            // Then we perform the defiltering for the rest of the row.
-            for (std::size_t widthByte = pixelWidth; widthByte < rowWidth; widthByte++)
-            {
-                std::uint8_t const filterX = std::uint8_t(filteredDataPtr[filterRowOffset + widthByte]);
-                std::uint8_t const reconA = std::uint8_t(dstBuffer[unfilterRowOffset + widthByte - pixelWidth]);
-                std::uint8_t const reconB = std::uint8_t(dstBuffer[unfilterRowOffset + widthByte - rowWidth]);
-                dstBuffer[unfilterRowOffset + widthByte] = static_cast<std::byte>(filterX + (reconA + reconB) / 2);
-            }
-            break;
-        case FilterType::Paeth:
-            // Traverse every byte of the first pixel in this row.
-            // We do this because Recon(a) and Recon(c) will always be 0 for the first pixel of a row.
-            for (std::size_t widthByte = 0; widthByte < pixelWidth; widthByte++)
-            {
-                std::uint8_t const filterX = std::uint8_t(filteredDataPtr[filterRowOffset + widthByte]);
-                std::uint8_t const reconB = std::uint8_t(dstBuffer[unfilterRowOffset + widthByte - rowWidth]);
-                dstBuffer[unfilterRowOffset + widthByte] = std::byte(filterX + reconB);
-            }
-            // Traverse every byte of this row after the first pixel
-            for (std::size_t xByte = pixelWidth; xByte < rowWidth; xByte++)
-            {
-                std::uint8_t const filterX = std::uint8_t(filteredDataPtr[filterRowOffset + xByte]);
-                std::uint8_t const reconA = std::uint8_t(dstBuffer[unfilterRowOffset + xByte - pixelWidth]); // Visual Studio says there's something wrong with this line.
-                std::uint8_t const reconB = std::uint8_t(dstBuffer[unfilterRowOffset + xByte - rowWidth]);
-                std::uint8_t const reconC = std::uint8_t(dstBuffer[unfilterRowOffset + xByte - rowWidth - pixelWidth]);
-                dstBuffer[unfilterRowOffset + xByte] = std::byte(filterX + PNG::paethPredictor(reconA, reconB, reconC));
-            }
-            break;
-        default:
-            return { ResultType::CorruptFileData, "Encountered unknown filter-type when defiltering PNG imagedata." };
-        }
+        PNG::FilterType const filterType = static_cast<PNG::FilterType>(filteredRow[0]);
+        Result const result = defilterRow(filterType, dstRow, filteredRow + 1, prevRow, rowWidth, pixelWidth);
+        if (!result.isSuccessful())
+            return result;
     }
 
     return { ResultType::Success, nullptr };
@@ -827,272 +1249,1053 @@ static Texas::Result Texas::detail::PNG::defilterIndicesInPlace(
     // This includes the byte for holding filter-type
     std::size_t const totalRowWidth = baseDims.width + 1;
 
-    // Unfilter first row
-
-    // This is where the filtered data start excluding the filtertype-byte.
-    std::size_t const filterRowOffset = 1;
-    PNG::FilterType const filterType = static_cast<PNG::FilterType>(filteredData[0]);
-    switch (filterType)
-    {
-    case FilterType::None:
-    case FilterType::Up:
-        // If FilterType is None, then we do nothing.
-        // If FilterType is Up, we copy all the bytes of the previous, but since there is no row above, 
-        // it just adds 0 to the entire row, so we do nothing.
-        break;
-    case FilterType::Sub:
-        // Recon(A) is 0 for the first pixel here, so we skip it
-        // since defiltering would be pointless.
-        //
-        // Then do the Sub defiltering on all the rest of the pixels in the row
-        // And we offset by 1 to take into account that we skipped the first pixel (index).
-        for (std::size_t widthByte = 1; widthByte < rowWidth; widthByte++)
-        {
-            std::uint8_t const filterX = std::uint8_t(filteredData[filterRowOffset + widthByte]);
-            std::uint8_t const reconA = std::uint8_t(filteredData[filterRowOffset + widthByte - 1]);
-            filteredData[filterRowOffset + widthByte] = std::byte(filterX + reconA);
-        }
-        break;
-    case FilterType::Average:
-        // This Filter does work based on the pixel to the left, and the pixel above.
-        // Neither exists for the first pixel on the first row
-        // so we do nothing, for the first pixel.
-        //
-        // Average defiltering on the rest of the bytes in the row.
-        // We don't use the Recon(b) value because it's always 0 inside the first row.
-        // And we offset by 1 to take into account that we skipped the first pixel (index).
-        for (std::size_t widthByte = 1; widthByte < rowWidth; widthByte++)
-        {
-            // We offset by 1 to jump over the byte containing filtertype
-            std::uint8_t const filtX = std::uint8_t(filteredData[filterRowOffset + widthByte]);
-            std::uint8_t const reconA = std::uint8_t(filteredData[filterRowOffset + widthByte - 1]);
-            filteredData[filterRowOffset + widthByte] = std::byte(filtX + reconA / 2);
-        }
-        break;
-    case FilterType::Paeth:
-        // This can probably be combined with the Sub case.
-        // 
-        // We have no work to do on the first pixel of the first row, so we skip it.
-        // We offset by one to take the filtertype byte into account
-        //
-        // Traverse every byte of this row after the first pixel
-        // widthByte does not take into account the first byte of the scanline that holds filtertype
-        // Recon(b) and Recon(c) exist on the previous scanline,
-        // but there is not previous scanline for first row. So we just use 0.
-        // And we offset by 1 to take into account that we skipped the first pixel (index)
-        for (std::size_t widthByte = 1; widthByte < rowWidth; widthByte++)
-        {
-            std::uint8_t const filtX = std::uint8_t(filteredData[filterRowOffset + widthByte]);
-            std::uint8_t const reconA = std::uint8_t(filteredData[filterRowOffset + widthByte - 1]);
-            filteredData[filterRowOffset + widthByte] = std::byte(filtX + reconA);
-        }
-        break;
-    default:
-        return { ResultType::CorruptFileData, "Encountered unknown filter-type when defiltering PNG imagedata." };
-    }
-
-    // Defilter rest of the rows
-    for (std::uint32_t y = 1; y < baseDims.height; y++)
+    for (std::uint32_t y = 0; y < baseDims.height; y++)
     {
         std::size_t const filterTypeOffset = y * totalRowWidth;
         // This is where the filtered data start excluding the filtertype-byte.
-        std::size_t const filterRowOffset = filterTypeOffset + 1;
+        std::byte* const row = filteredData + filterTypeOffset + 1;
+        std::byte const* const prevRow = y == 0 ? nullptr : row - totalRowWidth;
 
         PNG::FilterType const filterType = static_cast<PNG::FilterType>(filteredData[filterTypeOffset]);
-        switch (filterType)
-        {
-        case FilterType::None:
-            // If FilterType is None, then we do nothing.
-            break;
-        case FilterType::Sub:
-            // Do nothing with the first pixel (index) of the row, since Recon(a) is 0 anyways.
-            // Then defilter the rest of the row.
-            // And we offset by 1 to take into account that we skipped the first pixel (index)
-            for (std::size_t widthByte = 1; widthByte < rowWidth; widthByte++)
-            {
-                std::uint8_t const filterX = std::uint8_t(filteredData[filterRowOffset + widthByte]);
-                std::uint8_t const reconA = std::uint8_t(filteredData[filterRowOffset + widthByte - 1]);
-                filteredData[filterRowOffset + widthByte] = std::byte(filterX + reconA);
-            }
-            break;
-        case FilterType::Up:
-            for (std::size_t widthByte = 1; widthByte < rowWidth; widthByte++)
-            {
-                std::uint8_t const filterX = std::uint8_t(filteredData[filterRowOffset + widthByte]);
-                std::uint8_t const reconB = std::uint8_t(filteredData[filterRowOffset + widthByte - totalRowWidth]);
-                filteredData[filterRowOffset + widthByte] = std::byte(filterX + reconB);
-            }
-            break;
-        case FilterType::Average:
-            // First defilter the first pixel (index) of the row.
-            // We don't need a loop because the pixel is only 1 byte wide anyways
-            // since it's an index.
-            // We do this because for the first pixel because Recon(a) will always be 0.
-            {
-                std::uint8_t const filterX = std::uint8_t(filteredData[filterRowOffset + 1]);
-                std::uint8_t const reconB = std::uint8_t(filteredData[filterRowOffset - totalRowWidth]);
-                filteredData[filterRowOffset] = std::byte(filterX + reconB / 2);
-            }
-
-            // Then we perform the defiltering for the rest of the row.
-            // We offset by 1 because we skip the first pixel
-            for (std::size_t widthByte = 1; widthByte < rowWidth; widthByte++)
-            {
-                std::uint8_t const filterX = std::uint8_t(filteredData[filterRowOffset + widthByte]);
-                std::uint8_t const reconA = std::uint8_t(filteredData[filterRowOffset + widthByte - 1]);
-                std::uint8_t const reconB = std::uint8_t(filteredData[filterRowOffset + widthByte - totalRowWidth]);
-                filteredData[filterRowOffset + widthByte] = std::byte(filterX + (reconA + reconB) / 2);
-            }
-            break;
-        case FilterType::Paeth:
-            // First defilter the first pixel (index) of the row.
-            // We do this because Recon(a) and Recon(c) will always be 0 for the first pixel of a row.
-            {
-                const std::uint8_t filterX = std::uint8_t(filteredData[filterRowOffset]);
-                const std::uint8_t reconB = std::uint8_t(filteredData[filterRowOffset - totalRowWidth]);
-                filteredData[filterRowOffset] = std::byte(filterX + reconB);
-            }
-            // Traverse every byte of this row after the first pixel
-            for (std::size_t widthByte = 1; widthByte < rowWidth; widthByte++)
-            {
-                const std::uint8_t filterX = std::uint8_t(filteredData[filterRowOffset + widthByte]);
-                const std::uint8_t reconA = std::uint8_t(filteredData[filterRowOffset + widthByte - 1]); // Visual Studio says there's something wrong with this line.
-                const std::uint8_t reconB = std::uint8_t(filteredData[filterRowOffset + widthByte - totalRowWidth]);
-                const std::uint8_t reconC = std::uint8_t(filteredData[filterRowOffset + widthByte - totalRowWidth - 1]);
-                filteredData[filterRowOffset + widthByte] = std::byte(filterX + PNG::paethPredictor(reconA, reconB, reconC));
-            }
-            break;
-        default:
-            return { ResultType::CorruptFileData, "Encountered unknown filter-type when defiltering PNG imagedata." };
-        }
-    }
+        Result const result = defilterRow(filterType, row, row, prevRow, rowWidth, 1);
+        if (!result.isSuccessful())
+            return result;
+    }
 
     return { ResultType::Success, nullptr };
 }
 
 // Assumes the stream is placed at the start of the IDAT chunk(s)
 // Decompresses the entire chain of IDAT chunks into `dst_filteredData`
-// Size of workingMem must be equal to the biggest IDAT chunk data length
+// IDAT chunk data is streamed through `inputBuffer`, which can be any size.
+template<typename StreamT>
 static Texas::Result Texas::detail::PNG::decompressIdatChunks_Stream(
-    InputStream& stream,
+    StreamT& stream,
+    InflateContext& inflateContext,
+    detail::FileInfo_PNG_BackendData const& backendData,
     ByteSpan dst_filteredData,
-    ByteSpan workingMem) noexcept
+    ByteSpan inputBuffer) noexcept
 {
-    Result result{};
+#if defined(TEXAS_ENABLE_FAST_INFLATE)
+    // The whole of the filtered data is in memory here, which is what fastInflate is built for.
+    (void)inflateContext;
+    seekToFirstIdatData(stream, backendData);
+    hintIdatChunks(stream, backendData, InputStream::AccessHint::WillNeed);
+    IdatInflateSource<StreamT> source(stream, inputBuffer, makeIdatCursor(backendData));
+    Result result = fastInflate(source, dst_filteredData);
+    if (!result.isSuccessful())
+        return source.result().isSuccessful() ? result : source.result();
+    // fastInflate reads ahead, so it can run into a bad chunk after the end of the data-stream,
+    // or into the chunk after the IDAT chunks.
+    if (!source.result().isSuccessful() && !source.cursor().chunksEnded)
+        return source.result();
+    result = readRestOfIdatChunks_Stream(stream, backendData, inputBuffer, source.cursor());
+    if (!result.isSuccessful())
+        return result;
+    hintIdatChunks(stream, backendData, InputStream::AccessHint::DontNeed);
+    return { ResultType::Success, nullptr };
+#else
+    Result result = inflateContext.begin();
+    if (!result.isSuccessful())
+        return result;
 
-    z_stream zLibDecompressJob{};
+    z_stream& zLibDecompressJob = inflateContext.stream();
     zLibDecompressJob.next_out = reinterpret_cast<Bytef*>(dst_filteredData.data());
     zLibDecompressJob.avail_out = static_cast<uInt>(dst_filteredData.size());
 
-    int const initErr = inflateInit(&zLibDecompressJob);
-    if (initErr != Z_OK)
+    seekToFirstIdatData(stream, backendData);
+    hintIdatChunks(stream, backendData, InputStream::AccessHint::WillNeed);
+    IdatCursor cursor = makeIdatCursor(backendData);
+    while (true)
     {
-        inflateEnd(&zLibDecompressJob);
-        return { ResultType::CorruptFileData, "During PNG decompression, zLib failed to initialize the decompression job." };
+        ConstByteSpan idatData = {};
+        result = readIdatData_Stream(stream, inputBuffer, cursor, idatData);
+        if (!result.isSuccessful())
+            return result;
+
+        // zLib does not write through next_in.
+        zLibDecompressJob.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(idatData.data()));
+        zLibDecompressJob.avail_in = static_cast<uInt>(idatData.size());
+
+        int const zLibError = inflate(&zLibDecompressJob, 0);
+        if (zLibError == Z_STREAM_END)
+        {
+            // No more IDAT data to decompress
+            if (zLibDecompressJob.avail_out > 0)
+                return { ResultType::CorruptFileData, 
+                         "PNG image-data ended before all rows of the image were decompressed." };
+            result = readRestOfIdatChunks_Stream(stream, backendData, inputBuffer, cursor);
+            if (!result.isSuccessful())
+                return result;
+            break;
+        }
+        else if (zLibError == Z_OK)
+        {
+            // more IDAT data to decompress
+        }
+        else if (zLibError == Z_BUF_ERROR && zLibDecompressJob.avail_out == 0)
+        {
+            return { ResultType::CorruptFileData, 
+                "PNG IDAT data decompresses to more data than the image can hold." };
+        }
+        else if (zLibError != Z_BUF_ERROR)
+        {
+            return { ResultType::CorruptFileData, 
+                "zLib reported a data error while running inflate on PNG IDAT data." };
+        }
     }
 
-    // Decompress every IDAT chunk
-    while (true)
+    hintIdatChunks(stream, backendData, InputStream::AccessHint::DontNeed);
+    return { ResultType::Success, nullptr };
+#endif
+}
+
+static Texas::Result Texas::detail::PNG::defilterRow(
+    PNG::FilterType filterType,
+    std::byte* dstRow,
+    std::byte const* filteredRow,
+    std::byte const* prevRow,
+    std::size_t rowWidth,
+    std::uint8_t pixelWidth) noexcept
+{
+    // There is no row above the first one, so Recon(b) and Recon(c) are always 0.
+    // Up then turns into None, and Paeth turns into Sub.
+    if (filterType == FilterType::None || (filterType == FilterType::Up && prevRow == nullptr))
+    {
+        std::memmove(dstRow, filteredRow, rowWidth);
+        return { ResultType::Success, nullptr };
+    }
+
+    PNG::DefilterKernels const* const kernels = PNG::getDefilterKernels(pixelWidth);
+    if (kernels == nullptr)
+        return { ResultType::CorruptFileData, "Encountered unsupported pixel-width when defiltering PNG imagedata." };
+
+    switch (filterType)
+    {
+    case FilterType::Sub:
+        kernels->sub(dstRow, filteredRow, prevRow, rowWidth);
+        break;
+    case FilterType::Up:
+        kernels->up(dstRow, filteredRow, prevRow, rowWidth);
+        break;
+    case FilterType::Average:
+        if (prevRow == nullptr)
+            kernels->averageFirstRow(dstRow, filteredRow, prevRow, rowWidth);
+        else
+            kernels->average(dstRow, filteredRow, prevRow, rowWidth);
+        break;
+    case FilterType::Paeth:
+        if (prevRow == nullptr)
+            kernels->sub(dstRow, filteredRow, prevRow, rowWidth);
+        else
+            kernels->paeth(dstRow, filteredRow, prevRow, rowWidth);
+        break;
+    default:
+        return { ResultType::CorruptFileData, "Encountered unknown filter-type when defiltering PNG imagedata." };
+    }
+
+    return { ResultType::Success, nullptr };
+}
+
+static Texas::Result Texas::detail::PNG::deindexRow(
+    ConstByteSpan paletteData,
+    std::byte* dstRow,
+    std::byte const* indices,
+    std::size_t width) noexcept
+{
+    std::size_t const paletteColorCount = paletteData.size() / 3;
+    for (std::size_t x = 0; x < width; x++)
+    {
+        std::uint8_t const paletteIndex = std::uint8_t(indices[x]);
+        if (paletteIndex >= paletteColorCount)
+            return { ResultType::CorruptFileData, "Encountered an out-of-bounds index while de-indexing PNG file." };
+        std::memcpy(dstRow + x * 3, paletteData.data() + static_cast<std::size_t>(paletteIndex) * 3, 3);
+    }
+    return { ResultType::Success, nullptr };
+}
+
+template<typename StreamT>
+static void Texas::detail::PNG::seekToFirstIdatData(
+    StreamT& stream,
+    detail::FileInfo_PNG_BackendData const& backendData) noexcept
+{
+    // Skip the 'Length' and 'Chunk type' fields.
+    std::size_t const idatDataStreamPos = backendData.firstIdatChunkStreamPos + 8;
+    if (stream.tell() != idatDataStreamPos)
+        stream.seek(idatDataStreamPos);
+}
+
+template<typename StreamT>
+static void Texas::detail::PNG::hintIdatChunks(
+    StreamT& stream,
+    detail::FileInfo_PNG_BackendData const& backendData,
+    InputStream::AccessHint access) noexcept
+{
+    // We don't know where the IDAT chunks end if the file was probed, then it goes to the end of the stream.
+    std::size_t length = 0;
+    if (backendData.idatChunksEndStreamPos != 0)
+        length = backendData.idatChunksEndStreamPos - backendData.firstIdatChunkStreamPos;
+    stream.hint(backendData.firstIdatChunkStreamPos, length, access);
+}
+
+static std::uint32_t Texas::detail::PNG::updateChunkCrc(std::uint32_t chunkCrc, ConstByteSpan data) noexcept
+{
+#if defined(TEXAS_ENABLE_PNG_CRC_CHECK)
+    return updateCrc32(chunkCrc, data);
+#else
+    (void)data;
+    return chunkCrc;
+#endif
+}
+
+static Texas::Result Texas::detail::PNG::checkChunkCrc(std::byte const* crcField, std::uint32_t chunkCrc) noexcept
+{
+#if defined(TEXAS_ENABLE_PNG_CRC_CHECK)
+    if (PNG::toCorrectEndian_u32(crcField) != chunkCrc)
+        return { ResultType::CorruptFileData, 
+                 "PNG chunk's CRC field does not match the CRC of its type and data." };
+#else
+    (void)crcField;
+    (void)chunkCrc;
+#endif
+    return { ResultType::Success, nullptr };
+}
+
+template<typename StreamT>
+static Texas::Result Texas::detail::PNG::endChunk(StreamT& stream, std::uint32_t chunkCrc) noexcept
+{
+#if defined(TEXAS_ENABLE_PNG_CRC_CHECK)
+    std::byte crcField[sizeof(ChunkCRC_T)] = {};
+    Result const result = stream.read({ crcField, sizeof(crcField) });
+    if (!result.isSuccessful())
+        return result;
+    return checkChunkCrc(crcField, chunkCrc);
+#else
+    (void)chunkCrc;
+    stream.ignore(sizeof(ChunkCRC_T));
+    return { ResultType::Success, nullptr };
+#endif
+}
+
+static Texas::detail::PNG::IdatCursor Texas::detail::PNG::makeIdatCursor(
+    detail::FileInfo_PNG_BackendData const& backendData) noexcept
+{
+    IdatCursor cursor{};
+    cursor.chunkDataRemaining = backendData.firstIdatChunkDataLength;
+    cursor.chunkCrc = updateChunkCrc(0, { idatChunkType, sizeof(idatChunkType) });
+    return cursor;
+}
+
+static bool Texas::detail::PNG::beginIdatChunk(std::byte const* chunkLengthAndType, IdatCursor& cursor) noexcept
+{
+    // Chunk type appears after chunk-data-length, so we offset 4 bytes extra.
+    if (PNG::getChunkType(chunkLengthAndType + sizeof(PNG::ChunkSize_T)) != PNG::ChunkType::IDAT)
+        return false;
+
+    // Chunk data length is the first entry in the chunk. It's a uint32_t
+    cursor.chunkDataRemaining = PNG::toCorrectEndian_u32(chunkLengthAndType);
+    cursor.chunkCrc = updateChunkCrc(0, { chunkLengthAndType + sizeof(PNG::ChunkSize_T), sizeof(ChunkType_T) });
+    return true;
+}
+
+template<typename StreamT>
+static Texas::Result Texas::detail::PNG::readIdatData_Stream(
+    StreamT& stream,
+    ByteSpan inputBuffer,
+    IdatCursor& cursor,
+    ConstByteSpan& idatData) noexcept
+{
+    Result result{};
+
+    while (cursor.chunkDataRemaining == 0)
     {
         std::byte chunkLengthAndTypeBuffer[8] = {};
         result = stream.read({ chunkLengthAndTypeBuffer, 8 });
         if (!result.isSuccessful())
             return result;
+        if (!beginIdatChunk(chunkLengthAndTypeBuffer, cursor))
+        {
+            cursor.chunksEnded = true;
+            return { ResultType::CorruptFileData, 
+                     "PNG IDAT chunks ended before the end of the zLib data-stream." };
+        }
+        if (cursor.chunkDataRemaining == 0)
+        {
+            result = endChunk(stream, cursor.chunkCrc);
+            if (!result.isSuccessful())
+                return result;
+        }
+    }
 
-        // Chunk data length is the first entry in the chunk. It's a uint32_t
-        std::uint32_t const chunkDataLength = PNG::toCorrectEndian_u32(chunkLengthAndTypeBuffer);
+    // Streams that hold the file in memory let us decompress the chunk where it is.
+    // Acquired bytes are only valid until the stream is used again, so we take the CRC field along with them.
+    ConstByteSpan const acquired = stream.acquire(std::size_t(cursor.chunkDataRemaining) + sizeof(ChunkCRC_T));
+    if (acquired.data() != nullptr)
+    {
+        idatData = { acquired.data(), cursor.chunkDataRemaining };
+        cursor.chunkDataRemaining = 0;
+        cursor.chunkCrc = updateChunkCrc(cursor.chunkCrc, idatData);
+        return checkChunkCrc(idatData.data() + idatData.size(), cursor.chunkCrc);
+    }
+
+    std::size_t bytesRead = cursor.chunkDataRemaining;
+    if (bytesRead > inputBuffer.size())
+        bytesRead = inputBuffer.size();
+    result = stream.read({ inputBuffer.data(), bytesRead });
+    if (!result.isSuccessful())
+        return result;
+    idatData = { inputBuffer.data(), bytesRead };
+    cursor.chunkDataRemaining -= static_cast<std::uint32_t>(bytesRead);
+    // The data is checked while it's still in the cache, right before it's decompressed.
+    cursor.chunkCrc = updateChunkCrc(cursor.chunkCrc, idatData);
+    if (cursor.chunkDataRemaining == 0)
+        return endChunk(stream, cursor.chunkCrc);
 
-        if (chunkDataLength == 0)
+    return { ResultType::Success, nullptr };
+}
+
+static Texas::detail::PNG::RowDecodeInfo Texas::detail::PNG::makeRowDecodeInfo(
+    TextureInfo const& textureInfo,
+    detail::FileInfo_PNG_BackendData const& backendData,
+    ByteSpan dstImageBuffer,
+    std::size_t dstRowPitch) noexcept
+{
+    RowDecodeInfo info{};
+    info.isIndexed = backendData.plteChunkDataLength != 0;
+    info.pixelWidth = info.isIndexed ? 1 : PNG::getPixelWidth(textureInfo.pixelFormat);
+    info.width = static_cast<std::size_t>(textureInfo.baseDimensions.width);
+    info.rowWidth = info.pixelWidth * info.width;
+    info.paletteData = { backendData.plteChunkData, backendData.plteChunkDataLength };
+    info.dstImageBuffer = dstImageBuffer;
+    info.dstRowPitch = dstRowPitch;
+    return info;
+}
+
+template<typename StreamT>
+static Texas::Result Texas::detail::PNG::inflateRow(
+    StreamT& stream,
+    z_stream& zLibDecompressJob,
+    ByteSpan inputBuffer,
+    IdatCursor& cursor,
+    std::byte* filteredRow,
+    std::size_t totalRowWidth) noexcept
+{
+    zLibDecompressJob.next_out = reinterpret_cast<Bytef*>(filteredRow);
+    zLibDecompressJob.avail_out = static_cast<uInt>(totalRowWidth);
+    while (zLibDecompressJob.avail_out > 0)
+    {
+        if (zLibDecompressJob.avail_in == 0)
+        {
+            ConstByteSpan idatData = {};
+            Result const result = readIdatData_Stream(stream, inputBuffer, cursor, idatData);
+            if (!result.isSuccessful())
+                return result;
+            // zLib does not write through next_in.
+            zLibDecompressJob.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(idatData.data()));
+            zLibDecompressJob.avail_in = static_cast<uInt>(idatData.size());
+        }
+
+        int const zLibError = inflate(&zLibDecompressJob, Z_NO_FLUSH);
+        if (zLibError == Z_STREAM_END && zLibDecompressJob.avail_out > 0)
             return { ResultType::CorruptFileData, 
-            "PNG IDAT chunk data length is 0. "
-            "The file has changed since it was parsed."};
-        if (chunkDataLength > workingMem.size())
+                     "PNG image-data ended before all rows of the image were decompressed." };
+        else if (zLibError != Z_OK && zLibError != Z_STREAM_END)
             return { ResultType::CorruptFileData, 
-            "PNG IDAT chunk data length is larger than what was recorded when parsing the file. "
-            "The file has changed since it was parsed." };
+                     "zLib reported a data error while running inflate on PNG IDAT data." };
+    }
+    return { ResultType::Success, nullptr };
+}
 
-        // Chunk type appears after chunk-data-length, so we offset 4 bytes extra.
-        PNG::ChunkType const chunkType = PNG::getChunkType(chunkLengthAndTypeBuffer + sizeof(PNG::ChunkSize_T));
-        if (chunkType != PNG::ChunkType::IDAT)
+template<typename StreamT>
+static Texas::Result Texas::detail::PNG::finishInflate_Stream(
+    StreamT& stream,
+    detail::FileInfo_PNG_BackendData const& backendData,
+    z_stream& zLibDecompressJob,
+    ByteSpan inputBuffer,
+    IdatCursor& cursor) noexcept
+{
+    // zLib gets room for one more byte. If it writes it, the data-stream holds more than the image.
+    std::byte excess = {};
+    while (true)
+    {
+        zLibDecompressJob.next_out = reinterpret_cast<Bytef*>(&excess);
+        zLibDecompressJob.avail_out = 1;
+        int const zLibError = inflate(&zLibDecompressJob, Z_NO_FLUSH);
+        if (zLibDecompressJob.avail_out == 0)
+            return { ResultType::CorruptFileData, 
+                     "PNG IDAT data decompresses to more data than the image can hold." };
+        else if (zLibError == Z_STREAM_END)
+            break;
+        // Z_BUF_ERROR means zLib used up its input.
+        else if (zLibError != Z_OK && zLibError != Z_BUF_ERROR)
             return { ResultType::CorruptFileData, 
-            "Found no IDAT chunk when decompressing PNG file. "
-            "The file has changed since it was parsed." };
+                     "zLib reported a data error while running inflate on PNG IDAT data." };
+
+        if (zLibDecompressJob.avail_in == 0)
+        {
+            ConstByteSpan idatData = {};
+            Result const result = readIdatData_Stream(stream, inputBuffer, cursor, idatData);
+            if (!result.isSuccessful())
+                return result;
+            // zLib does not write through next_in.
+            zLibDecompressJob.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(idatData.data()));
+            zLibDecompressJob.avail_in = static_cast<uInt>(idatData.size());
+        }
+    }
+    return readRestOfIdatChunks_Stream(stream, backendData, inputBuffer, cursor);
+}
+
+template<typename StreamT>
+static Texas::Result Texas::detail::PNG::readRestOfIdatChunks_Stream(
+    StreamT& stream,
+    detail::FileInfo_PNG_BackendData const& backendData,
+    ByteSpan inputBuffer,
+    IdatCursor& cursor) noexcept
+{
+#if defined(TEXAS_ENABLE_PNG_CRC_CHECK)
+    Result result = { ResultType::Success, nullptr };
+    while (result.isSuccessful() && !cursor.chunksEnded)
+    {
+        if (cursor.chunkDataRemaining > 0)
+        {
+            ConstByteSpan idatData = {};
+            result = readIdatData_Stream(stream, inputBuffer, cursor, idatData);
+        }
+        else if (backendData.idatChunksEndStreamPos == 0 || stream.tell() < backendData.idatChunksEndStreamPos)
+        {
+            std::byte chunkLengthAndTypeBuffer[8] = {};
+            result = stream.read({ chunkLengthAndTypeBuffer, 8 });
+            // Probed files don't tell us where the IDAT chunks end, so we find out from the chunk after them.
+            // The stream is then left after its 'Length' and 'Chunk type' fields.
+            if (result.isSuccessful() && !beginIdatChunk(chunkLengthAndTypeBuffer, cursor))
+                cursor.chunksEnded = true;
+            else if (result.isSuccessful() && cursor.chunkDataRemaining == 0)
+                result = endChunk(stream, cursor.chunkCrc);
+        }
+        else
+            break;
+    }
+    return result;
+#else
+    // There are no CRCs to check, so we only move the stream past the chunks.
+    (void)inputBuffer;
+    if (cursor.chunkDataRemaining > 0)
+    {
+        stream.ignore(std::size_t(cursor.chunkDataRemaining) + sizeof(ChunkCRC_T));
+        cursor.chunkDataRemaining = 0;
+    }
+    if (backendData.idatChunksEndStreamPos > stream.tell())
+        stream.ignore(backendData.idatChunksEndStreamPos - stream.tell());
+    return { ResultType::Success, nullptr };
+#endif
+}
 
-        // Stream chunk data into working-memory
-        result = stream.read({ workingMem.data(), chunkDataLength });
+static Texas::Result Texas::detail::PNG::decodeRow(
+    RowDecodeInfo const& info,
+    std::uint32_t y,
+    std::byte* filteredRow,
+    std::byte const* prevFilteredRow) noexcept
+{
+    PNG::FilterType const filterType = static_cast<PNG::FilterType>(filteredRow[0]);
+    std::byte* const dstRow = info.dstImageBuffer.data() + y * info.dstRowPitch;
+    if (info.isIndexed)
+    {
+        // Defilter the indices in place, then look them up in the palette.
+        std::byte* const indices = filteredRow + 1;
+        std::byte const* const prevIndices = prevFilteredRow != nullptr ? prevFilteredRow + 1 : nullptr;
+        Result const result = defilterRow(filterType, indices, indices, prevIndices, info.rowWidth, info.pixelWidth);
         if (!result.isSuccessful())
             return result;
-        // Then ignore the CRC field of the chunk.
-        stream.ignore(4);
+        return deindexRow(info.paletteData, dstRow, indices, info.width);
+    }
+    else
+    {
+        std::byte const* const prevRow = y > 0 ? dstRow - info.dstRowPitch : nullptr;
+        return defilterRow(filterType, dstRow, filteredRow + 1, prevRow, info.rowWidth, info.pixelWidth);
+    }
+}
+
+template<typename StreamT>
+static Texas::Result Texas::detail::PNG::loadRows_Stream(
+    StreamT& stream,
+    InflateContext& inflateContext,
+    TextureInfo const& textureInfo,
+    detail::FileInfo_PNG_BackendData const& backendData,
+    ByteSpan dstImageBuffer,
+    std::size_t dstRowPitch,
+    ByteSpan workingMem) noexcept
+{
+    /*
+        The working memory is divided up in 2 parts.
 
-        zLibDecompressJob.next_in = reinterpret_cast<Bytef*>(workingMem.data());
-        zLibDecompressJob.avail_in = static_cast<uInt>(chunkDataLength);
+        The first is a buffer that IDAT chunk data gets streamed through on it's way to zLib.
 
-        int const zLibError = inflate(&zLibDecompressJob, 0);
-        if (zLibError == Z_STREAM_END)
+        The second holds the filtered rows zLib decompresses into, including their filter-type byte.
+        When dealing with indexed colours we need two rows, because the defiltered indices 
+        of the previous row are not stored anywhere else. Otherwise we only need one,
+        since the previous row has already been defiltered into dstImageBuffer.
+    */
+
+    Result result{};
+
+    RowDecodeInfo const info = makeRowDecodeInfo(textureInfo, backendData, dstImageBuffer, dstRowPitch);
+    // Size is in bytes.
+    // Includes the byte for filter-type.
+    std::size_t const totalRowWidth = info.rowWidth + 1;
+
+    ByteSpan const inputBuffer = { workingMem.data(), idatInputBufferSize };
+    std::byte* const filteredRows[2] = { 
+        inputBuffer.data() + inputBuffer.size(),
+        inputBuffer.data() + inputBuffer.size() + (info.isIndexed ? totalRowWidth : 0) };
+
+    seekToFirstIdatData(stream, backendData);
+    hintIdatChunks(stream, backendData, InputStream::AccessHint::WillNeed);
+
+    result = inflateContext.begin();
+    if (!result.isSuccessful())
+        return result;
+    z_stream& zLibDecompressJob = inflateContext.stream();
+
+    IdatCursor cursor = makeIdatCursor(backendData);
+    for (std::uint32_t y = 0; y < textureInfo.baseDimensions.height; y++)
+    {
+        std::byte* const filteredRow = filteredRows[y % 2];
+        result = inflateRow(stream, zLibDecompressJob, inputBuffer, cursor, filteredRow, totalRowWidth);
+        if (!result.isSuccessful())
+            break;
+        result = decodeRow(info, y, filteredRow, y > 0 ? filteredRows[(y - 1) % 2] : nullptr);
+        if (!result.isSuccessful())
+            break;
+    }
+    if (result.isSuccessful())
+        result = finishInflate_Stream(stream, backendData, zLibDecompressJob, inputBuffer, cursor);
+
+    if (result.isSuccessful())
+        hintIdatChunks(stream, backendData, InputStream::AccessHint::DontNeed);
+    return result;
+}
+
+#if defined(TEXAS_ENABLE_PNG_PIPELINING)
+static std::uint32_t Texas::detail::PNG::calcPipelineRingRowCount(std::size_t totalRowWidth, std::uint32_t height) noexcept
+{
+    std::size_t rowCount = pipelineRingTargetSize / totalRowWidth;
+    if (rowCount < pipelineRingMinRowCount)
+        rowCount = pipelineRingMinRowCount;
+    if (rowCount > height)
+        rowCount = height;
+    return static_cast<std::uint32_t>(rowCount);
+}
+
+std::uint64_t Texas::detail::PNG::calcWorkingMemRequired_Pipelined(
+    TextureInfo const& textureInfo,
+    detail::FileInfo_PNG_BackendData const& backendData) noexcept
+{
+    bool const isIndexed = backendData.plteChunkDataLength != 0;
+    std::uint8_t const pixelWidth = isIndexed ? 1 : PNG::getPixelWidth(textureInfo.pixelFormat);
+    std::uint64_t const totalRowWidth = std::uint64_t(textureInfo.baseDimensions.width) * pixelWidth + 1;
+    if (totalRowWidth * textureInfo.baseDimensions.height < minPipelinedFilteredDataSize)
+        return 0;
+    // The threads need a few rows between them to not wait on each other all the time.
+    if (textureInfo.baseDimensions.height < pipelineRingMinRowCount)
+        return 0;
+    // Files split in segments are decompressed all at once, on one thread per segment.
+    if (backendData.segmentCount != 0)
+        return calcWorkingMemRequired_Stream(textureInfo.baseDimensions, textureInfo.pixelFormat, isIndexed);
+    std::uint32_t const ringRowCount = calcPipelineRingRowCount(
+        static_cast<std::size_t>(totalRowWidth), 
+        textureInfo.baseDimensions.height);
+    return idatInputBufferSize + totalRowWidth * ringRowCount;
+}
+
+static void Texas::detail::PNG::publishRowPipeline(
+    RowPipeline& pipeline,
+    std::atomic<std::uint32_t>& counter,
+    std::uint32_t value) noexcept
+{
+    // The waiting side registers itself before it checks the counters for the last time,
+    // so either it sees this value, or we see that it's waiting.
+    counter.store(value);
+    if (pipeline.waiterCount.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(pipeline.mutex);
+        pipeline.condition.notify_all();
+    }
+}
+
+static void Texas::detail::PNG::failRowPipeline(RowPipeline& pipeline) noexcept
+{
+    pipeline.failed.store(true);
+    std::lock_guard<std::mutex> lock(pipeline.mutex);
+    pipeline.condition.notify_all();
+}
+
+static void Texas::detail::PNG::waitRowPipeline(
+    RowPipeline& pipeline,
+    std::atomic<std::uint32_t> const& rowCount,
+    std::uint32_t minRowCount) noexcept
+{
+    if (rowCount.load() > minRowCount || pipeline.failed.load())
+        return;
+    std::unique_lock<std::mutex> lock(pipeline.mutex);
+    pipeline.waiterCount.fetch_add(1);
+    while (rowCount.load() <= minRowCount && !pipeline.failed.load())
+        pipeline.condition.wait(lock);
+    pipeline.waiterCount.fetch_sub(1);
+}
+
+template<typename StreamT>
+static Texas::Result Texas::detail::PNG::loadRows_Pipelined(
+    StreamT& stream,
+    InflateContext& inflateContext,
+    TextureInfo const& textureInfo,
+    detail::FileInfo_PNG_BackendData const& backendData,
+    ByteSpan dstImageBuffer,
+    std::size_t dstRowPitch,
+    ByteSpan workingMem) noexcept
+{
+    /*
+        The working memory is divided up in 2 parts.
+
+        The first is a buffer that IDAT chunk data gets streamed through on it's way to zLib.
+
+        The second is a ring buffer of filtered rows. The calling thread inflates row y into
+        slot y % ringRowCount, while the defilter thread decodes the rows before it.
+        For indexed colours the slot of the row before the one being decoded holds its defiltered
+        indices, so the calling thread stays one more row behind.
+    */
+
+    RowDecodeInfo const info = makeRowDecodeInfo(textureInfo, backendData, dstImageBuffer, dstRowPitch);
+    std::size_t const totalRowWidth = info.rowWidth + 1;
+    std::uint32_t const height = textureInfo.baseDimensions.height;
+    std::uint32_t const ringRowCount = calcPipelineRingRowCount(totalRowWidth, height);
+    std::uint32_t const rowsAhead = info.isIndexed ? ringRowCount - 1 : ringRowCount;
+
+    ByteSpan const inputBuffer = { workingMem.data(), idatInputBufferSize };
+    std::byte* const ring = inputBuffer.data() + inputBuffer.size();
+
+    Result result = inflateContext.begin();
+    if (!result.isSuccessful())
+        return result;
+    z_stream& zLibDecompressJob = inflateContext.stream();
+
+    RowPipeline pipeline{};
+    Result defilterResult = { ResultType::Success, nullptr };
+    auto const defilterRows = [&]() noexcept
+    {
+        for (std::uint32_t y = 0; y < height; y++)
         {
-            // No more IDAT chunks to decompress
-            inflateEnd(&zLibDecompressJob);
+            waitRowPipeline(pipeline, pipeline.rowsInflated, y);
+            if (pipeline.failed.load())
+                return;
+            std::byte* const filteredRow = ring + (y % ringRowCount) * totalRowWidth;
+            std::byte const* const prevFilteredRow = y > 0 ? ring + ((y - 1) % ringRowCount) * totalRowWidth : nullptr;
+            defilterResult = decodeRow(info, y, filteredRow, prevFilteredRow);
+            if (!defilterResult.isSuccessful())
+            {
+                failRowPipeline(pipeline);
+                return;
+            }
+            publishRowPipeline(pipeline, pipeline.rowsDecoded, y + 1);
+        }
+    };
+
+    std::thread defilterThread{};
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+    try
+    {
+        defilterThread = std::thread(defilterRows);
+    }
+    catch (...)
+    {
+        // We could not get another thread, so we decode on this one.
+        return loadRows_Stream(stream, inflateContext, textureInfo, backendData, dstImageBuffer, dstRowPitch, workingMem);
+    }
+#else
+    defilterThread = std::thread(defilterRows);
+#endif
+
+    seekToFirstIdatData(stream, backendData);
+    hintIdatChunks(stream, backendData, InputStream::AccessHint::WillNeed);
+
+    IdatCursor cursor = makeIdatCursor(backendData);
+    for (std::uint32_t y = 0; y < height; y++)
+    {
+        // Wait until the defilter thread is done with the slot we are about to overwrite.
+        if (y >= rowsAhead)
+            waitRowPipeline(pipeline, pipeline.rowsDecoded, y - rowsAhead);
+        if (pipeline.failed.load())
+            break;
+        std::byte* const filteredRow = ring + (y % ringRowCount) * totalRowWidth;
+        result = inflateRow(stream, zLibDecompressJob, inputBuffer, cursor, filteredRow, totalRowWidth);
+        if (!result.isSuccessful())
+        {
+            failRowPipeline(pipeline);
             break;
         }
-        else if (zLibError == Z_OK)
+        publishRowPipeline(pipeline, pipeline.rowsInflated, y + 1);
+    }
+    // The defilter thread has every row it needs by now, so it can finish while we check the end of the data.
+    if (result.isSuccessful() && !pipeline.failed.load())
+        result = finishInflate_Stream(stream, backendData, zLibDecompressJob, inputBuffer, cursor);
+
+    defilterThread.join();
+    if (!result.isSuccessful())
+        return result;
+    if (!defilterResult.isSuccessful())
+        return defilterResult;
+
+    hintIdatChunks(stream, backendData, InputStream::AccessHint::DontNeed);
+    return { ResultType::Success, nullptr };
+}
+
+static bool Texas::detail::PNG::inflateSegment(SegmentJob& job, ByteSpan filteredRows) noexcept
+{
+    // Segments after the first start in the middle of the zLib data-stream, so we inflate raw
+    // deflate data and handle the zLib header and checksum ourselves.
+    z_stream zLibDecompressJob{};
+    if (inflateInit2(&zLibDecompressJob, -15) != Z_OK)
+        return false;
+    zLibDecompressJob.next_out = reinterpret_cast<Bytef*>(filteredRows.data());
+    zLibDecompressJob.avail_out = static_cast<uInt>(filteredRows.size());
+
+    std::byte zLibHeader[2] = {};
+    std::uint32_t zLibHeaderBytesLeft = job.isFirst ? 2 : 0;
+    std::uint32_t storedAdlerBytesRead = 0;
+    bool streamEnded = false;
+    // Once the rows are full, zLib gets this instead. If it writes to it, the segment has too much data.
+    std::byte overflow[1] = {};
+    bool overflowed = false;
+    bool failed = false;
+
+    std::size_t chunkOffset = 0;
+    while (!failed && chunkOffset + 8 <= job.chunks.size())
+    {
+        std::byte const* const chunk = job.chunks.data() + chunkOffset;
+        if (PNG::getChunkType(chunk + sizeof(PNG::ChunkSize_T)) != PNG::ChunkType::IDAT)
+            break;
+        std::uint32_t const chunkDataLength = PNG::toCorrectEndian_u32(chunk);
+        if (chunkDataLength > job.chunks.size() - chunkOffset - 12)
         {
-            // more IDAT chunks to decompress
+            failed = true;
+            break;
         }
-        else if (zLibError == Z_DATA_ERROR)
+        ConstByteSpan idatData = { chunk + 8, chunkDataLength };
+        chunkOffset += std::size_t(chunkDataLength) + 12;
+        std::uint32_t const chunkCrc = updateChunkCrc(
+            updateChunkCrc(0, { chunk + sizeof(PNG::ChunkSize_T), sizeof(ChunkType_T) }), 
+            idatData);
+        if (!checkChunkCrc(idatData.data() + idatData.size(), chunkCrc).isSuccessful())
         {
-            return { ResultType::CorruptFileData, 
-                "zLib reported a data error while running inflate on PNG IDAT data." };
+            failed = true;
+            break;
+        }
+
+        while (idatData.size() > 0 && zLibHeaderBytesLeft > 0)
+        {
+            zLibHeader[2 - zLibHeaderBytesLeft] = idatData.data()[0];
+            idatData = { idatData.data() + 1, idatData.size() - 1 };
+            zLibHeaderBytesLeft -= 1;
+            if (zLibHeaderBytesLeft == 0)
+            {
+                std::uint32_t const cmf = static_cast<std::uint32_t>(zLibHeader[0]);
+                std::uint32_t const flg = static_cast<std::uint32_t>(zLibHeader[1]);
+                if ((cmf & 0xf) != 8 || (cmf >> 4) > 7 || (cmf * 256 + flg) % 31 != 0 || (flg & 0x20) != 0)
+                    failed = true;
+            }
+        }
+
+        while (!failed && !streamEnded && idatData.size() > 0)
+        {
+            // zLib does not write through next_in.
+            zLibDecompressJob.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(idatData.data()));
+            zLibDecompressJob.avail_in = static_cast<uInt>(idatData.size());
+            int const zLibError = inflate(&zLibDecompressJob, Z_NO_FLUSH);
+            std::size_t const bytesConsumed = idatData.size() - zLibDecompressJob.avail_in;
+            idatData = { idatData.data() + bytesConsumed, zLibDecompressJob.avail_in };
+
+            if (zLibError == Z_STREAM_END)
+                streamEnded = true;
+            else if (zLibError != Z_OK && zLibError != Z_BUF_ERROR)
+                failed = true;
+            else if (zLibDecompressJob.avail_out == 0)
+            {
+                if (overflowed)
+                    failed = true;
+                zLibDecompressJob.next_out = reinterpret_cast<Bytef*>(overflow);
+                zLibDecompressJob.avail_out = sizeof(overflow);
+                overflowed = true;
+            }
+            else if (bytesConsumed == 0)
+                failed = true;
+        }
+
+        // The Adler-32 checksum follows the end of the data-stream, possibly in the next chunk.
+        while (streamEnded && idatData.size() > 0 && storedAdlerBytesRead < 4)
+        {
+            job.storedAdler = job.storedAdler << 8 | static_cast<std::uint32_t>(idatData.data()[0]);
+            idatData = { idatData.data() + 1, idatData.size() - 1 };
+            storedAdlerBytesRead += 1;
         }
     }
+    bool const rowsFilled = overflowed || zLibDecompressJob.avail_out == 0;
+    bool const wroteTooMuch = overflowed && zLibDecompressJob.avail_out == 0;
+    inflateEnd(&zLibDecompressJob);
+
+    if (failed || !rowsFilled || wroteTooMuch || zLibHeaderBytesLeft > 0)
+        return false;
+    // Only the last segment ends the data-stream.
+    if (job.isLast != streamEnded || (job.isLast && storedAdlerBytesRead < 4))
+        return false;
+
+    job.adler = static_cast<std::uint32_t>(adler32_z(
+        adler32_z(0, nullptr, 0),
+        reinterpret_cast<Bytef const*>(filteredRows.data()),
+        filteredRows.size()));
+    return true;
+}
 
-    return { ResultType::Success, nullptr };
+static void Texas::detail::PNG::decodeSegment(SegmentJob& job, RowDecodeInfo const& info, std::byte* filteredData) noexcept
+{
+    std::size_t const totalRowWidth = info.rowWidth + 1;
+    std::byte* const filteredRows = filteredData + job.firstRow * totalRowWidth;
+    job.inflated = inflateSegment(job, { filteredRows, job.rowCount * totalRowWidth });
+    if (!job.inflated)
+        return;
+
+    // None and Sub only look at the row itself.
+    PNG::FilterType const firstFilterType = static_cast<PNG::FilterType>(filteredRows[0]);
+    if (!job.isFirst && firstFilterType != FilterType::None && firstFilterType != FilterType::Sub)
+        return;
+    for (std::uint32_t i = 0; i < job.rowCount; i++)
+    {
+        std::byte* const filteredRow = filteredRows + i * totalRowWidth;
+        std::byte const* const prevFilteredRow = i > 0 ? filteredRow - totalRowWidth : nullptr;
+        Result const result = decodeRow(info, job.firstRow + i, filteredRow, prevFilteredRow);
+        if (!result.isSuccessful())
+            return;
+    }
+    job.defiltered = true;
 }
 
-Texas::Result Texas::detail::PNG::loadFromStream(
-    InputStream& stream,
+template<typename StreamT>
+static bool Texas::detail::PNG::loadSegments_Parallel(
+    StreamT& stream,
     TextureInfo const& textureInfo,
     detail::FileInfo_PNG_BackendData const& backendData,
     ByteSpan dstImageBuffer,
+    std::size_t dstRowPitch,
     ByteSpan workingMem) noexcept
+{
+    // Every thread reads its own chunks, so we need all of them at once.
+    std::size_t const streamPos = stream.tell();
+    std::size_t const streamSize = stream.size();
+    if (backendData.firstIdatChunkStreamPos >= streamSize)
+        return false;
+    hintIdatChunks(stream, backendData, InputStream::AccessHint::WillNeed);
+    stream.seek(backendData.firstIdatChunkStreamPos);
+    ConstByteSpan const idatChunks = stream.acquire(streamSize - backendData.firstIdatChunkStreamPos);
+    /*
+        The acquired bytes are only valid until we call the stream again,
+        so it's not touched until the threads reading them are done.
+        Then it's put back where it was if we give up.
+    */
+    auto const giveUp = [&stream, streamPos]() noexcept
+    {
+        stream.seek(streamPos);
+        return false;
+    };
+    if (idatChunks.data() == nullptr)
+        return giveUp();
+
+    std::uint32_t const segmentCount = backendData.segmentCount;
+    std::uint32_t const height = textureInfo.baseDimensions.height;
+    SegmentJob jobs[FileInfo_PNG_BackendData::maxSegmentCount] = {};
+
+    // Walk the chain of IDAT chunks, to make sure every segment starts at one, and to find where they end.
+    std::size_t segmentChunkOffsets[FileInfo_PNG_BackendData::maxSegmentCount] = {};
+    std::uint32_t segmentsFound = 0;
+    std::size_t chunkOffset = 0;
+    while (chunkOffset + 8 <= idatChunks.size())
+    {
+        std::byte const* const chunk = idatChunks.data() + chunkOffset;
+        if (PNG::getChunkType(chunk + sizeof(PNG::ChunkSize_T)) != PNG::ChunkType::IDAT)
+            break;
+        std::size_t const chunkStreamPos = backendData.firstIdatChunkStreamPos + chunkOffset;
+        if (segmentsFound < segmentCount && chunkStreamPos == backendData.segmentChunkStreamPos[segmentsFound])
+        {
+            segmentChunkOffsets[segmentsFound] = chunkOffset;
+            segmentsFound += 1;
+        }
+        else if (segmentsFound < segmentCount && chunkStreamPos > backendData.segmentChunkStreamPos[segmentsFound])
+            return giveUp();
+        chunkOffset += std::size_t(PNG::toCorrectEndian_u32(chunk)) + 12;
+    }
+    if (segmentsFound < segmentCount || chunkOffset > idatChunks.size())
+        return giveUp();
+    std::size_t const idatChunksEnd = chunkOffset;
+
+    for (std::uint32_t i = 0; i < segmentCount; i++)
+    {
+        bool const isLast = i + 1 == segmentCount;
+        std::size_t const chunksEnd = isLast ? idatChunksEnd : segmentChunkOffsets[i + 1];
+        jobs[i].chunks = { idatChunks.data() + segmentChunkOffsets[i], chunksEnd - segmentChunkOffsets[i] };
+        jobs[i].firstRow = backendData.segmentFirstRows[i];
+        jobs[i].rowCount = (isLast ? height : backendData.segmentFirstRows[i + 1]) - jobs[i].firstRow;
+        jobs[i].isFirst = i == 0;
+        jobs[i].isLast = isLast;
+    }
+
+    RowDecodeInfo const info = makeRowDecodeInfo(textureInfo, backendData, dstImageBuffer, dstRowPitch);
+    std::size_t const totalRowWidth = info.rowWidth + 1;
+    // The filtered data is placed like it is when decompressing it all at once.
+    std::byte* const filteredData = workingMem.data() + idatInputBufferSize;
+
+    // The calling thread takes the first segment, and any segment we could not get a thread for.
+    std::thread threads[FileInfo_PNG_BackendData::maxSegmentCount] = {};
+    for (std::uint32_t i = 1; i < segmentCount; i++)
+    {
+        SegmentJob* const job = &jobs[i];
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+        try
+        {
+            threads[i] = std::thread([job, &info, filteredData]() noexcept { decodeSegment(*job, info, filteredData); });
+        }
+        catch (...)
+        {
+        }
+#else
+        threads[i] = std::thread([job, &info, filteredData]() noexcept { decodeSegment(*job, info, filteredData); });
+#endif
+    }
+    decodeSegment(jobs[0], info, filteredData);
+    for (std::uint32_t i = 1; i < segmentCount; i++)
+    {
+        if (threads[i].joinable())
+            threads[i].join();
+        else
+            decodeSegment(jobs[i], info, filteredData);
+    }
+
+    // The checksum at the end covers all of the segments together.
+    std::uint32_t adler = jobs[0].adler;
+    for (std::uint32_t i = 0; i < segmentCount; i++)
+    {
+        if (!jobs[i].inflated)
+            return giveUp();
+        if (i > 0)
+            adler = static_cast<std::uint32_t>(adler32_combine(
+                adler, 
+                jobs[i].adler, 
+                static_cast<z_off_t>(jobs[i].rowCount * totalRowWidth)));
+    }
+    if (adler != jobs[segmentCount - 1].storedAdler)
+        return giveUp();
+
+    // The rest depend on the last row of the segment before them, which is done by now.
+    for (std::uint32_t i = 1; i < segmentCount; i++)
+    {
+        if (jobs[i].defiltered)
+            continue;
+        for (std::uint32_t y = jobs[i].firstRow; y < jobs[i].firstRow + jobs[i].rowCount; y++)
+        {
+            std::byte* const filteredRow = filteredData + y * totalRowWidth;
+            Result const result = decodeRow(info, y, filteredRow, filteredRow - totalRowWidth);
+            if (!result.isSuccessful())
+                return giveUp();
+        }
+    }
+    // The first segment is never left for later, but its rows can still have a bad filter-type.
+    if (!jobs[0].defiltered)
+        return giveUp();
+
+    hintIdatChunks(stream, backendData, InputStream::AccessHint::DontNeed);
+    stream.seek(backendData.firstIdatChunkStreamPos + idatChunksEnd);
+    return true;
+}
+#else
+std::uint64_t Texas::detail::PNG::calcWorkingMemRequired_Pipelined(
+    TextureInfo const& textureInfo,
+    detail::FileInfo_PNG_BackendData const& backendData) noexcept
+{
+    (void)textureInfo;
+    (void)backendData;
+    return 0;
+}
+#endif
+
+template<typename StreamT>
+Texas::Result Texas::detail::PNG::loadFromStream(
+    StreamT& stream,
+    InflateContext& inflateContext,
+    TextureInfo const& textureInfo,
+    detail::FileInfo_PNG_BackendData const& backendData,
+    ByteSpan dstImageBuffer,
+    std::size_t dstRowPitch,
+    ByteSpan workingMem,
+    bool pipelined) noexcept
 {
     /*
         The algorithm for this divides up the working memory in 2 parts.
     
-        The first is primarily used to temporarily store the IDAT chunk data
+        The first is used to temporarily store the IDAT chunk data
         while we are moving through each IDAT chunk and passing it to zLib.
         This decompressed data gets stored in the second part of the working memory.
-        After the decompression and the defiltering, this first part of the memory
-        will now be used for storing all the colors in the PLTE chunk.
      
         The second part is to store filtered data.
+
+        The colours of the PLTE chunk were already captured when parsing.
     */
 
 
     Result result{};
+
+    bool const isIndexed = backendData.plteChunkDataLength != 0;
+    std::uint64_t const workingMemRequired = calcWorkingMemRequired_Stream(
+        textureInfo.baseDimensions,
+        textureInfo.pixelFormat,
+        isIndexed);
+#if defined(TEXAS_ENABLE_PNG_PIPELINING)
+    if (pipelined)
+    {
+        // Zero means the image is too small to be worth it.
+        std::uint64_t const pipelinedWorkingMemRequired = calcWorkingMemRequired_Pipelined(textureInfo, backendData);
+        if (pipelinedWorkingMemRequired != 0 && workingMem.size() >= pipelinedWorkingMemRequired)
+        {
+            if (backendData.segmentCount != 0 && 
+                workingMem.size() >= workingMemRequired &&
+                loadSegments_Parallel(stream, textureInfo, backendData, dstImageBuffer, dstRowPitch, workingMem))
+                return { ResultType::Success, nullptr };
+            return loadRows_Pipelined(stream, inflateContext, textureInfo, backendData, dstImageBuffer, dstRowPitch, workingMem);
+        }
+    }
+#else
+    (void)pipelined;
+#endif
+    if (workingMem.size() < workingMemRequired)
+        return loadRows_Stream(stream, inflateContext, textureInfo, backendData, dstImageBuffer, dstRowPitch, workingMem);
     
-    std::size_t workingMemFirstSize = backendData.maxIdatChunkDataLength;
-    if (backendData.plteChunkDataLength > workingMemFirstSize)
-        workingMemFirstSize = backendData.plteChunkDataLength;
+    // Each row of filtered data holds an extra byte for the filter-type.
+    std::uint8_t const filteredPixelWidth = isIndexed ? 1 : PNG::getPixelWidth(textureInfo.pixelFormat);
+    std::size_t const filteredDataSize = static_cast<std::size_t>(
+        (textureInfo.baseDimensions.width * filteredPixelWidth + 1) * textureInfo.baseDimensions.height);
     ByteSpan filteredData = {
-        workingMem.data() + workingMemFirstSize,
-        workingMem.size() - workingMemFirstSize };
-
-    stream.seek(backendData.firstIdatChunkStreamPos);
+        workingMem.data() + idatInputBufferSize,
+        filteredDataSize };
 
     // We use the first part of workingMem to store the temporary
     // partial zLib data stream. Then it gets unpacked into filteredData.
     result = decompressIdatChunks_Stream(
         stream,
+        inflateContext,
+        backendData,
         filteredData,
-        { workingMem.data(), backendData.maxIdatChunkDataLength });
+        { workingMem.data(), idatInputBufferSize });
     if (!result.isSuccessful())
         return result;
 
-    if (backendData.plteChunkStreamPos == 0)
+    if (!isIndexed)
     {
-        // If the plteChunk is nullptr, then we are not dealing with indexed colors.
-        result = defilterIntoDstBuffer(textureInfo, dstImageBuffer, filteredData);
+        result = defilterIntoDstBuffer(textureInfo, dstImageBuffer, dstRowPitch, filteredData);
         if (!result.isSuccessful())
             return result;
         return { ResultType::Success, nullptr };
@@ -1100,30 +2303,6 @@ Texas::Result Texas::detail::PNG::loadFromStream(
     else
     {
         // We are dealing with indexed colours.
-        // We first load the palette of colors into workingmem
-        stream.seek(backendData.plteChunkStreamPos);
-
-        std::byte chunkLengthAndTypeBuffer[8] = {};
-        result = stream.read({ chunkLengthAndTypeBuffer, 8 });
-        if (!result.isSuccessful())
-            return result;
-        // Chunk data length is the first entry in the chunk. It's a uint32_t
-        std::uint32_t const chunkDataLength = PNG::toCorrectEndian_u32(chunkLengthAndTypeBuffer);
-        if (chunkDataLength != backendData.plteChunkDataLength)
-            return { ResultType::CorruptFileData, 
-                     "PLTE chunk data length is different from when PNG was parsed." };
-
-        // Chunk type appears after chunk-data-length, so we offset 4 bytes extra.
-        PNG::ChunkType const chunkType = PNG::getChunkType(chunkLengthAndTypeBuffer + sizeof(PNG::ChunkSize_T));
-        if (chunkType != PNG::ChunkType::PLTE)
-            return { ResultType::CorruptFileData, 
-                     "Found no PLTE when de-indexing PNG file. "
-                     "The file has changed since it was parsed." };
-
-        result = stream.read({ workingMem.data(), chunkDataLength });
-        if (!result.isSuccessful())
-            return result;
-
         // We defilter all the pixels (indices) in place.
         result = defilterIndicesInPlace(
             textureInfo.baseDimensions, 
@@ -1137,12 +2316,286 @@ Texas::Result Texas::detail::PNG::loadFromStream(
         ByteSpan defilteredIndices = filteredData;
         result = deindexData(
             textureInfo.baseDimensions,
-            { workingMem.data(), backendData.plteChunkDataLength },
+            { backendData.plteChunkData, backendData.plteChunkDataLength },
             dstImageBuffer,
+            dstRowPitch,
             defilteredIndices);
         if (!result.isSuccessful())
             return result;        
     }
 
     return { ResultType::Success, nullptr };
-}
\ No newline at end of file
+}
+std::uint64_t Texas::detail::PNG::calcWorkingMemRequired_Incremental(
+    TextureInfo const& textureInfo,
+    detail::FileInfo_PNG_BackendData const& backendData) noexcept
+{
+    // Same as decoding one row at a time, except zLib reads
+    // straight from the pushed data, so there is no input buffer.
+    return calcWorkingMemRequired_RowStreaming(
+        textureInfo.baseDimensions,
+        textureInfo.pixelFormat,
+        backendData.plteChunkDataLength != 0) - idatInputBufferSize;
+}
+
+Texas::Result Texas::detail::PNG::beginIncremental(
+    detail::IncrementalDecoder_PNG_BackendData& state,
+    InflateContext& inflateContext,
+    detail::FileInfo_PNG_BackendData const& backendData,
+    ByteSpan workingMem) noexcept
+{
+    Result result = inflateContext.begin();
+    if (!result.isSuccessful())
+        return result;
+
+    state = {};
+    state.inflateContext = &inflateContext;
+    state.filteredRows = workingMem.data();
+    state.section = IncrementalDecoder_PNG_BackendData::Section::IdatData;
+    state.sectionRemaining = backendData.firstIdatChunkDataLength;
+    state.chunkCrc = makeIdatCursor(backendData).chunkCrc;
+    if (state.sectionRemaining == 0)
+    {
+        state.section = IncrementalDecoder_PNG_BackendData::Section::ChunkCrc;
+        state.sectionRemaining = 4;
+    }
+
+    return { ResultType::Success, nullptr };
+}
+
+static Texas::Result Texas::detail::PNG::inflateRows_Incremental(
+    detail::IncrementalDecoder_PNG_BackendData& state,
+    TextureInfo const& textureInfo,
+    detail::FileInfo_PNG_BackendData const& backendData,
+    ByteSpan dstImageBuffer,
+    ConstByteSpan input) noexcept
+{
+    Result result{};
+
+    bool const isIndexed = backendData.plteChunkDataLength != 0;
+    std::size_t const width = static_cast<std::size_t>(textureInfo.baseDimensions.width);
+    std::uint8_t const pixelWidth = isIndexed ? 1 : PNG::getPixelWidth(textureInfo.pixelFormat);
+    // Does not include the byte for filter-type.
+    std::size_t const rowWidth = pixelWidth * width;
+    // Includes the byte for filter-type.
+    std::size_t const totalRowWidth = rowWidth + 1;
+    // The row of the destination buffer a pixel-row is defiltered into.
+    std::size_t const dstRowPitch = isIndexed ? width * 3 : rowWidth;
+    ConstByteSpan const paletteData = { backendData.plteChunkData, backendData.plteChunkDataLength };
+
+    z_stream& zLibDecompressJob = state.inflateContext->stream();
+    // zLib does not write through next_in.
+    zLibDecompressJob.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(input.data()));
+    zLibDecompressJob.avail_in = static_cast<uInt>(input.size());
+    while (zLibDecompressJob.avail_in > 0 && !state.zLibStreamEnded)
+    {
+        if (state.rowsReady == textureInfo.baseDimensions.height)
+        {
+            // Every row is done, but zLib only checks the Adler-32 once it reaches the end of the data-stream.
+            std::byte excess = {};
+            zLibDecompressJob.next_out = reinterpret_cast<Bytef*>(&excess);
+            zLibDecompressJob.avail_out = 1;
+            int const zLibError = inflate(&zLibDecompressJob, Z_NO_FLUSH);
+            if (zLibDecompressJob.avail_out == 0)
+                return { ResultType::CorruptFileData, 
+                         "PNG IDAT data decompresses to more data than the image can hold." };
+            else if (zLibError != Z_OK && zLibError != Z_STREAM_END)
+                return { ResultType::CorruptFileData, 
+                         "zLib reported a data error while running inflate on PNG IDAT data." };
+            state.zLibStreamEnded = zLibError == Z_STREAM_END;
+            continue;
+        }
+
+        std::uint32_t const y = state.rowsReady;
+        std::byte* const filteredRow = state.filteredRows + (isIndexed ? (y % 2) * totalRowWidth : 0);
+        // Start decompressing into the row if we didn't already start on it in an earlier push.
+        if (zLibDecompressJob.avail_out == 0)
+        {
+            zLibDecompressJob.next_out = reinterpret_cast<Bytef*>(filteredRow);
+            zLibDecompressJob.avail_out = static_cast<uInt>(totalRowWidth);
+        }
+
+        int const zLibError = inflate(&zLibDecompressJob, Z_NO_FLUSH);
+        if (zLibError == Z_STREAM_END && zLibDecompressJob.avail_out > 0)
+            return { ResultType::CorruptFileData, 
+                     "PNG image-data ended before all rows of the image were decompressed." };
+        else if (zLibError != Z_OK && zLibError != Z_STREAM_END)
+            return { ResultType::CorruptFileData, 
+                     "zLib reported a data error while running inflate on PNG IDAT data." };
+        if (zLibDecompressJob.avail_out > 0)
+            // zLib used up the input without finishing the row.
+            continue;
+
+        PNG::FilterType const filterType = static_cast<PNG::FilterType>(filteredRow[0]);
+        std::byte* const dstRow = dstImageBuffer.data() + y * dstRowPitch;
+        if (isIndexed)
+        {
+            // Defilter the indices in place, then look them up in the palette.
+            std::byte* const indices = filteredRow + 1;
+            std::byte const* const prevIndices = y > 0 ? state.filteredRows + ((y - 1) % 2) * totalRowWidth + 1 : nullptr;
+            result = defilterRow(filterType, indices, indices, prevIndices, rowWidth, pixelWidth);
+            if (!result.isSuccessful())
+                return result;
+            result = deindexRow(paletteData, dstRow, indices, width);
+        }
+        else
+        {
+            std::byte const* const prevRow = y > 0 ? dstRow - dstRowPitch : nullptr;
+            result = defilterRow(filterType, dstRow, filteredRow + 1, prevRow, rowWidth, pixelWidth);
+        }
+        if (!result.isSuccessful())
+            return result;
+        state.rowsReady += 1;
+
+        if (zLibError == Z_STREAM_END)
+        {
+            if (state.rowsReady < textureInfo.baseDimensions.height)
+                return { ResultType::CorruptFileData, 
+                         "PNG image-data ended before all rows of the image were decompressed." };
+            state.zLibStreamEnded = true;
+        }
+    }
+
+    return { ResultType::Success, nullptr };
+}
+
+Texas::Result Texas::detail::PNG::decodeIncremental(
+    detail::IncrementalDecoder_PNG_BackendData& state,
+    TextureInfo const& textureInfo,
+    detail::FileInfo_PNG_BackendData const& backendData,
+    ByteSpan dstImageBuffer,
+    ConstByteSpan data) noexcept
+{
+    using Section = IncrementalDecoder_PNG_BackendData::Section;
+
+    Result result{};
+
+    std::size_t offset = 0;
+    while (offset < data.size() && state.section != Section::Done)
+    {
+        std::size_t const bytesLeft = data.size() - offset;
+        if (state.section == Section::ChunkHeader)
+        {
+            std::size_t amount = sizeof(state.chunkHeaderBuffer) - state.chunkHeaderBytesRead;
+            if (amount > bytesLeft)
+                amount = bytesLeft;
+            std::memcpy(state.chunkHeaderBuffer + state.chunkHeaderBytesRead, data.data() + offset, amount);
+            state.chunkHeaderBytesRead += static_cast<std::uint8_t>(amount);
+            offset += amount;
+            if (state.chunkHeaderBytesRead < sizeof(state.chunkHeaderBuffer))
+                break;
+            state.chunkHeaderBytesRead = 0;
+
+            // Chunk type appears after chunk-data-length, so we offset 4 bytes extra.
+            PNG::ChunkType const chunkType = PNG::getChunkType(state.chunkHeaderBuffer + sizeof(PNG::ChunkSize_T));
+            if (chunkType != PNG::ChunkType::IDAT && state.zLibStreamEnded)
+            {
+                // The chunk after the IDAT chunks, which were all checked.
+                state.section = Section::Done;
+                break;
+            }
+            if (chunkType != PNG::ChunkType::IDAT)
+            {
+                if (state.rowsReady == textureInfo.baseDimensions.height)
+                    return { ResultType::CorruptFileData, 
+                             "PNG IDAT chunks ended before the end of the zLib data-stream." };
+                return { ResultType::CorruptFileData, 
+                         "PNG IDAT chunks ended before all rows of the image were decompressed." };
+            }
+            state.sectionRemaining = PNG::toCorrectEndian_u32(state.chunkHeaderBuffer);
+            state.chunkCrc = PNG::updateChunkCrc(0, { state.chunkHeaderBuffer + sizeof(PNG::ChunkSize_T), sizeof(ChunkType_T) });
+            state.section = state.sectionRemaining == 0 ? Section::ChunkCrc : Section::IdatData;
+            if (state.section == Section::ChunkCrc)
+                state.sectionRemaining = 4;
+        }
+        else if (state.section == Section::IdatData)
+        {
+            std::size_t amount = state.sectionRemaining;
+            if (amount > bytesLeft)
+                amount = bytesLeft;
+            result = inflateRows_Incremental(
+                state, 
+                textureInfo, 
+                backendData, 
+                dstImageBuffer, 
+                { data.data() + offset, amount });
+            if (!result.isSuccessful())
+                return result;
+            state.chunkCrc = PNG::updateChunkCrc(state.chunkCrc, { data.data() + offset, amount });
+            offset += amount;
+            state.sectionRemaining -= static_cast<std::uint32_t>(amount);
+            if (state.sectionRemaining == 0)
+            {
+                state.section = Section::ChunkCrc;
+                state.sectionRemaining = 4;
+            }
+        }
+        else if (state.section == Section::ChunkCrc)
+        {
+            std::size_t amount = state.sectionRemaining;
+            if (amount > bytesLeft)
+                amount = bytesLeft;
+            // The CRC field can be split across two pushes as well.
+            std::memcpy(state.chunkCrcBuffer + sizeof(state.chunkCrcBuffer) - state.sectionRemaining, data.data() + offset, amount);
+            offset += amount;
+            state.sectionRemaining -= static_cast<std::uint32_t>(amount);
+            if (state.sectionRemaining == 0)
+            {
+                result = PNG::checkChunkCrc(state.chunkCrcBuffer, state.chunkCrc);
+                if (!result.isSuccessful())
+                    return result;
+                state.section = Section::ChunkHeader;
+            }
+        }
+
+        // Rows are usable as soon as they're decoded,
+        // but the image is only done once its Adler-32 has been checked.
+        // With CRC checks, it's done once the CRCs of all IDAT chunks have been too, see the chunk header above.
+#if !defined(TEXAS_ENABLE_PNG_CRC_CHECK)
+        if (state.zLibStreamEnded)
+            state.section = Section::Done;
+#endif
+    }
+
+    return { ResultType::Success, nullptr };
+}
+
+namespace Texas::detail::PNG
+{
+    // Texas has entry points for both of these stream types.
+    template Result parseStream<InputStream>(
+        InputStream& stream,
+        TextureInfo& metaData,
+        std::uint64_t& workingMemRequired,
+        std::uint64_t& minWorkingMemRequired,
+        detail::FileInfo_PNG_BackendData& backendData,
+        ConstByteSpan fileStart,
+        bool stopAtFirstIdat) noexcept;
+    template Result parseStream<MemoryInputStream>(
+        MemoryInputStream& stream,
+        TextureInfo& metaData,
+        std::uint64_t& workingMemRequired,
+        std::uint64_t& minWorkingMemRequired,
+        detail::FileInfo_PNG_BackendData& backendData,
+        ConstByteSpan fileStart,
+        bool stopAtFirstIdat) noexcept;
+
+    template Result loadFromStream<InputStream>(
+        InputStream& stream,
+        InflateContext& inflateContext,
+        TextureInfo const& textureInfo,
+        detail::FileInfo_PNG_BackendData const& backendData,
+        ByteSpan dstImageBuffer,
+        std::size_t dstRowPitch,
+        ByteSpan workingMem,
+        bool pipelined) noexcept;
+    template Result loadFromStream<MemoryInputStream>(
+        MemoryInputStream& stream,
+        InflateContext& inflateContext,
+        TextureInfo const& textureInfo,
+        detail::FileInfo_PNG_BackendData const& backendData,
+        ByteSpan dstImageBuffer,
+        std::size_t dstRowPitch,
+        ByteSpan workingMem,
+        bool pipelined) noexcept;
+}
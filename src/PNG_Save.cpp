@@ -0,0 +1,585 @@
+#ifdef _MSC_VER
+#	define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include "Texas/PNG_Save.hpp"
+#include "PNG.hpp"
+#include "NumericLimits.hpp"
+#include "Texas/Tools.hpp"
+#include "Texas/detail/FileInfo_BackendData.hpp"
+
+#include "zlib/zlib.h"
+
+// For memcpy
+#include <cstring>
+// For std::FILE
+#include <cstdio>
+#include <new>
+
+static_assert(Texas::PNG::maxSegmentCount == Texas::detail::FileInfo_PNG_BackendData::maxSegmentCount,
+              "PNG files saved with more segments than the loader keeps track of would be decoded serially.");
+
+namespace Texas::detail::PNG
+{
+    // IDAT chunks are split at this size, the same as most PNG encoders do.
+    constexpr std::uint32_t maxIdatChunkDataLength = 65536;
+    // Size of a chunk's length, type and CRC fields.
+    constexpr std::uint32_t chunkOverhead = 12;
+    // Size of each entry in the 'txSG' chunk. See PNG_Read.cpp.
+    constexpr std::uint32_t txSG_SegmentEntrySize = 8;
+
+    // Returns the PNG colour type of the pixel format, or -1 if it can't be saved as PNG.
+    [[nodiscard]] static int toColorType(PixelFormat pFormat) noexcept;
+
+    static void writeU32BigEndian(unsigned char* dst, std::uint32_t value) noexcept;
+
+    [[nodiscard]] static Result writeChunk(
+        OutputStream& stream,
+        char const* chunkType,
+        unsigned char const* data,
+        std::uint32_t dataLength) noexcept;
+
+    [[nodiscard]] static std::uint8_t paethPredictor(int a, int b, int c) noexcept;
+
+    /*
+        Filters the row with every filter type allowed, and writes the one with
+        the lowest sum of absolute differences to dst, including its filter-type byte.
+        This is the heuristic recommended by the PNG specification.
+
+        The first row of a segment has no row above it that belongs to the same segment.
+        Only the None and Sub filters are used for them, so each segment can be defiltered on its own.
+        prevRow is ignored in that case.
+
+        candidates must have room for 4 rows, not counting the filter-type byte.
+    */
+    static void filterRow(
+        std::uint8_t const* row,
+        std::uint8_t const* prevRow,
+        std::size_t rowWidth,
+        std::size_t bytesPerPixel,
+        bool firstRowInSegment,
+        std::uint8_t* candidates,
+        std::uint8_t* dst) noexcept;
+
+    // Takes working-memory from allocator, or from the heap if allocator is nullptr.
+    [[nodiscard]] static std::uint8_t* allocateWorkingMem(Allocator* allocator, std::size_t size) noexcept;
+
+    static void deallocateWorkingMem(Allocator* allocator, std::uint8_t* ptr) noexcept;
+
+    // Lets zLib's allocations go through our allocator.
+    [[nodiscard]] static voidpf zLibAllocate(voidpf opaque, uInt items, uInt size);
+
+    static void zLibDeallocate(voidpf opaque, voidpf address);
+
+    // allocator may only be nullptr if dynamic allocations are enabled.
+    [[nodiscard]] static Result saveToStream(
+        TextureInfo const& texInfo,
+        ConstByteSpan imageData,
+        OutputStream& stream,
+        Allocator* allocator,
+        std::uint32_t segmentCount) noexcept;
+
+    [[nodiscard]] static Result saveToFile(
+        char const* path,
+        TextureInfo const& texInfo,
+        ConstByteSpan imageData,
+        Allocator* allocator,
+        std::uint32_t segmentCount) noexcept;
+}
+
+static int Texas::detail::PNG::toColorType(PixelFormat pFormat) noexcept
+{
+    switch (pFormat)
+    {
+    case PixelFormat::R_8:
+        return 0;
+    case PixelFormat::RG_8:
+        return 4;
+    case PixelFormat::RGB_8:
+        return 2;
+    case PixelFormat::RGBA_8:
+        return 6;
+    default:
+        return -1;
+    }
+}
+
+static void Texas::detail::PNG::writeU32BigEndian(unsigned char* dst, std::uint32_t value) noexcept
+{
+    dst[0] = static_cast<unsigned char>(value >> 24);
+    dst[1] = static_cast<unsigned char>(value >> 16);
+    dst[2] = static_cast<unsigned char>(value >> 8);
+    dst[3] = static_cast<unsigned char>(value);
+}
+
+static Texas::Result Texas::detail::PNG::writeChunk(
+    OutputStream& stream,
+    char const* chunkType,
+    unsigned char const* data,
+    std::uint32_t dataLength) noexcept
+{
+    unsigned char lengthAndType[8] = {};
+    writeU32BigEndian(lengthAndType, dataLength);
+    std::memcpy(lengthAndType + 4, chunkType, 4);
+
+    // The CRC covers the chunk type and data, but not the length.
+    uLong crc = crc32(0, lengthAndType + 4, 4);
+    if (dataLength > 0)
+        crc = crc32(crc, data, dataLength);
+    unsigned char crcBuffer[4] = {};
+    writeU32BigEndian(crcBuffer, static_cast<std::uint32_t>(crc));
+
+    Result result = stream.write(reinterpret_cast<char const*>(lengthAndType), sizeof(lengthAndType));
+    if (!result.isSuccessful())
+        return result;
+    if (dataLength > 0)
+    {
+        result = stream.write(reinterpret_cast<char const*>(data), dataLength);
+        if (!result.isSuccessful())
+            return result;
+    }
+    return stream.write(reinterpret_cast<char const*>(crcBuffer), sizeof(crcBuffer));
+}
+
+static std::uint8_t Texas::detail::PNG::paethPredictor(int a, int b, int c) noexcept
+{
+    int const p = a + b - c;
+    int const pa = p > a ? p - a : a - p;
+    int const pb = p > b ? p - b : b - p;
+    int const pc = p > c ? p - c : c - p;
+    if (pa <= pb && pa <= pc)
+        return static_cast<std::uint8_t>(a);
+    else if (pb <= pc)
+        return static_cast<std::uint8_t>(b);
+    else
+        return static_cast<std::uint8_t>(c);
+}
+
+static void Texas::detail::PNG::filterRow(
+    std::uint8_t const* row,
+    std::uint8_t const* prevRow,
+    std::size_t rowWidth,
+    std::size_t bytesPerPixel,
+    bool firstRowInSegment,
+    std::uint8_t* candidates,
+    std::uint8_t* dst) noexcept
+{
+    // The filtered row is treated as signed bytes, so values close to 0 and 255 both count as small.
+    auto const absValue = [](std::uint8_t value) -> std::uint32_t
+    {
+        return value < 128 ? value : 256u - value;
+    };
+
+    std::uint8_t* const sub = candidates;
+    std::uint8_t* const up = candidates + rowWidth;
+    std::uint8_t* const average = candidates + rowWidth * 2;
+    std::uint8_t* const paeth = candidates + rowWidth * 3;
+
+    std::uint64_t sums[5] = {};
+    if (firstRowInSegment)
+    {
+        for (std::size_t i = 0; i < rowWidth; i++)
+        {
+            std::uint8_t const a = i >= bytesPerPixel ? row[i - bytesPerPixel] : 0;
+            sub[i] = static_cast<std::uint8_t>(row[i] - a);
+            sums[0] += absValue(row[i]);
+            sums[1] += absValue(sub[i]);
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < rowWidth; i++)
+        {
+            std::uint8_t const a = i >= bytesPerPixel ? row[i - bytesPerPixel] : 0;
+            std::uint8_t const b = prevRow[i];
+            std::uint8_t const c = i >= bytesPerPixel ? prevRow[i - bytesPerPixel] : 0;
+            sub[i] = static_cast<std::uint8_t>(row[i] - a);
+            up[i] = static_cast<std::uint8_t>(row[i] - b);
+            average[i] = static_cast<std::uint8_t>(row[i] - ((a + b) >> 1));
+            paeth[i] = static_cast<std::uint8_t>(row[i] - paethPredictor(a, b, c));
+            sums[0] += absValue(row[i]);
+            sums[1] += absValue(sub[i]);
+            sums[2] += absValue(up[i]);
+            sums[3] += absValue(average[i]);
+            sums[4] += absValue(paeth[i]);
+        }
+    }
+
+    std::size_t const filterCount = firstRowInSegment ? 2 : 5;
+    std::size_t bestFilter = 0;
+    for (std::size_t filter = 1; filter < filterCount; filter++)
+    {
+        if (sums[filter] < sums[bestFilter])
+            bestFilter = filter;
+    }
+
+    dst[0] = static_cast<std::uint8_t>(bestFilter);
+    if (bestFilter == static_cast<std::size_t>(FilterType::None))
+        std::memcpy(dst + 1, row, rowWidth);
+    else
+        std::memcpy(dst + 1, candidates + rowWidth * (bestFilter - 1), rowWidth);
+}
+
+Texas::Result Texas::PNG::canSave(TextureInfo const& texInfo) noexcept
+{
+    if (texInfo.textureType != TextureType::Texture2D)
+        return { ResultType::InvalidLibraryUsage, "PNG format only supports 2D textures." };
+    if (texInfo.mipCount != 1)
+        return { ResultType::InvalidLibraryUsage, "PNG format does not support more than one mip level." };
+    if (texInfo.layerCount != 1)
+        return { ResultType::InvalidLibraryUsage, "PNG format does not support more than one array layer." };
+    if (detail::PNG::toColorType(texInfo.pixelFormat) < 0)
+        return { ResultType::FileNotSupported,
+                 "Texas can only save PNG files with pixel-format R_8, RG_8, RGB_8 or RGBA_8." };
+    if (texInfo.channelType != ChannelType::UnsignedNormalized)
+        return { ResultType::FileNotSupported,
+                 "Texas can only save PNG files with channel-type UnsignedNormalized." };
+
+    if (texInfo.baseDimensions.width == 0)
+        return { ResultType::InvalidLibraryUsage,
+                 "Cannot export texture with field 'width' equal to 0 as PNG format." };
+    if (texInfo.baseDimensions.height == 0)
+        return { ResultType::InvalidLibraryUsage,
+                 "Cannot export texture with field 'height' equal to 0 as PNG format." };
+    // The PNG specification limits both dimensions to the max value of a signed 32-bit integer.
+    if (texInfo.baseDimensions.width > detail::maxValue<std::uint32_t>() / 2)
+        return { ResultType::InvalidLibraryUsage,
+                 "Cannot export texture with field 'width' higher than int32 max value as PNG format." };
+    if (texInfo.baseDimensions.height > detail::maxValue<std::uint32_t>() / 2)
+        return { ResultType::InvalidLibraryUsage,
+                 "Cannot export texture with field 'height' higher than int32 max value as PNG format." };
+
+    return { ResultType::Success, nullptr };
+}
+
+static std::uint8_t* Texas::detail::PNG::allocateWorkingMem(Allocator* allocator, std::size_t size) noexcept
+{
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+    if (allocator == nullptr)
+        return new(std::nothrow) std::uint8_t[size];
+#endif
+    return reinterpret_cast<std::uint8_t*>(allocator->allocate(size, Allocator::MemoryType::WorkingData));
+}
+
+static void Texas::detail::PNG::deallocateWorkingMem(Allocator* allocator, std::uint8_t* ptr) noexcept
+{
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+    if (allocator == nullptr)
+    {
+        delete[] ptr;
+        return;
+    }
+#endif
+    allocator->deallocate(reinterpret_cast<std::byte*>(ptr), Allocator::MemoryType::WorkingData);
+}
+
+static voidpf Texas::detail::PNG::zLibAllocate(voidpf opaque, uInt items, uInt size)
+{
+    Allocator* const allocator = static_cast<Allocator*>(opaque);
+    return allocator->allocate(static_cast<std::size_t>(items) * size, Allocator::MemoryType::WorkingData);
+}
+
+static void Texas::detail::PNG::zLibDeallocate(voidpf opaque, voidpf address)
+{
+    Allocator* const allocator = static_cast<Allocator*>(opaque);
+    allocator->deallocate(static_cast<std::byte*>(address), Allocator::MemoryType::WorkingData);
+}
+
+static Texas::Result Texas::detail::PNG::saveToFile(
+    char const* path,
+    TextureInfo const& texInfo,
+    ConstByteSpan imageData,
+    Allocator* allocator,
+    std::uint32_t segmentCount) noexcept
+{
+    struct FileIOWrapper : OutputStream
+    {
+        std::FILE* file = nullptr;
+        virtual Result write(char const* data, std::uint64_t size) noexcept override
+        {
+             std::size_t objectsWritten = fwrite(data, 1, static_cast<std::size_t>(size), file);
+             if (objectsWritten < size)
+                 return { ResultType::PrematureEndOfFile, "Writing to file was not successful." };
+             return { ResultType::Success, nullptr };
+        }
+        virtual ~FileIOWrapper()
+        {
+            if (file != nullptr)
+            {
+                std::fclose(file);
+            }
+        }
+    };
+
+    FileIOWrapper temp{};
+    temp.file = std::fopen(path, "wb");
+    if (temp.file == nullptr)
+        return { ResultType::CouldNotOpenFile, "Could not open file." };
+
+    return saveToStream(texInfo, imageData, temp, allocator, segmentCount);
+}
+
+Texas::Result Texas::PNG::saveToStream(
+    TextureInfo const& texInfo,
+    ConstByteSpan imageData,
+    OutputStream& stream,
+    Allocator& allocator,
+    std::uint32_t segmentCount) noexcept
+{
+    return detail::PNG::saveToStream(texInfo, imageData, stream, &allocator, segmentCount);
+}
+
+Texas::Result Texas::PNG::saveToStream(
+    Texture const& texture,
+    OutputStream& stream,
+    Allocator& allocator,
+    std::uint32_t segmentCount) noexcept
+{
+    return detail::PNG::saveToStream(texture.textureInfo(), texture.rawBufferSpan(), stream, &allocator, segmentCount);
+}
+
+Texas::Result Texas::PNG::saveToFile(
+    char const* path,
+    TextureInfo const& texInfo,
+    ConstByteSpan imageData,
+    Allocator& allocator,
+    std::uint32_t segmentCount) noexcept
+{
+    return detail::PNG::saveToFile(path, texInfo, imageData, &allocator, segmentCount);
+}
+
+Texas::Result Texas::PNG::saveToFile(
+    char const* path,
+    Texture const& texture,
+    Allocator& allocator,
+    std::uint32_t segmentCount) noexcept
+{
+    return detail::PNG::saveToFile(path, texture.textureInfo(), texture.rawBufferSpan(), &allocator, segmentCount);
+}
+
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+Texas::Result Texas::PNG::saveToStream(
+    TextureInfo const& texInfo,
+    ConstByteSpan imageData,
+    OutputStream& stream,
+    std::uint32_t segmentCount) noexcept
+{
+    return detail::PNG::saveToStream(texInfo, imageData, stream, nullptr, segmentCount);
+}
+
+Texas::Result Texas::PNG::saveToStream(Texture const& texture, OutputStream& stream, std::uint32_t segmentCount) noexcept
+{
+    return detail::PNG::saveToStream(texture.textureInfo(), texture.rawBufferSpan(), stream, nullptr, segmentCount);
+}
+
+Texas::Result Texas::PNG::saveToFile(
+    char const* path,
+    TextureInfo const& texInfo,
+    ConstByteSpan imageData,
+    std::uint32_t segmentCount) noexcept
+{
+    return detail::PNG::saveToFile(path, texInfo, imageData, nullptr, segmentCount);
+}
+
+Texas::Result Texas::PNG::saveToFile(char const* path, Texture const& texture, std::uint32_t segmentCount) noexcept
+{
+    return detail::PNG::saveToFile(path, texture.textureInfo(), texture.rawBufferSpan(), nullptr, segmentCount);
+}
+#endif
+
+static Texas::Result Texas::detail::PNG::saveToStream(
+    TextureInfo const& texInfo,
+    ConstByteSpan imageData,
+    OutputStream& stream,
+    Allocator* allocator,
+    std::uint32_t segmentCount) noexcept
+{
+    Result result = Texas::PNG::canSave(texInfo);
+    if (!result.isSuccessful())
+        return result;
+
+    if (segmentCount == 0 || segmentCount > Texas::PNG::maxSegmentCount)
+        return { ResultType::InvalidLibraryUsage,
+                 "segmentCount must be atleast 1 and no higher than Texas::PNG::maxSegmentCount." };
+    std::uint32_t const height = static_cast<std::uint32_t>(texInfo.baseDimensions.height);
+    if (segmentCount > height)
+        segmentCount = height;
+
+    std::uint64_t const rowWidth = calculateRowSize(texInfo.baseDimensions, texInfo.pixelFormat);
+    std::uint64_t const totalSize = rowWidth * height;
+    if (imageData.data() == nullptr)
+        return { ResultType::InvalidLibraryUsage, "Passed in nullptr for image-data." };
+    if (imageData.size() < totalSize)
+        return { ResultType::InvalidLibraryUsage, "imageData is too small to hold the image-data." };
+    // zLib's buffer sizes are uInt, which is atleast 32-bit, and the compressed data is written in one go.
+    if ((totalSize + height) > detail::maxValue<std::uint32_t>() / 2)
+        return { ResultType::FileNotSupported, "Texture is too large to be compressed by Texas' PNG writer." };
+
+    std::size_t const bytesPerPixel = static_cast<std::size_t>(rowWidth / texInfo.baseDimensions.width);
+
+    z_stream zStream{};
+    if (allocator != nullptr)
+    {
+        zStream.zalloc = &detail::PNG::zLibAllocate;
+        zStream.zfree = &detail::PNG::zLibDeallocate;
+        zStream.opaque = allocator;
+    }
+    if (deflateInit(&zStream, 6) != Z_OK)
+        return { ResultType::UnknownError, "zLib failed to initialize deflate." };
+
+    // Every Z_FULL_FLUSH adds a few bytes on top of what deflateBound accounts for.
+    std::size_t const compressedCapacity =
+        static_cast<std::size_t>(deflateBound(&zStream, static_cast<uLong>(totalSize + height)) + 16 * segmentCount);
+    std::size_t const filterMemSize = static_cast<std::size_t>(rowWidth * 4 + rowWidth + 1);
+    std::uint8_t* const mem = detail::PNG::allocateWorkingMem(allocator, compressedCapacity + filterMemSize);
+    if (mem == nullptr)
+    {
+        deflateEnd(&zStream);
+        if (allocator != nullptr)
+            return { ResultType::InvalidLibraryUsage, "Allocator returned nullptr when attempting to allocate working-memory." };
+        return { ResultType::UnknownError, "Failed to allocate memory for the compressed image-data." };
+    }
+    std::uint8_t* const compressedData = mem;
+    std::uint8_t* const filterCandidates = mem + compressedCapacity;
+    std::uint8_t* const filteredRow = filterCandidates + rowWidth * 4;
+
+    zStream.next_out = compressedData;
+    zStream.avail_out = static_cast<uInt>(compressedCapacity);
+
+    // Where each segment's compressed data starts, and the last entry is where it all ends.
+    std::size_t segmentOffsets[Texas::PNG::maxSegmentCount + 1] = {};
+    std::uint32_t segmentFirstRows[Texas::PNG::maxSegmentCount] = {};
+    for (std::uint32_t i = 0; i < segmentCount; i++)
+        segmentFirstRows[i] = static_cast<std::uint32_t>(std::uint64_t(height) * i / segmentCount);
+
+    std::uint8_t const* const srcData = reinterpret_cast<std::uint8_t const*>(imageData.data());
+    std::uint32_t segmentIndex = 0;
+    bool deflateFailed = false;
+    for (std::uint32_t y = 0; y < height && !deflateFailed; y++)
+    {
+        bool const firstRowInSegment = segmentIndex < segmentCount && y == segmentFirstRows[segmentIndex];
+        if (firstRowInSegment)
+        {
+            if (segmentIndex > 0)
+            {
+                // Lets the next segment be decompressed without any of the data before it.
+                // zLib still reads from next_in when flushing, so it must point at something.
+                zStream.next_in = filteredRow;
+                zStream.avail_in = 0;
+                if (deflate(&zStream, Z_FULL_FLUSH) != Z_OK || zStream.avail_out == 0)
+                    deflateFailed = true;
+            }
+            segmentOffsets[segmentIndex] = static_cast<std::size_t>(zStream.total_out);
+            segmentIndex += 1;
+        }
+
+        std::uint8_t const* const row = srcData + rowWidth * y;
+        detail::PNG::filterRow(
+            row,
+            y > 0 ? row - rowWidth : nullptr,
+            static_cast<std::size_t>(rowWidth),
+            bytesPerPixel,
+            firstRowInSegment,
+            filterCandidates,
+            filteredRow);
+
+        zStream.next_in = filteredRow;
+        zStream.avail_in = static_cast<uInt>(rowWidth + 1);
+        // The output buffer is large enough that deflate consumes the whole row in one call.
+        if (deflate(&zStream, Z_NO_FLUSH) != Z_OK || zStream.avail_in != 0)
+            deflateFailed = true;
+    }
+    if (!deflateFailed && deflate(&zStream, Z_FINISH) != Z_STREAM_END)
+        deflateFailed = true;
+    segmentOffsets[segmentCount] = static_cast<std::size_t>(zStream.total_out);
+    deflateEnd(&zStream);
+    if (deflateFailed)
+    {
+        detail::PNG::deallocateWorkingMem(allocator, mem);
+        return { ResultType::UnknownError, "zLib failed to compress the image-data." };
+    }
+
+    // Each segment starts at a new IDAT chunk, so the file has this many IDAT chunks in total.
+    std::uint64_t idatChunkCount = 0;
+    for (std::uint32_t i = 0; i < segmentCount; i++)
+    {
+        std::size_t const segmentSize = segmentOffsets[i + 1] - segmentOffsets[i];
+        idatChunkCount += (segmentSize + detail::PNG::maxIdatChunkDataLength - 1) / detail::PNG::maxIdatChunkDataLength;
+    }
+    // The 'txSG' chunk stores offsets to the IDAT chunks as uint32.
+    std::uint64_t const txSG_ChunkSize = detail::PNG::chunkOverhead +
+        std::uint64_t(detail::PNG::txSG_SegmentEntrySize) * (segmentCount - 1);
+    if (segmentCount > 1 &&
+        txSG_ChunkSize + segmentOffsets[segmentCount] + idatChunkCount * detail::PNG::chunkOverhead > detail::maxValue<std::uint32_t>())
+    {
+        detail::PNG::deallocateWorkingMem(allocator, mem);
+        return { ResultType::FileNotSupported,
+                 "Compressed image-data is too large to be split into segments. Save it with a segmentCount of 1." };
+    }
+
+    result = stream.write(reinterpret_cast<char const*>(detail::PNG::identifier), sizeof(detail::PNG::identifier));
+
+    if (result.isSuccessful())
+    {
+        unsigned char ihdrData[13] = {};
+        detail::PNG::writeU32BigEndian(ihdrData, static_cast<std::uint32_t>(texInfo.baseDimensions.width));
+        detail::PNG::writeU32BigEndian(ihdrData + 4, height);
+        // Bit depth
+        ihdrData[8] = 8;
+        ihdrData[9] = static_cast<unsigned char>(detail::PNG::toColorType(texInfo.pixelFormat));
+        // Compression method, filter method and interlace method are all 0.
+        result = detail::PNG::writeChunk(stream, "IHDR", ihdrData, sizeof(ihdrData));
+    }
+
+    if (result.isSuccessful() && texInfo.colorSpace == ColorSpace::sRGB)
+    {
+        // Rendering intent 'Perceptual'
+        unsigned char const srgbData[1] = { 0 };
+        result = detail::PNG::writeChunk(stream, "sRGB", srgbData, sizeof(srgbData));
+    }
+
+    if (result.isSuccessful() && segmentCount > 1)
+    {
+        unsigned char txSG_Data[detail::PNG::txSG_SegmentEntrySize * (Texas::PNG::maxSegmentCount - 1)] = {};
+        std::uint64_t chunkOffset = txSG_ChunkSize;
+        for (std::uint32_t i = 1; i < segmentCount; i++)
+        {
+            std::size_t const prevSegmentSize = segmentOffsets[i] - segmentOffsets[i - 1];
+            std::uint64_t const prevChunkCount =
+                (prevSegmentSize + detail::PNG::maxIdatChunkDataLength - 1) / detail::PNG::maxIdatChunkDataLength;
+            chunkOffset += prevSegmentSize + prevChunkCount * detail::PNG::chunkOverhead;
+
+            unsigned char* const entry = txSG_Data + (i - 1) * detail::PNG::txSG_SegmentEntrySize;
+            detail::PNG::writeU32BigEndian(entry, segmentFirstRows[i]);
+            detail::PNG::writeU32BigEndian(entry + 4, static_cast<std::uint32_t>(chunkOffset));
+        }
+        result = detail::PNG::writeChunk(
+            stream,
+            "txSG",
+            txSG_Data,
+            detail::PNG::txSG_SegmentEntrySize * (segmentCount - 1));
+    }
+
+    for (std::uint32_t i = 0; i < segmentCount && result.isSuccessful(); i++)
+    {
+        std::size_t offset = segmentOffsets[i];
+        while (offset < segmentOffsets[i + 1] && result.isSuccessful())
+        {
+            std::size_t chunkDataLength = segmentOffsets[i + 1] - offset;
+            if (chunkDataLength > detail::PNG::maxIdatChunkDataLength)
+                chunkDataLength = detail::PNG::maxIdatChunkDataLength;
+            result = detail::PNG::writeChunk(
+                stream,
+                "IDAT",
+                compressedData + offset,
+                static_cast<std::uint32_t>(chunkDataLength));
+            offset += chunkDataLength;
+        }
+    }
+
+    detail::PNG::deallocateWorkingMem(allocator, mem);
+
+    if (!result.isSuccessful())
+        return result;
+    return detail::PNG::writeChunk(stream, "IEND", nullptr, 0);
+}
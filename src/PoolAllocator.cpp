@@ -0,0 +1,232 @@
+#include "Texas/PoolAllocator.hpp"
+
+#include <cstring>
+#include <new>
+
+namespace Texas::detail
+{
+    // Every block starts with a header that stores its size-class,
+    // the pointer handed out is right after it.
+    constexpr std::size_t poolHeaderSize = alignof(std::max_align_t) > sizeof(std::uint32_t) ?
+        alignof(std::max_align_t) :
+        sizeof(std::uint32_t);
+    // Size-class stored in the header of blocks that are too large to be pooled.
+    constexpr std::uint32_t unpooledSizeClass = PoolAllocator::sizeClassCount;
+
+    // Returns the index of the highest set bit. value can not be 0.
+    [[nodiscard]] static std::uint32_t highestBit(std::size_t value) noexcept
+    {
+        std::uint32_t returnVal = 0;
+        while (value >>= 1)
+            returnVal++;
+        return returnVal;
+    }
+
+    /*
+        Size-classes are 2^k + i * 2^(k-2) for i in [0, 4) and k starting at 8,
+        so no allocation wastes more than 25% of its block.
+    */
+    [[nodiscard]] static std::uint32_t toSizeClass(std::size_t amount) noexcept
+    {
+        if (amount <= PoolAllocator::minBlockSize)
+            return 0;
+        // 2^k < amount <= 2^(k+1)
+        std::uint32_t const k = highestBit(amount - 1);
+        std::size_t const step = std::size_t(1) << (k - 2);
+        std::size_t const i = (amount - (std::size_t(1) << k) + step - 1) / step;
+        return (k - 8) * 4 + static_cast<std::uint32_t>(i);
+    }
+
+    [[nodiscard]] static std::size_t sizeClassSize(std::uint32_t sizeClass) noexcept
+    {
+        std::uint32_t const k = 8 + sizeClass / 4;
+        std::uint32_t const i = sizeClass % 4;
+        return (std::size_t(1) << k) + i * (std::size_t(1) << (k - 2));
+    }
+
+    [[nodiscard]] static std::uint32_t readSizeClass(std::byte const* block) noexcept
+    {
+        std::uint32_t sizeClass = 0;
+        std::memcpy(&sizeClass, block, sizeof(sizeClass));
+        return sizeClass;
+    }
+
+    static void writeSizeClass(std::byte* block, std::uint32_t sizeClass) noexcept
+    {
+        std::memcpy(block, &sizeClass, sizeof(sizeClass));
+    }
+}
+
+Texas::PoolAllocator::PoolAllocator(Allocator* upstream, std::size_t maxCachedBytes) noexcept :
+    m_upstream(upstream),
+    m_maxCachedBytes(maxCachedBytes)
+{
+}
+
+Texas::PoolAllocator::~PoolAllocator()
+{
+    trim();
+}
+
+std::byte* Texas::PoolAllocator::allocate(std::size_t amount, MemoryType memType)
+{
+    if (memType != MemoryType::ImageData)
+    {
+        m_forwardedAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        return allocateUpstream(amount, memType);
+    }
+
+    m_allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (amount > maxBlockSize)
+    {
+        m_forwardedAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        std::byte* const block = allocateUpstream(detail::poolHeaderSize + amount, memType);
+        if (block == nullptr)
+            return nullptr;
+        detail::writeSizeClass(block, detail::unpooledSizeClass);
+        return block + detail::poolHeaderSize;
+    }
+
+    std::uint32_t const sizeClass = detail::toSizeClass(amount);
+    std::size_t const blockSize = detail::sizeClassSize(sizeClass);
+
+    // Look in our own cache first, then in the others.
+    Cache& ownCache = threadCache();
+    std::size_t const ownCacheIndex = static_cast<std::size_t>(&ownCache - m_caches);
+    for (std::size_t i = 0; i < cacheCount; i++)
+    {
+        Cache& cache = m_caches[(ownCacheIndex + i) % cacheCount];
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        FreeBlock* const freeBlock = cache.freeLists[sizeClass];
+        if (freeBlock == nullptr)
+            continue;
+        cache.freeLists[sizeClass] = freeBlock->next;
+        cache.bytesCached -= blockSize;
+        m_bytesCached.fetch_sub(blockSize, std::memory_order_relaxed);
+        m_cacheHitCount.fetch_add(1, std::memory_order_relaxed);
+        addBytesInUse(blockSize);
+
+        std::byte* const block = reinterpret_cast<std::byte*>(freeBlock);
+        detail::writeSizeClass(block, sizeClass);
+        return block + detail::poolHeaderSize;
+    }
+
+    m_forwardedAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    std::byte* const block = allocateUpstream(detail::poolHeaderSize + blockSize, memType);
+    if (block == nullptr)
+        return nullptr;
+    addBytesInUse(blockSize);
+    detail::writeSizeClass(block, sizeClass);
+    return block + detail::poolHeaderSize;
+}
+
+void Texas::PoolAllocator::deallocate(std::byte* ptr, MemoryType memType)
+{
+    if (ptr == nullptr)
+        return;
+    if (memType != MemoryType::ImageData)
+    {
+        deallocateUpstream(ptr, memType);
+        return;
+    }
+
+    std::byte* const block = ptr - detail::poolHeaderSize;
+    std::uint32_t const sizeClass = detail::readSizeClass(block);
+    if (sizeClass == detail::unpooledSizeClass)
+    {
+        deallocateUpstream(block, memType);
+        return;
+    }
+
+    std::size_t const blockSize = detail::sizeClassSize(sizeClass);
+    m_bytesInUse.fetch_sub(blockSize, std::memory_order_relaxed);
+
+    Cache& cache = threadCache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        if (cache.bytesCached + blockSize <= m_maxCachedBytes)
+        {
+            // The block's own memory holds the free-list link.
+            FreeBlock* const freeBlock = new(block) FreeBlock{ cache.freeLists[sizeClass] };
+            cache.freeLists[sizeClass] = freeBlock;
+            cache.bytesCached += blockSize;
+            m_bytesCached.fetch_add(blockSize, std::memory_order_relaxed);
+            return;
+        }
+    }
+    deallocateUpstream(block, memType);
+}
+
+void Texas::PoolAllocator::trim() noexcept
+{
+    for (Cache& cache : m_caches)
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        for (std::uint32_t sizeClass = 0; sizeClass < sizeClassCount; sizeClass++)
+        {
+            FreeBlock* freeBlock = cache.freeLists[sizeClass];
+            while (freeBlock != nullptr)
+            {
+                FreeBlock* const next = freeBlock->next;
+                deallocateUpstream(reinterpret_cast<std::byte*>(freeBlock), MemoryType::ImageData);
+                freeBlock = next;
+            }
+            cache.freeLists[sizeClass] = nullptr;
+        }
+        m_bytesCached.fetch_sub(cache.bytesCached, std::memory_order_relaxed);
+        cache.bytesCached = 0;
+    }
+}
+
+Texas::PoolAllocator::Statistics Texas::PoolAllocator::statistics() const noexcept
+{
+    Statistics returnVal{};
+    returnVal.allocationCount = m_allocationCount.load(std::memory_order_relaxed);
+    returnVal.cacheHitCount = m_cacheHitCount.load(std::memory_order_relaxed);
+    returnVal.forwardedAllocationCount = m_forwardedAllocationCount.load(std::memory_order_relaxed);
+    returnVal.bytesInUse = m_bytesInUse.load(std::memory_order_relaxed);
+    returnVal.peakBytesInUse = m_peakBytesInUse.load(std::memory_order_relaxed);
+    returnVal.bytesCached = m_bytesCached.load(std::memory_order_relaxed);
+    return returnVal;
+}
+
+Texas::PoolAllocator::Cache& Texas::PoolAllocator::threadCache() noexcept
+{
+    // Threads are given cache indices in the order they first use any PoolAllocator.
+    static std::atomic<std::size_t> nextThreadIndex{ 0 };
+    thread_local std::size_t const threadIndex = nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+    return m_caches[threadIndex % cacheCount];
+}
+
+std::byte* Texas::PoolAllocator::allocateUpstream(std::size_t amount, MemoryType memType) noexcept
+{
+    if (m_upstream != nullptr)
+        return m_upstream->allocate(amount, memType);
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+    return new(std::nothrow) std::byte[amount];
+#else
+    return nullptr;
+#endif
+}
+
+void Texas::PoolAllocator::deallocateUpstream(std::byte* ptr, MemoryType memType) noexcept
+{
+    if (m_upstream != nullptr)
+    {
+        m_upstream->deallocate(ptr, memType);
+        return;
+    }
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+    delete[] ptr;
+#endif
+}
+
+void Texas::PoolAllocator::addBytesInUse(std::size_t amount) noexcept
+{
+    std::size_t const bytesInUse = m_bytesInUse.fetch_add(amount, std::memory_order_relaxed) + amount;
+    std::size_t peak = m_peakBytesInUse.load(std::memory_order_relaxed);
+    while (bytesInUse > peak && !m_peakBytesInUse.compare_exchange_weak(peak, bytesInUse, std::memory_order_relaxed))
+    {
+    }
+}
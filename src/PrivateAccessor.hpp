@@ -3,9 +3,15 @@
 #include "Texas/Result.hpp"
 #include "Texas/ResultValue.hpp"
 #include "Texas/InputStream.hpp"
+#include "Texas/MemoryInputStream.hpp"
 #include "Texas/FileInfo.hpp"
+#include "Texas/ImageDataLayout.hpp"
+#include "Texas/ImageDataRange.hpp"
 #include "Texas/Span.hpp"
 #include "Texas/Texture.hpp"
+#include "Texas/TextureView.hpp"
+#include "Texas/TextureLoader.hpp"
+#include "Texas/IncrementalDecoder.hpp"
 
 #include <cstdint>
 
@@ -16,15 +22,195 @@ namespace Texas::detail
     private:
         virtual ~PrivateAccessor() = 0;
 
+        /*
+            Implementations of the functions below that take a stream.
+            Only instantiated for InputStream and MemoryInputStream, 
+            which are the stream types the KTX and PNG loaders are compiled for.
+        */
+        template<typename StreamT>
+        [[nodiscard]] static ResultValue<Texture> loadFromStreamImpl(
+            StreamT& stream,
+            Allocator* allocator,
+            TextureLoader* loader) noexcept;
+        template<typename StreamT>
+        [[nodiscard]] static ResultValue<FileInfo> parseStreamImpl(
+            StreamT& stream,
+            bool stopAtImageData) noexcept;
+        template<typename StreamT>
+        [[nodiscard]] static Result loadImageDataImpl(
+            StreamT& stream,
+            FileInfo const& file,
+            ByteSpan dstBuffer,
+            ByteSpan workingMem,
+            InflateContext* inflateContext,
+            bool pipelined) noexcept;
+        template<typename StreamT>
+        [[nodiscard]] static Result loadImageDataImpl(
+            StreamT& stream,
+            FileInfo const& file,
+            ByteSpan dstBuffer,
+            ImageDataLayout const& dstLayout,
+            ByteSpan workingMem,
+            InflateContext* inflateContext,
+            bool pipelined) noexcept;
+        template<typename StreamT>
+        [[nodiscard]] static Result loadImageDataImpl(
+            StreamT& stream,
+            FileInfo const& file,
+            ImageDataRange const& range,
+            ByteSpan dstBuffer,
+            ByteSpan workingMem,
+            InflateContext* inflateContext,
+            bool pipelined) noexcept;
+        template<typename StreamT>
+        [[nodiscard]] static Result loadImageDataImpl(
+            StreamT& stream,
+            FileInfo const& file,
+            ImageDataRange const& range,
+            ByteSpan dstBuffer,
+            ImageDataLayout const& dstLayout,
+            ByteSpan workingMem,
+            InflateContext* inflateContext,
+            bool pipelined) noexcept;
+
     public:
-        [[nodiscard]] static ResultValue<Texture> loadFromStream(InputStream& stream, Allocator* allocator) noexcept;
-        [[nodiscard]] static ResultValue<FileInfo> parseStream(InputStream& stream) noexcept;
+        /*
+            If loader is not nullptr, working-memory and decompression state are taken from it
+            instead of being allocated, and allocator must be the loader's allocator.
+        */
+        [[nodiscard]] static ResultValue<Texture> loadFromStream(
+            InputStream& stream, 
+            Allocator* allocator,
+            TextureLoader* loader = nullptr) noexcept;
+        [[nodiscard]] static ResultValue<Texture> loadFromStream(
+            MemoryInputStream& stream,
+            Allocator* allocator,
+            TextureLoader* loader = nullptr) noexcept;
+        /*
+            Same as loadFromStream, but opens the file at path and reads it through a FileStream.
+        */
+        [[nodiscard]] static ResultValue<Texture> loadFromPath(
+            char const* path,
+            Allocator* allocator,
+            TextureLoader* loader = nullptr) noexcept;
+        [[nodiscard]] static ResultValue<TextureView> loadFromMemory(ConstByteSpan fileData) noexcept;
+        /*
+            If stopAtImageData is true, the file is only read up to where its image-data starts.
+        */
+        [[nodiscard]] static ResultValue<FileInfo> parseStream(
+            InputStream& stream, 
+            bool stopAtImageData = false) noexcept;
+        [[nodiscard]] static ResultValue<FileInfo> parseStream(
+            MemoryInputStream& stream,
+            bool stopAtImageData = false) noexcept;
 
+        /*
+            inflateContext can be nullptr, then a temporary one is used.
+            If pipelined is true, large PNG files are decoded on more than one thread when workingMem is large enough.
+        */
+        [[nodiscard]] static Result loadImageData(
+            InputStream& stream,
+            FileInfo const& file,
+            ByteSpan dstBuffer,
+            ByteSpan workingMem,
+            InflateContext* inflateContext = nullptr,
+            bool pipelined = false) noexcept;
+        [[nodiscard]] static Result loadImageData(
+            MemoryInputStream& stream,
+            FileInfo const& file,
+            ByteSpan dstBuffer,
+            ByteSpan workingMem,
+            InflateContext* inflateContext = nullptr,
+            bool pipelined = false) noexcept;
+        /*
+            Same as above, but places the image-data as described by dstLayout.
+        */
+        [[nodiscard]] static Result loadImageData(
+            InputStream& stream,
+            FileInfo const& file,
+            ByteSpan dstBuffer,
+            ImageDataLayout const& dstLayout,
+            ByteSpan workingMem,
+            InflateContext* inflateContext = nullptr,
+            bool pipelined = false) noexcept;
+        [[nodiscard]] static Result loadImageData(
+            MemoryInputStream& stream,
+            FileInfo const& file,
+            ByteSpan dstBuffer,
+            ImageDataLayout const& dstLayout,
+            ByteSpan workingMem,
+            InflateContext* inflateContext = nullptr,
+            bool pipelined = false) noexcept;
+        /*
+            Only loads the mip levels and array layers in range, tightly packed.
+        */
         [[nodiscard]] static Result loadImageData(
             InputStream& stream,
             FileInfo const& file,
+            ImageDataRange const& range,
+            ByteSpan dstBuffer,
+            ByteSpan workingMem,
+            InflateContext* inflateContext = nullptr,
+            bool pipelined = false) noexcept;
+        [[nodiscard]] static Result loadImageData(
+            MemoryInputStream& stream,
+            FileInfo const& file,
+            ImageDataRange const& range,
             ByteSpan dstBuffer,
-            ByteSpan workingMem) noexcept;
+            ByteSpan workingMem,
+            InflateContext* inflateContext = nullptr,
+            bool pipelined = false) noexcept;
+        /*
+            Only loads the mip levels and array layers in range, placed as described by dstLayout.
+        */
+        [[nodiscard]] static Result loadImageData(
+            InputStream& stream,
+            FileInfo const& file,
+            ImageDataRange const& range,
+            ByteSpan dstBuffer,
+            ImageDataLayout const& dstLayout,
+            ByteSpan workingMem,
+            InflateContext* inflateContext = nullptr,
+            bool pipelined = false) noexcept;
+        [[nodiscard]] static Result loadImageData(
+            MemoryInputStream& stream,
+            FileInfo const& file,
+            ImageDataRange const& range,
+            ByteSpan dstBuffer,
+            ImageDataLayout const& dstLayout,
+            ByteSpan workingMem,
+            InflateContext* inflateContext = nullptr,
+            bool pipelined = false) noexcept;
+
+        /*
+            Returns the loader's decompression state, and creates it if needed.
+            Returns nullptr if it could not be created.
+        */
+        [[nodiscard]] static InflateContext* getInflateContext(TextureLoader& loader) noexcept;
+
+        /*
+            Returns the amount of working memory needed to decode file on two threads.
+            Returns 0 if the file is not decoded that way.
+        */
+        [[nodiscard]] static std::uint64_t calcPipelinedWorkingMemRequired(FileInfo const& file) noexcept;
+
+        /*
+            Attempts to parse the bytes the decoder has been fed so far.
+            Not having been fed enough bytes yet is not an error.
+        */
+        [[nodiscard]] static Result parseIncremental(IncrementalDecoder& decoder) noexcept;
+        /*
+            Gets the file-format specific state of the decoder ready to decode into its destination buffer.
+        */
+        [[nodiscard]] static Result beginIncremental(IncrementalDecoder& decoder) noexcept;
+        /*
+            Decodes the next bytes fed to the decoder. Skips anything before the image-data.
+        */
+        [[nodiscard]] static Result decodeIncremental(IncrementalDecoder& decoder, ConstByteSpan data) noexcept;
+
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+        [[nodiscard]] static ResultValue<Texture> loadFromPathMapped(char const* path, Allocator* allocator) noexcept;
+#endif
 
 #if defined(TEXAS_ENABLE_KTX_SAVE)
         [[nodiscard]] static ResultValue<std::uint64_t> KTX_calcFileSize(TextureInfo const& texInfo) noexcept;
@@ -1,8 +1,3 @@
-// Stops the warnings made by MSVC when using "unsafe" CRT fopen functions.
-#ifdef _MSC_VER
-#   define _CRT_SECURE_NO_WARNINGS
-#endif
-
 #include <Texas/Texas.hpp>
 #include "PrivateAccessor.hpp"
 #include <Texas/Tools.hpp>
@@ -10,10 +5,11 @@
 
 #include "KTX.hpp"
 #include "PNG.hpp"
+#if defined(TEXAS_ENABLE_PNG_READ)
+#   include "Inflate.hpp"
+#endif
 
 #include <cstring>
-// For file IO
-#include <cstdio>
 
 #if !defined(TEXAS_ENABLE_KTX_READ) && !defined(TEXAS_ENABLE_PNG_READ)
 #error Cannot compile Texas without enabling atleast one file-format.
@@ -21,79 +17,22 @@
 
 namespace Texas::detail
 {
-    class FileIOStreamWrapper : public InputStream
-    {
-    public:
-        std::FILE* filestream = nullptr;
-        virtual ~FileIOStreamWrapper()
-        {
-            if (filestream != nullptr)
-            {
-                std::fclose(filestream);
-            }
-        }
-        virtual Result read(ByteSpan dst) noexcept override
-        {
-            std::size_t bytesRead = std::fread(dst.data(), 1, dst.size(), filestream);
-            if (bytesRead != dst.size())
-                return { ResultType::PrematureEndOfFile, "Reached premature end of filestream." };
-            return { ResultType::Success, nullptr };
-        }
-        virtual void ignore(std::size_t amount) noexcept override
-        {
-            int seekResult = std::fseek(filestream, static_cast<long>(amount), SEEK_CUR);
-            if (seekResult != 0)
-            {
-                // TODO: handle seek error
-            }
-        }
-        virtual std::size_t tell() noexcept override
-        {
-            long tellResult = std::ftell(filestream);
-            if (tellResult == -1)
-            {
-                // TODO: Error
-            }
-            return static_cast<std::size_t>(tellResult);
-        }
-        virtual void seek(std::size_t pos) noexcept override
-        {
-            int seekResult = std::fseek(filestream, static_cast<long>(pos), SEEK_SET);
-            if (seekResult != 0)
-            {
-                // TODO: handle seek error
-            }
-        }
-    };
+    // Size of the buffer loadFromPath reads files through. Same as a typical C stdio buffer.
+    constexpr std::size_t pathStreamBufferSize = 8192;
 
-    class BufferStreamWrapper : public InputStream
-    {
-    public:
-        ConstByteSpan inputBuffer{};
-        std::size_t offset = 0;
+    [[nodiscard]] static Result validateWorkingMemory(FileInfo const& file, ByteSpan workingMem) noexcept;
 
-        virtual Result read(ByteSpan dst) noexcept override
-        {
-            if (offset + dst.size() > inputBuffer.size())
-                return { ResultType::PrematureEndOfFile, 
-                         "Encountered premature end of file when loading." };
-            std::memcpy(dst.data(), inputBuffer.data() + offset, dst.size());
-            offset += dst.size();
-            return { ResultType::Success, nullptr };
-        }
-        virtual void ignore(std::size_t amount) noexcept override
-        {
-            offset += amount;
-        }
-        virtual std::size_t tell() noexcept override
-        {
-            return offset;
-        }
-        virtual void seek(std::size_t pos) noexcept override
-        {
-            offset = pos;
-        }
-    };
+    [[nodiscard]] static Result validateImageDataRange(TextureInfo const& textureInfo, ImageDataRange const& range) noexcept;
+
+    /*
+        Checks that every mip level, array layer, depth slice and row of range in dstLayout
+        fits inside a buffer of size dstBufferSize, and that no row overlaps the next.
+    */
+    [[nodiscard]] static Result validateImageDataLayout(
+        TextureInfo const& textureInfo,
+        ImageDataRange const& range,
+        ImageDataLayout const& dstLayout,
+        std::uint64_t dstBufferSize) noexcept;
 }
 
 Texas::ResultValue<Texas::Texture> Texas::loadFromStream(InputStream& stream, Allocator& allocator) noexcept
@@ -101,21 +40,48 @@ Texas::ResultValue<Texas::Texture> Texas::loadFromStream(InputStream& stream, Al
     return detail::PrivateAccessor::loadFromStream(stream, &allocator);
 }
 
+Texas::ResultValue<Texas::Texture> Texas::loadFromStream(MemoryInputStream& stream, Allocator& allocator) noexcept
+{
+    return detail::PrivateAccessor::loadFromStream(stream, &allocator);
+}
+
 Texas::ResultValue<Texas::Texture> Texas::loadFromPath(char const* path, Allocator& allocator) noexcept
 {
-    detail::FileIOStreamWrapper temp{};
+    return detail::PrivateAccessor::loadFromPath(path, &allocator);
+}
 
-    temp.filestream = std::fopen(path, "rb");
-    if (temp.filestream == nullptr)
-        return { ResultType::CouldNotOpenFile, "Failed to open this file for reading." };
-    return loadFromStream(temp, allocator);
+Texas::ResultValue<Texas::TextureView> Texas::loadFromMemory(ConstByteSpan fileData) noexcept
+{
+    return detail::PrivateAccessor::loadFromMemory(fileData);
 }
 
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+Texas::ResultValue<Texas::Texture> Texas::loadFromPathMapped(char const* path, Allocator& allocator) noexcept
+{
+    return detail::PrivateAccessor::loadFromPathMapped(path, &allocator);
+}
+#endif
+
 Texas::ResultValue<Texas::FileInfo> Texas::parseStream(InputStream& stream) noexcept
 {
     return detail::PrivateAccessor::parseStream(stream);
 }
 
+Texas::ResultValue<Texas::FileInfo> Texas::parseStream(MemoryInputStream& stream) noexcept
+{
+    return detail::PrivateAccessor::parseStream(stream);
+}
+
+Texas::ResultValue<Texas::FileInfo> Texas::probeStream(InputStream& stream) noexcept
+{
+    return detail::PrivateAccessor::parseStream(stream, true);
+}
+
+Texas::ResultValue<Texas::FileInfo> Texas::probeStream(MemoryInputStream& stream) noexcept
+{
+    return detail::PrivateAccessor::parseStream(stream, true);
+}
+
 Texas::Result Texas::loadImageData(
     InputStream& stream,
     FileInfo const& file,
@@ -125,36 +91,129 @@ Texas::Result Texas::loadImageData(
     return detail::PrivateAccessor::loadImageData(stream, file, dstBuffer, workingMemory);
 }
 
+Texas::Result Texas::loadImageData(
+    MemoryInputStream& stream,
+    FileInfo const& file,
+    ByteSpan dstBuffer,
+    ByteSpan workingMemory) noexcept
+{
+    return detail::PrivateAccessor::loadImageData(stream, file, dstBuffer, workingMemory);
+}
+
+Texas::Result Texas::loadImageData(
+    InputStream& stream,
+    FileInfo const& file,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout,
+    ByteSpan workingMemory) noexcept
+{
+    return detail::PrivateAccessor::loadImageData(stream, file, dstBuffer, dstLayout, workingMemory);
+}
+
+Texas::Result Texas::loadImageData(
+    InputStream& stream,
+    FileInfo const& file,
+    ImageDataRange const& range,
+    ByteSpan dstBuffer,
+    ByteSpan workingMemory) noexcept
+{
+    return detail::PrivateAccessor::loadImageData(stream, file, range, dstBuffer, workingMemory);
+}
+
+Texas::Result Texas::loadImageData(
+    InputStream& stream,
+    FileInfo const& file,
+    ImageDataRange const& range,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout,
+    ByteSpan workingMemory) noexcept
+{
+    return detail::PrivateAccessor::loadImageData(stream, file, range, dstBuffer, dstLayout, workingMemory);
+}
+
+Texas::Result Texas::loadImageData(
+    MemoryInputStream& stream,
+    FileInfo const& file,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout,
+    ByteSpan workingMemory) noexcept
+{
+    return detail::PrivateAccessor::loadImageData(stream, file, dstBuffer, dstLayout, workingMemory);
+}
+
+Texas::Result Texas::loadImageData(
+    MemoryInputStream& stream,
+    FileInfo const& file,
+    ImageDataRange const& range,
+    ByteSpan dstBuffer,
+    ByteSpan workingMemory) noexcept
+{
+    return detail::PrivateAccessor::loadImageData(stream, file, range, dstBuffer, workingMemory);
+}
+
+Texas::Result Texas::loadImageData(
+    MemoryInputStream& stream,
+    FileInfo const& file,
+    ImageDataRange const& range,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout,
+    ByteSpan workingMemory) noexcept
+{
+    return detail::PrivateAccessor::loadImageData(stream, file, range, dstBuffer, dstLayout, workingMemory);
+}
+
 #ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
 Texas::ResultValue<Texas::Texture> Texas::loadFromStream(InputStream& stream) noexcept
 {
     return detail::PrivateAccessor::loadFromStream(stream, nullptr);
 }
 
+Texas::ResultValue<Texas::Texture> Texas::loadFromStream(MemoryInputStream& stream) noexcept
+{
+    return detail::PrivateAccessor::loadFromStream(stream, nullptr);
+}
+
 Texas::ResultValue<Texas::Texture> Texas::loadFromPath(char const* path) noexcept
-{    
-    detail::FileIOStreamWrapper temp{};
-    temp.filestream = std::fopen(path, "rb");
-    if (temp.filestream == nullptr)
-        return { ResultType::CouldNotOpenFile, "Failed to open this file for reading." };
-    return loadFromStream(temp);
+{
+    return detail::PrivateAccessor::loadFromPath(path, nullptr);
 }
+
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+Texas::ResultValue<Texas::Texture> Texas::loadFromPathMapped(char const* path) noexcept
+{
+    return detail::PrivateAccessor::loadFromPathMapped(path, nullptr);
+}
+#endif
 #endif // End ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
 
-Texas::ResultValue<Texas::FileInfo> Texas::detail::PrivateAccessor::parseStream(InputStream& stream) noexcept
+Texas::ResultValue<Texas::FileInfo> Texas::detail::PrivateAccessor::parseStream(
+    InputStream& stream, 
+    bool stopAtImageData) noexcept
+{
+    return parseStreamImpl(stream, stopAtImageData);
+}
+
+Texas::ResultValue<Texas::FileInfo> Texas::detail::PrivateAccessor::parseStream(
+    MemoryInputStream& stream,
+    bool stopAtImageData) noexcept
+{
+    return parseStreamImpl(stream, stopAtImageData);
+}
+
+template<typename StreamT>
+Texas::ResultValue<Texas::FileInfo> Texas::detail::PrivateAccessor::parseStreamImpl(
+    StreamT& stream,
+    bool stopAtImageData) noexcept
 {
     Result result{};
 
     // Load the identifierBuffer. 12 bytes is the largest identifer
-    // that we know of so far. After that we go back to where
-    // we were in the stream because the loaders assume the stream 
-    // is at the start of the file.
+    // that we know of so far. Instead of going back in the stream,
+    // we hand the bytes over to the loaders, so that the stream never has to seek.
     std::byte identifierBuffer[12] = {};
-    std::size_t prevPos = stream.tell();
     result = stream.read({ identifierBuffer, 12 });
     if (!result.isSuccessful())
         return result;
-    stream.seek(prevPos);
 
     FileInfo memReqs{};
 
@@ -162,7 +221,11 @@ Texas::ResultValue<Texas::FileInfo> Texas::detail::PrivateAccessor::parseStream(
     if (std::memcmp(identifierBuffer, KTX::identifier, sizeof(KTX::identifier)) == 0)
     {
 #ifdef TEXAS_ENABLE_KTX_READ
-        Result result = KTX::loadFromStream(stream, memReqs.m_textureInfo);
+        Result result = KTX::loadFromStream(
+            stream, 
+            memReqs.m_textureInfo, 
+            memReqs.m_backendData.ktx,
+            { identifierBuffer, sizeof(identifierBuffer) });
         if (result.isSuccessful())
         {
             memReqs.m_memoryRequired = calculateTotalSize(memReqs.textureInfo());
@@ -186,7 +249,10 @@ Texas::ResultValue<Texas::FileInfo> Texas::detail::PrivateAccessor::parseStream(
             stream, 
             memReqs.m_textureInfo, 
             memReqs.m_workingMemoryRequired,
-            memReqs.m_backendData.png);
+            memReqs.m_minWorkingMemoryRequired,
+            memReqs.m_backendData.png,
+            { identifierBuffer, sizeof(identifierBuffer) },
+            stopAtImageData);
         if (result.isSuccessful())
         {
             memReqs.m_memoryRequired = calculateTotalSize(memReqs.textureInfo());
@@ -195,6 +261,7 @@ Texas::ResultValue<Texas::FileInfo> Texas::detail::PrivateAccessor::parseStream(
         else
             return { result };
 #else
+        (void)stopAtImageData;
         return { ResultType::FileNotSupported, "Encountered a PNG-file. "
                  "PNG support has not been enabled in this configuration." };
 #endif
@@ -209,7 +276,32 @@ Texas::Result Texas::detail::PrivateAccessor::loadImageData(
     InputStream& stream,
     FileInfo const& file, 
     ByteSpan dstBuffer, 
-    ByteSpan workingMem) noexcept
+    ByteSpan workingMem,
+    InflateContext* inflateContext,
+    bool pipelined) noexcept
+{
+    return loadImageDataImpl(stream, file, dstBuffer, workingMem, inflateContext, pipelined);
+}
+
+Texas::Result Texas::detail::PrivateAccessor::loadImageData(
+    MemoryInputStream& stream,
+    FileInfo const& file,
+    ByteSpan dstBuffer,
+    ByteSpan workingMem,
+    InflateContext* inflateContext,
+    bool pipelined) noexcept
+{
+    return loadImageDataImpl(stream, file, dstBuffer, workingMem, inflateContext, pipelined);
+}
+
+template<typename StreamT>
+Texas::Result Texas::detail::PrivateAccessor::loadImageDataImpl(
+    StreamT& stream,
+    FileInfo const& file,
+    ByteSpan dstBuffer,
+    ByteSpan workingMem,
+    InflateContext* inflateContext,
+    bool pipelined) noexcept
 {
     if (dstBuffer.data() == nullptr)
         return { ResultType::InvalidLibraryUsage, "You need to send in a destination buffer." };
@@ -217,15 +309,9 @@ Texas::Result Texas::detail::PrivateAccessor::loadImageData(
         return { ResultType::InvalidLibraryUsage, 
                  "Destination buffer is not equal to or higher than Texas::FileInfo::memoryRequired(). "
                  "Cannot fit image data in this buffer." };
-    if (file.workingMemoryRequired() > 0)
-    {
-        if (workingMem.data() == nullptr)
-            return { ResultType::InvalidLibraryUsage, 
-                     "Cannot pass nullptr for working-memory when loading image-data requires working-memory." };
-        else if (workingMem.size() < file.workingMemoryRequired())
-            return { ResultType::InvalidLibraryUsage, 
-                     "Working-memory passed in is not large enough to load the image-data." };
-    }
+    Result const workingMemResult = validateWorkingMemory(file, workingMem);
+    if (!workingMemResult.isSuccessful())
+        return workingMemResult;
 
 #ifdef TEXAS_ENABLE_KTX_READ
     if (file.textureInfo().fileFormat == FileFormat::KTX)
@@ -240,23 +326,236 @@ Texas::Result Texas::detail::PrivateAccessor::loadImageData(
 #ifdef TEXAS_ENABLE_PNG_READ
     if (file.textureInfo().fileFormat == FileFormat::PNG)
     {
+        InflateContext temporaryInflateContext{};
         return detail::PNG::loadFromStream(
             stream,
+            inflateContext != nullptr ? *inflateContext : temporaryInflateContext,
             file.textureInfo(),
             file.m_backendData.png,
             dstBuffer,
-            workingMem);
+            static_cast<std::size_t>(calculateRowSize(file.textureInfo().baseDimensions, file.textureInfo().pixelFormat)),
+            workingMem,
+            pipelined);
     }
+#else
+    // Only PNG files need to be decompressed.
+    (void)inflateContext;
+    (void)pipelined;
 #endif
     
     return { ResultType::InvalidLibraryUsage, "Passed in an invalid FileInfo object." };
 }
 
+Texas::Result Texas::detail::PrivateAccessor::loadImageData(
+    InputStream& stream,
+    FileInfo const& file,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout,
+    ByteSpan workingMem,
+    InflateContext* inflateContext,
+    bool pipelined) noexcept
+{
+    return loadImageDataImpl(stream, file, dstBuffer, dstLayout, workingMem, inflateContext, pipelined);
+}
+
+Texas::Result Texas::detail::PrivateAccessor::loadImageData(
+    MemoryInputStream& stream,
+    FileInfo const& file,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout,
+    ByteSpan workingMem,
+    InflateContext* inflateContext,
+    bool pipelined) noexcept
+{
+    return loadImageDataImpl(stream, file, dstBuffer, dstLayout, workingMem, inflateContext, pipelined);
+}
+
+Texas::Result Texas::detail::PrivateAccessor::loadImageData(
+    InputStream& stream,
+    FileInfo const& file,
+    ImageDataRange const& range,
+    ByteSpan dstBuffer,
+    ByteSpan workingMem,
+    InflateContext* inflateContext,
+    bool pipelined) noexcept
+{
+    return loadImageDataImpl(stream, file, range, dstBuffer, workingMem, inflateContext, pipelined);
+}
+
+Texas::Result Texas::detail::PrivateAccessor::loadImageData(
+    MemoryInputStream& stream,
+    FileInfo const& file,
+    ImageDataRange const& range,
+    ByteSpan dstBuffer,
+    ByteSpan workingMem,
+    InflateContext* inflateContext,
+    bool pipelined) noexcept
+{
+    return loadImageDataImpl(stream, file, range, dstBuffer, workingMem, inflateContext, pipelined);
+}
+
+Texas::Result Texas::detail::PrivateAccessor::loadImageData(
+    InputStream& stream,
+    FileInfo const& file,
+    ImageDataRange const& range,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout,
+    ByteSpan workingMem,
+    InflateContext* inflateContext,
+    bool pipelined) noexcept
+{
+    return loadImageDataImpl(stream, file, range, dstBuffer, dstLayout, workingMem, inflateContext, pipelined);
+}
+
+Texas::Result Texas::detail::PrivateAccessor::loadImageData(
+    MemoryInputStream& stream,
+    FileInfo const& file,
+    ImageDataRange const& range,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout,
+    ByteSpan workingMem,
+    InflateContext* inflateContext,
+    bool pipelined) noexcept
+{
+    return loadImageDataImpl(stream, file, range, dstBuffer, dstLayout, workingMem, inflateContext, pipelined);
+}
+
+template<typename StreamT>
+Texas::Result Texas::detail::PrivateAccessor::loadImageDataImpl(
+    StreamT& stream,
+    FileInfo const& file,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout,
+    ByteSpan workingMem,
+    InflateContext* inflateContext,
+    bool pipelined) noexcept
+{
+    ImageDataRange range{};
+    range.mipCount = file.textureInfo().mipCount;
+    range.layerCount = file.textureInfo().layerCount;
+    return loadImageDataImpl(stream, file, range, dstBuffer, dstLayout, workingMem, inflateContext, pipelined);
+}
+
+template<typename StreamT>
+Texas::Result Texas::detail::PrivateAccessor::loadImageDataImpl(
+    StreamT& stream,
+    FileInfo const& file,
+    ImageDataRange const& range,
+    ByteSpan dstBuffer,
+    ByteSpan workingMem,
+    InflateContext* inflateContext,
+    bool pipelined) noexcept
+{
+    Result const rangeResult = validateImageDataRange(file.textureInfo(), range);
+    if (!rangeResult.isSuccessful())
+        return rangeResult;
+    // Tightly packed, so the range is laid out just like a Texture holding only these mip levels and layers.
+    ImageDataLayout const dstLayout = calculateImageDataLayout(file.textureInfo(), range, 1, 1);
+    return loadImageDataImpl(stream, file, range, dstBuffer, dstLayout, workingMem, inflateContext, pipelined);
+}
+
+template<typename StreamT>
+Texas::Result Texas::detail::PrivateAccessor::loadImageDataImpl(
+    StreamT& stream,
+    FileInfo const& file,
+    ImageDataRange const& range,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout,
+    ByteSpan workingMem,
+    InflateContext* inflateContext,
+    bool pipelined) noexcept
+{
+    if (dstBuffer.data() == nullptr)
+        return { ResultType::InvalidLibraryUsage, "You need to send in a destination buffer." };
+    Result result = validateImageDataRange(file.textureInfo(), range);
+    if (!result.isSuccessful())
+        return result;
+    result = validateImageDataLayout(file.textureInfo(), range, dstLayout, dstBuffer.size());
+    if (!result.isSuccessful())
+        return result;
+    result = validateWorkingMemory(file, workingMem);
+    if (!result.isSuccessful())
+        return result;
+
+#ifdef TEXAS_ENABLE_KTX_READ
+    if (file.textureInfo().fileFormat == FileFormat::KTX)
+    {
+        return detail::KTX::loadImageData(
+            stream,
+            dstBuffer,
+            dstLayout,
+            range,
+            file.textureInfo(),
+            file.m_backendData.ktx);
+    }
+#endif
+#ifdef TEXAS_ENABLE_PNG_READ
+    if (file.textureInfo().fileFormat == FileFormat::PNG)
+    {
+        // PNG files only have a single image, so the range is always the first mip level.
+        MipLayout const& mipLayout = dstLayout.mips[0];
+        InflateContext temporaryInflateContext{};
+        return detail::PNG::loadFromStream(
+            stream,
+            inflateContext != nullptr ? *inflateContext : temporaryInflateContext,
+            file.textureInfo(),
+            file.m_backendData.png,
+            { dstBuffer.data() + mipLayout.offset, dstBuffer.size() - static_cast<std::size_t>(mipLayout.offset) },
+            static_cast<std::size_t>(mipLayout.rowPitch),
+            workingMem,
+            pipelined);
+    }
+#else
+    // Only PNG files need to be decompressed.
+    (void)inflateContext;
+    (void)pipelined;
+#endif
+
+    return { ResultType::InvalidLibraryUsage, "Passed in an invalid FileInfo object." };
+}
+
+Texas::ResultValue<Texas::Texture> Texas::detail::PrivateAccessor::loadFromPath(
+    char const* path,
+    Allocator* allocator,
+    TextureLoader* loader) noexcept
+{
+    FileHandle file{};
+    Result const result = file.open(path);
+    if (!result.isSuccessful())
+        return result;
+    FileStream fileStream(file);
+    // The file is read once, from front to back.
+    fileStream.hint(0, 0, InputStream::AccessHint::Sequential);
+    // Every read of a FileStream is a call to the OS, and parsing does lots of small reads.
+    std::byte streamBuffer[pathStreamBufferSize];
+    BufferedInputStream stream(fileStream, { streamBuffer, sizeof(streamBuffer) });
+    return loadFromStream(stream, allocator, loader);
+}
+
 Texas::ResultValue<Texas::Texture> Texas::detail::PrivateAccessor::loadFromStream(
     InputStream& stream, 
-    Allocator* allocator) noexcept
+    Allocator* allocator,
+    TextureLoader* loader) noexcept
+{
+    return loadFromStreamImpl(stream, allocator, loader);
+}
+
+Texas::ResultValue<Texas::Texture> Texas::detail::PrivateAccessor::loadFromStream(
+    MemoryInputStream& stream,
+    Allocator* allocator,
+    TextureLoader* loader) noexcept
+{
+    return loadFromStreamImpl(stream, allocator, loader);
+}
+
+template<typename StreamT>
+Texas::ResultValue<Texas::Texture> Texas::detail::PrivateAccessor::loadFromStreamImpl(
+    StreamT& stream,
+    Allocator* allocator,
+    TextureLoader* loader) noexcept
 {
-    ResultValue<FileInfo> parseFileResult = parseStream(stream);
+    // We load the image-data right away, so there's no need to read past its start.
+    ResultValue<FileInfo> parseFileResult = parseStream(stream, true);
     if (!parseFileResult.isSuccessful())
         return { parseFileResult.resultType(), parseFileResult.errorMessage() };
 
@@ -296,16 +595,31 @@ Texas::ResultValue<Texas::Texture> Texas::detail::PrivateAccessor::loadFromStrea
 #endif
     }
 
-    // Allocate working memory if needed
+    // Allocate working memory if needed.
+    // We only ask for the minimum, so PNG files get decoded row by row
+    // instead of holding the entire filtered image in memory.
     std::byte* workingMem = nullptr;
-    std::uint64_t workingMemSize = fileInfo.workingMemoryRequired();
+    std::uint64_t workingMemSize = fileInfo.minWorkingMemoryRequired();
     if constexpr (detail::maxValue<std::uint64_t>() > detail::maxValue<std::size_t>())
     {
         if (workingMemSize > detail::maxValue<std::size_t>())
             return { ResultType::FileNotSupported, 
                      "Texture requires more working memory than the system can possibly allocate." };
     }
-    if (workingMemSize > 0)
+    InflateContext* inflateContext = nullptr;
+    bool pipelined = false;
+    if (loader != nullptr)
+    {
+        // The loader's pool is never handed back, so we can use all of it.
+        Result const reserveResult = loader->reserveWorkingMemory(fileInfo);
+        if (!reserveResult.isSuccessful())
+            return reserveResult;
+        workingMem = loader->m_workingMem.data();
+        workingMemSize = loader->m_workingMem.size();
+        inflateContext = getInflateContext(*loader);
+        pipelined = loader->m_pipelinedDecoding;
+    }
+    else if (workingMemSize > 0)
     {
         if (allocator != nullptr)
         {
@@ -327,9 +641,11 @@ Texas::ResultValue<Texas::Texture> Texas::detail::PrivateAccessor::loadFromStrea
             stream,
             fileInfo,
             returnVal.m_buffer,
-            { workingMem, static_cast<std::size_t>(workingMemSize) });
+            { workingMem, static_cast<std::size_t>(workingMemSize) },
+            inflateContext,
+            pipelined);
     // Deallocate the working-memory
-    if (workingMem != nullptr)
+    if (workingMem != nullptr && loader == nullptr)
     {
         if (allocator != nullptr)
             allocator->deallocate(workingMem, Allocator::MemoryType::WorkingData);
@@ -347,3 +663,150 @@ Texas::ResultValue<Texas::Texture> Texas::detail::PrivateAccessor::loadFromStrea
 
     return returnVal;
 }
+
+Texas::ResultValue<Texas::TextureView> Texas::detail::PrivateAccessor::loadFromMemory(ConstByteSpan fileData) noexcept
+{
+    MemoryInputStream stream(fileData);
+    // Nothing past the start of the image-data is read through the stream.
+    ResultValue<FileInfo> parseFileResult = parseStream(stream, true);
+    if (!parseFileResult.isSuccessful())
+        return { parseFileResult.resultType(), parseFileResult.errorMessage() };
+
+#ifdef TEXAS_ENABLE_KTX_READ
+    FileInfo const& fileInfo = parseFileResult.value();
+    if (fileInfo.textureInfo().fileFormat == FileFormat::KTX)
+    {
+        ResultValue<ConstByteSpan> imageDataResult = KTX::getImageDataInPlace(
+            fileData,
+            fileInfo.m_backendData.ktx.imageDataStreamPos,
+            fileInfo.textureInfo());
+        if (!imageDataResult.isSuccessful())
+            return { imageDataResult.resultType(), imageDataResult.errorMessage() };
+
+        TextureView returnVal{};
+        returnVal.m_textureInfo = fileInfo.textureInfo();
+        returnVal.m_imageData = imageDataResult.value();
+        return returnVal;
+    }
+#endif
+
+    return { ResultType::FileNotSupported,
+             "The image-data of this file-format has to be decoded, so it can not be used in-place. "
+             "Use Texas::loadFromStream with a Texas::MemoryInputStream instead." };
+}
+
+std::uint64_t Texas::detail::PrivateAccessor::calcPipelinedWorkingMemRequired(FileInfo const& file) noexcept
+{
+#ifdef TEXAS_ENABLE_PNG_READ
+    if (file.textureInfo().fileFormat == FileFormat::PNG)
+        return PNG::calcWorkingMemRequired_Pipelined(file.textureInfo(), file.m_backendData.png);
+#else
+    (void)file;
+#endif
+    return 0;
+}
+
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+Texas::ResultValue<Texas::Texture> Texas::detail::PrivateAccessor::loadFromPathMapped(
+    char const* path,
+    Allocator* allocator) noexcept
+{
+    MappedFileStream stream{};
+    Result result = stream.open(path);
+    if (!result.isSuccessful())
+        return result;
+
+    // We load the image-data right away, so there's no need to read past its start.
+    ResultValue<FileInfo> parseFileResult = parseStream(stream, true);
+    if (!parseFileResult.isSuccessful())
+        return { parseFileResult.resultType(), parseFileResult.errorMessage() };
+
+#ifdef TEXAS_ENABLE_KTX_READ
+    FileInfo const& fileInfo = parseFileResult.value();
+    if (fileInfo.textureInfo().fileFormat == FileFormat::KTX)
+    {
+        // KTX stores the image-data as-is. If every mip level is where we expect it,
+        // we hand the mapping over to the Texture instead of copying out of it.
+        ResultValue<ConstByteSpan> imageDataResult = KTX::getImageDataInPlace(
+            stream.data(),
+            fileInfo.m_backendData.ktx.imageDataStreamPos,
+            fileInfo.textureInfo());
+        if (imageDataResult.isSuccessful())
+        {
+            Texture returnVal{};
+            returnVal.m_textureInfo = fileInfo.textureInfo();
+            returnVal.m_mapping = stream.m_mapping;
+            returnVal.m_mappedBuffer = imageDataResult.value();
+            // The Texture owns the mapping now.
+            stream.m_mapping = MemoryMapping{};
+            return returnVal;
+        }
+    }
+#endif
+
+    // The image-data has to be decoded or moved around,
+    // so we load it like any other stream and let the mapping go afterwards.
+    stream.seek(0);
+    return loadFromStream(stream, allocator);
+}
+#endif
+
+static Texas::Result Texas::detail::validateWorkingMemory(FileInfo const& file, ByteSpan workingMem) noexcept
+{
+    if (file.minWorkingMemoryRequired() > 0)
+    {
+        if (workingMem.data() == nullptr)
+            return { ResultType::InvalidLibraryUsage, 
+                     "Cannot pass nullptr for working-memory when loading image-data requires working-memory." };
+        else if (workingMem.size() < file.minWorkingMemoryRequired())
+            return { ResultType::InvalidLibraryUsage, 
+                     "Working-memory passed in is not large enough to load the image-data." };
+    }
+    return { ResultType::Success, nullptr };
+}
+
+static Texas::Result Texas::detail::validateImageDataRange(TextureInfo const& textureInfo, ImageDataRange const& range) noexcept
+{
+    if (range.mipCount == 0 || range.layerCount == 0)
+        return { ResultType::InvalidLibraryUsage, "Texas::ImageDataRange must hold atleast one mip level and one array layer." };
+    if (std::uint32_t(range.baseMip) + range.mipCount > textureInfo.mipCount)
+        return { ResultType::InvalidLibraryUsage, "Texas::ImageDataRange reaches past the last mip level of the texture." };
+    if (range.baseLayer >= textureInfo.layerCount || range.layerCount > textureInfo.layerCount - range.baseLayer)
+        return { ResultType::InvalidLibraryUsage, "Texas::ImageDataRange reaches past the last array layer of the texture." };
+    return { ResultType::Success, nullptr };
+}
+
+static Texas::Result Texas::detail::validateImageDataLayout(
+    TextureInfo const& textureInfo,
+    ImageDataRange const& range,
+    ImageDataLayout const& dstLayout,
+    std::uint64_t dstBufferSize) noexcept
+{
+    if (textureInfo.mipCount > ImageDataLayout::maxMipCount)
+        return { ResultType::FileNotSupported, "Texture has more mip levels than Texas::ImageDataLayout can describe." };
+
+    for (std::uint8_t mipIndex = range.baseMip; mipIndex < range.baseMip + range.mipCount; mipIndex++)
+    {
+        MipLayout const& mipLayout = dstLayout.mips[mipIndex];
+        Dimensions const mipDims = calculateMipDimensions(textureInfo.baseDimensions, mipIndex);
+        std::uint64_t const rowSize = calculateRowSize(mipDims, textureInfo.pixelFormat);
+        std::uint64_t const rowCount = calculateRowCount(mipDims, textureInfo.pixelFormat);
+
+        // The amount of bytes from the start of a slice, layer or mip level to the end of its last row.
+        std::uint64_t const sliceExtent = mipLayout.rowPitch * (rowCount - 1) + rowSize;
+        std::uint64_t const layerExtent = mipLayout.slicePitch * (mipDims.depth - 1) + sliceExtent;
+        std::uint64_t const mipExtent = mipLayout.layerPitch * (range.layerCount - 1) + layerExtent;
+
+        if (mipLayout.rowPitch < rowSize)
+            return { ResultType::InvalidLibraryUsage, "Row-pitch in Texas::ImageDataLayout is smaller than a row of the mip level." };
+        if (mipDims.depth > 1 && mipLayout.slicePitch < sliceExtent)
+            return { ResultType::InvalidLibraryUsage, "Slice-pitch in Texas::ImageDataLayout is smaller than a depth slice of the mip level." };
+        if (range.layerCount > 1 && mipLayout.layerPitch < layerExtent)
+            return { ResultType::InvalidLibraryUsage, "Layer-pitch in Texas::ImageDataLayout is smaller than an array layer of the mip level." };
+        if (mipLayout.offset > dstBufferSize || mipExtent > dstBufferSize - mipLayout.offset)
+            return { ResultType::InvalidLibraryUsage, 
+                     "Destination buffer is too small to hold the image-data in the layout described by Texas::ImageDataLayout." };
+    }
+
+    return { ResultType::Success, nullptr };
+}
@@ -1,6 +1,11 @@
 #include "Texas/Texture.hpp"
 #include "Texas/Tools.hpp"
 
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+#   include "MemoryMapping.hpp"
+#   include "KTX.hpp"
+#endif
+
 Texas::Texture::Texture(Texture&& in) noexcept
 {
     m_textureInfo = in.m_textureInfo;
@@ -10,11 +15,18 @@ Texas::Texture::Texture(Texture&& in) noexcept
     in.m_textureInfo = TextureInfo{};
     in.m_allocator = nullptr;
     in.m_buffer = ByteSpan{};
+
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+    m_mapping = in.m_mapping;
+    m_mappedBuffer = in.m_mappedBuffer;
+    in.m_mapping = detail::MemoryMapping{};
+    in.m_mappedBuffer = ConstByteSpan{};
+#endif
 }
 
 Texas::Texture::~Texture()
 {
-    if (m_buffer.data() != nullptr)
+    if (m_buffer.data() != nullptr || isMapped())
         deallocateInternalBuffer();
 }
 
@@ -22,7 +34,7 @@ Texas::Texture& Texas::Texture::operator=(Texture&& other) noexcept
 {
     if (this == &other)
         return *this;
-    if (m_buffer.data() != nullptr)
+    if (m_buffer.data() != nullptr || isMapped())
         deallocateInternalBuffer();
 
     m_textureInfo = other.m_textureInfo;
@@ -33,6 +45,13 @@ Texas::Texture& Texas::Texture::operator=(Texture&& other) noexcept
     other.m_allocator = nullptr;
     other.m_buffer = ByteSpan(nullptr, 0);
 
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+    m_mapping = other.m_mapping;
+    m_mappedBuffer = other.m_mappedBuffer;
+    other.m_mapping = detail::MemoryMapping{};
+    other.m_mappedBuffer = ConstByteSpan{};
+#endif
+
     return *this;
 }
 
@@ -83,6 +102,11 @@ std::uint64_t Texas::Texture::layerCount() const
 
 std::uint64_t Texas::Texture::mipOffset(std::uint8_t mipIndex) const
 {
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+    // Mapped imagedata is laid out like the KTX file it points into.
+    if (isMapped())
+        return detail::KTX::calcMipPayloadOffset(m_textureInfo, mipIndex);
+#endif
     return Texas::calculateMipOffset(m_textureInfo, mipIndex);
 }
 
@@ -93,7 +117,7 @@ std::uint64_t Texas::Texture::mipSize(std::uint8_t mipIndex) const
 
 std::byte const* Texas::Texture::mipData(std::uint8_t mipIndex) const
 {
-    return m_buffer.data() + mipOffset(mipIndex);;
+    return rawBufferData() + mipOffset(mipIndex);
 }
 
 Texas::ConstByteSpan Texas::Texture::mipSpan(std::uint8_t mipIndex) const
@@ -103,6 +127,8 @@ Texas::ConstByteSpan Texas::Texture::mipSpan(std::uint8_t mipIndex) const
 
 std::uint64_t Texas::Texture::layerOffset(std::uint8_t mipIndex, std::uint64_t layerIndex) const
 {
+    if (isMapped())
+        return mipOffset(mipIndex) + layerSize(mipIndex) * layerIndex;
     return Texas::calculateLayerOffset(m_textureInfo, mipIndex, layerIndex);
 }
 
@@ -117,7 +143,7 @@ std::uint64_t Texas::Texture::layerSize(std::uint8_t mipIndex) const
 
 std::byte const* Texas::Texture::layerData(std::uint8_t mipIndex, std::uint64_t layerIndex) const
 {
-    return m_buffer.data() + layerOffset(mipIndex, layerIndex);
+    return rawBufferData() + layerOffset(mipIndex, layerIndex);
 }
 
 Texas::ConstByteSpan Texas::Texture::layerSpan(std::uint8_t mipIndex, std::uint64_t layerIndex) const
@@ -128,6 +154,10 @@ Texas::ConstByteSpan Texas::Texture::layerSpan(std::uint8_t mipIndex, std::uint6
 
 std::byte const* Texas::Texture::rawBufferData() const
 {
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+    if (isMapped())
+        return m_mappedBuffer.data();
+#endif
     return m_buffer.data();
 }
 
@@ -138,17 +168,38 @@ std::uint64_t Texas::Texture::totalDataSize() const
 
 Texas::ConstByteSpan Texas::Texture::rawBufferSpan() const
 {
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+    if (isMapped())
+        return m_mappedBuffer;
+#endif
     return m_buffer;
 }
 
+bool Texas::Texture::isMapped() const
+{
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+    return m_mapping.data != nullptr;
+#else
+    return false;
+#endif
+}
+
 void Texas::Texture::deallocateInternalBuffer()
 {
-    if (m_allocator != nullptr)
+    if (isMapped())
+    {
+#if defined(TEXAS_ENABLE_MEMORY_MAPPING)
+        detail::unmapFile(m_mapping);
+        m_mapping = detail::MemoryMapping{};
+        m_mappedBuffer = ConstByteSpan{};
+#endif
+    }
+    else if (m_allocator != nullptr)
         m_allocator->deallocate(m_buffer.data(), Allocator::MemoryType::ImageData);
     else
     {
 #ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
-        delete m_buffer.data();
+        delete[] m_buffer.data();
         m_buffer = {};
 #else
         // We should never hit this path!
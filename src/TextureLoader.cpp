@@ -0,0 +1,252 @@
+#include "Texas/TextureLoader.hpp"
+
+#include "PrivateAccessor.hpp"
+
+#if defined(TEXAS_ENABLE_PNG_READ)
+#   include "Inflate.hpp"
+#endif
+
+#include <new>
+
+Texas::TextureLoader::TextureLoader(Allocator& allocator) noexcept :
+    m_allocator(&allocator)
+{
+}
+
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+Texas::TextureLoader::TextureLoader() noexcept = default;
+#endif
+
+Texas::TextureLoader::TextureLoader(TextureLoader&& other) noexcept :
+    m_allocator(other.m_allocator),
+    m_workingMem(other.m_workingMem),
+    m_inflateContext(other.m_inflateContext),
+    m_pipelinedDecoding(other.m_pipelinedDecoding)
+{
+    other.m_workingMem = {};
+    other.m_inflateContext = nullptr;
+}
+
+Texas::TextureLoader& Texas::TextureLoader::operator=(TextureLoader&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    releaseMemory();
+    m_allocator = other.m_allocator;
+    m_workingMem = other.m_workingMem;
+    m_inflateContext = other.m_inflateContext;
+    m_pipelinedDecoding = other.m_pipelinedDecoding;
+    other.m_workingMem = {};
+    other.m_inflateContext = nullptr;
+
+    return *this;
+}
+
+Texas::TextureLoader::~TextureLoader()
+{
+    releaseMemory();
+}
+
+Texas::ResultValue<Texas::Texture> Texas::TextureLoader::loadFromStream(InputStream& stream) noexcept
+{
+    return detail::PrivateAccessor::loadFromStream(stream, m_allocator, this);
+}
+
+Texas::ResultValue<Texas::Texture> Texas::TextureLoader::loadFromStream(MemoryInputStream& stream) noexcept
+{
+    return detail::PrivateAccessor::loadFromStream(stream, m_allocator, this);
+}
+
+Texas::ResultValue<Texas::Texture> Texas::TextureLoader::loadFromPath(char const* path) noexcept
+{
+    return detail::PrivateAccessor::loadFromPath(path, m_allocator, this);
+}
+
+Texas::Result Texas::TextureLoader::loadImageData(
+    InputStream& stream,
+    FileInfo const& file,
+    ByteSpan dstBuffer) noexcept
+{
+    Result result = reserveWorkingMemory(file);
+    if (!result.isSuccessful())
+        return result;
+
+    return detail::PrivateAccessor::loadImageData(
+        stream,
+        file,
+        dstBuffer,
+        m_workingMem,
+        detail::PrivateAccessor::getInflateContext(*this),
+        m_pipelinedDecoding);
+}
+
+Texas::Result Texas::TextureLoader::loadImageData(
+    InputStream& stream,
+    FileInfo const& file,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout) noexcept
+{
+    Result result = reserveWorkingMemory(file);
+    if (!result.isSuccessful())
+        return result;
+
+    return detail::PrivateAccessor::loadImageData(
+        stream,
+        file,
+        dstBuffer,
+        dstLayout,
+        m_workingMem,
+        detail::PrivateAccessor::getInflateContext(*this),
+        m_pipelinedDecoding);
+}
+
+Texas::Result Texas::TextureLoader::loadImageData(
+    InputStream& stream,
+    FileInfo const& file,
+    ImageDataRange const& range,
+    ByteSpan dstBuffer) noexcept
+{
+    Result result = reserveWorkingMemory(file);
+    if (!result.isSuccessful())
+        return result;
+
+    return detail::PrivateAccessor::loadImageData(
+        stream,
+        file,
+        range,
+        dstBuffer,
+        m_workingMem,
+        detail::PrivateAccessor::getInflateContext(*this),
+        m_pipelinedDecoding);
+}
+
+Texas::Result Texas::TextureLoader::loadImageData(
+    InputStream& stream,
+    FileInfo const& file,
+    ImageDataRange const& range,
+    ByteSpan dstBuffer,
+    ImageDataLayout const& dstLayout) noexcept
+{
+    Result result = reserveWorkingMemory(file);
+    if (!result.isSuccessful())
+        return result;
+
+    return detail::PrivateAccessor::loadImageData(
+        stream,
+        file,
+        range,
+        dstBuffer,
+        dstLayout,
+        m_workingMem,
+        detail::PrivateAccessor::getInflateContext(*this),
+        m_pipelinedDecoding);
+}
+
+#if defined(TEXAS_ENABLE_PNG_PIPELINING)
+void Texas::TextureLoader::setPipelinedDecoding(bool enabled) noexcept
+{
+    m_pipelinedDecoding = enabled;
+}
+#endif
+
+std::size_t Texas::TextureLoader::workingMemoryCapacity() const noexcept
+{
+    return m_workingMem.size();
+}
+
+void Texas::TextureLoader::releaseMemory() noexcept
+{
+    if (m_workingMem.data() != nullptr)
+        deallocateWorkingMemory(m_workingMem.data());
+    m_workingMem = {};
+
+#if defined(TEXAS_ENABLE_PNG_READ)
+    if (m_inflateContext != nullptr)
+    {
+        m_inflateContext->~InflateContext();
+        deallocateWorkingMemory(reinterpret_cast<std::byte*>(m_inflateContext));
+        m_inflateContext = nullptr;
+    }
+#endif
+}
+
+Texas::Result Texas::TextureLoader::reserveWorkingMemory(FileInfo const& file) noexcept
+{
+    std::uint64_t workingMemSize = file.minWorkingMemoryRequired();
+    if (m_pipelinedDecoding)
+    {
+        std::uint64_t const pipelinedWorkingMemSize = detail::PrivateAccessor::calcPipelinedWorkingMemRequired(file);
+        if (pipelinedWorkingMemSize > workingMemSize)
+            workingMemSize = pipelinedWorkingMemSize;
+    }
+    if constexpr (sizeof(std::uint64_t) > sizeof(std::size_t))
+    {
+        if (workingMemSize > static_cast<std::size_t>(-1))
+            return { ResultType::FileNotSupported, 
+                     "Texture requires more working memory than the system can possibly allocate." };
+    }
+    return reserveWorkingMemory(static_cast<std::size_t>(workingMemSize));
+}
+
+Texas::Result Texas::TextureLoader::reserveWorkingMemory(std::size_t size) noexcept
+{
+    if (size <= m_workingMem.size())
+        return { ResultType::Success, nullptr };
+
+    // Grow geometrically so a series of slightly larger files doesn't reallocate every time.
+    std::size_t newSize = m_workingMem.size() * 2;
+    if (newSize < size)
+        newSize = size;
+
+    if (m_workingMem.data() != nullptr)
+        deallocateWorkingMemory(m_workingMem.data());
+    m_workingMem = {};
+
+    std::byte* const mem = allocateWorkingMemory(newSize);
+    if (mem == nullptr)
+        return { ResultType::InvalidLibraryUsage, "Allocator returned nullptr when attempting to allocate working-memory." };
+    m_workingMem = { mem, newSize };
+    return { ResultType::Success, nullptr };
+}
+
+std::byte* Texas::TextureLoader::allocateWorkingMemory(std::size_t size) noexcept
+{
+    if (m_allocator != nullptr)
+        return m_allocator->allocate(size, Allocator::MemoryType::WorkingData);
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+    return new(std::nothrow) std::byte[size];
+#else
+    // This path should never be reached!
+    return nullptr;
+#endif
+}
+
+void Texas::TextureLoader::deallocateWorkingMemory(std::byte* ptr) noexcept
+{
+    if (m_allocator != nullptr)
+    {
+        m_allocator->deallocate(ptr, Allocator::MemoryType::WorkingData);
+        return;
+    }
+#ifdef TEXAS_ENABLE_DYNAMIC_ALLOCATIONS
+    delete[] ptr;
+#endif
+}
+
+Texas::detail::InflateContext* Texas::detail::PrivateAccessor::getInflateContext(TextureLoader& loader) noexcept
+{
+#if defined(TEXAS_ENABLE_PNG_READ)
+    if (loader.m_inflateContext == nullptr)
+    {
+        std::byte* const mem = loader.allocateWorkingMemory(sizeof(InflateContext));
+        if (mem == nullptr)
+            return nullptr;
+        loader.m_inflateContext = new(mem) InflateContext(loader.m_allocator);
+    }
+    return loader.m_inflateContext;
+#else
+    (void)loader;
+    return nullptr;
+#endif
+}
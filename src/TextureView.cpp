@@ -0,0 +1,85 @@
+#include "Texas/TextureView.hpp"
+#include "Texas/Tools.hpp"
+
+#include "KTX.hpp"
+
+Texas::TextureInfo const& Texas::TextureView::textureInfo() const
+{
+    return m_textureInfo;
+}
+
+Texas::FileFormat Texas::TextureView::fileFormat() const
+{
+    return m_textureInfo.fileFormat;
+}
+
+Texas::TextureType Texas::TextureView::textureType() const
+{
+    return m_textureInfo.textureType;
+}
+
+Texas::PixelFormat Texas::TextureView::pixelFormat() const
+{
+    return m_textureInfo.pixelFormat;
+}
+
+Texas::ChannelType Texas::TextureView::channelType() const
+{
+    return m_textureInfo.channelType;
+}
+
+Texas::ColorSpace Texas::TextureView::colorSpace() const
+{
+    return m_textureInfo.colorSpace;
+}
+
+Texas::Dimensions Texas::TextureView::baseDimensions() const
+{
+    return m_textureInfo.baseDimensions;
+}
+
+std::uint8_t Texas::TextureView::mipCount() const
+{
+    return m_textureInfo.mipCount;
+}
+
+std::uint64_t Texas::TextureView::layerCount() const
+{
+    return m_textureInfo.layerCount;
+}
+
+std::uint64_t Texas::TextureView::mipOffset(std::uint8_t mipIndex) const
+{
+    return detail::KTX::calcMipPayloadOffset(m_textureInfo, mipIndex);
+}
+
+Texas::ConstByteSpan Texas::TextureView::mipSpan(std::uint8_t mipIndex) const
+{
+    return { m_imageData.data() + mipOffset(mipIndex),
+             static_cast<std::size_t>(layerSize(mipIndex) * m_textureInfo.layerCount) };
+}
+
+std::uint64_t Texas::TextureView::layerOffset(std::uint8_t mipIndex, std::uint64_t layerIndex) const
+{
+    return mipOffset(mipIndex) + layerSize(mipIndex) * layerIndex;
+}
+
+Texas::ConstByteSpan Texas::TextureView::layerSpan(std::uint8_t mipIndex, std::uint64_t layerIndex) const
+{
+    return { m_imageData.data() + layerOffset(mipIndex, layerIndex),
+             static_cast<std::size_t>(layerSize(mipIndex)) };
+}
+
+Texas::ConstByteSpan Texas::TextureView::rawBufferSpan() const
+{
+    return m_imageData;
+}
+
+std::uint64_t Texas::TextureView::layerSize(std::uint8_t mipIndex) const
+{
+    return Texas::calculateSingleImageSize(
+        Texas::calculateMipDimensions(
+            m_textureInfo.baseDimensions,
+            mipIndex),
+        m_textureInfo.pixelFormat);
+}
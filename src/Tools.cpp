@@ -159,4 +159,85 @@ std::uint64_t Texas::calculateSingleImageSize(Dimensions dims, PixelFormat pForm
     }
 
     return dims.width * dims.height * dims.depth * detail::getPixelWidth_UncompressedOnly(pFormat);
-}
\ No newline at end of file
+}
+
+namespace Texas::detail
+{
+    // Rounds value up to the nearest multiple of alignment. An alignment of 0 is treated as 1.
+    [[nodiscard]] static inline std::uint64_t alignUp(std::uint64_t value, std::uint64_t alignment) noexcept
+    {
+        if (alignment <= 1)
+            return value;
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+std::uint64_t Texas::calculateRowSize(Dimensions dims, PixelFormat pFormat) noexcept
+{
+    if (isBCnCompressed(pFormat) || isASTCCompressed(pFormat))
+    {
+        detail::BlockInfo const blockInfo = detail::getBlockInfo(pFormat);
+        std::uint64_t blockCountX = (dims.width + blockInfo.width - 1) / blockInfo.width;
+        if (blockCountX == 0)
+            blockCountX = 1;
+        return blockCountX * blockInfo.size;
+    }
+
+    return dims.width * detail::getPixelWidth_UncompressedOnly(pFormat);
+}
+
+std::uint64_t Texas::calculateRowCount(Dimensions dims, PixelFormat pFormat) noexcept
+{
+    if (isBCnCompressed(pFormat) || isASTCCompressed(pFormat))
+    {
+        detail::BlockInfo const blockInfo = detail::getBlockInfo(pFormat);
+        std::uint64_t blockCountY = (dims.height + blockInfo.height - 1) / blockInfo.height;
+        if (blockCountY == 0)
+            blockCountY = 1;
+        return blockCountY;
+    }
+
+    return dims.height;
+}
+
+Texas::ImageDataLayout Texas::calculateImageDataLayout(
+    TextureInfo const& textureInfo,
+    std::uint64_t offsetAlignment,
+    std::uint64_t rowPitchAlignment) noexcept
+{
+    ImageDataRange range{};
+    range.mipCount = textureInfo.mipCount;
+    range.layerCount = textureInfo.layerCount;
+    return calculateImageDataLayout(textureInfo, range, offsetAlignment, rowPitchAlignment);
+}
+
+Texas::ImageDataLayout Texas::calculateImageDataLayout(
+    TextureInfo const& textureInfo,
+    ImageDataRange const& range,
+    std::uint64_t offsetAlignment,
+    std::uint64_t rowPitchAlignment) noexcept
+{
+    ImageDataLayout returnVal{};
+
+    std::uint32_t endMip = std::uint32_t(range.baseMip) + range.mipCount;
+    if (endMip > ImageDataLayout::maxMipCount)
+        endMip = ImageDataLayout::maxMipCount;
+
+    std::uint64_t offset = 0;
+    for (std::uint8_t mipIndex = range.baseMip; mipIndex < endMip; mipIndex++)
+    {
+        Dimensions const mipDims = calculateMipDimensions(textureInfo.baseDimensions, mipIndex);
+
+        MipLayout& mip = returnVal.mips[mipIndex];
+        offset = detail::alignUp(offset, offsetAlignment);
+        mip.offset = offset;
+        mip.rowPitch = detail::alignUp(calculateRowSize(mipDims, textureInfo.pixelFormat), rowPitchAlignment);
+        mip.slicePitch = mip.rowPitch * calculateRowCount(mipDims, textureInfo.pixelFormat);
+        mip.layerPitch = mip.slicePitch * mipDims.depth;
+
+        offset += mip.layerPitch * range.layerCount;
+    }
+    returnVal.totalSize = offset;
+
+    return returnVal;
+}
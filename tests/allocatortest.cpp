@@ -0,0 +1,328 @@
+// Checks Texas::ArenaAllocator and Texas::PoolAllocator through an upstream allocator that records what it hands out.
+// For the arena: alignment, resetting once everything is deallocated, forwarding what doesn't fit,
+// and growing after forwarding when it owns its buffer.
+// For the pool: the size-classes blocks are rounded up to, reusing cached blocks on the same and other threads,
+// the cache limit, and the header of allocations that are too large to be pooled.
+
+#include "Texas/ArenaAllocator.hpp"
+#include "Texas/PoolAllocator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+class CountingAllocator : public Texas::Allocator
+{
+public:
+	// Requests larger than this get a pointer to a small buffer, for allocators that only write a header to them.
+	static constexpr std::size_t largeRequestSize = std::size_t(1) << 28;
+
+	std::byte* allocate(std::size_t amount, MemoryType memType) override
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		allocationCount++;
+		lastAmount = amount;
+		lastMemType = memType;
+		std::byte* const ptr = amount > largeRequestSize ? m_largeRequestBuffer : new std::byte[amount];
+		m_live[ptr] = amount;
+		return ptr;
+	}
+
+	void deallocate(std::byte* ptr, MemoryType memType) override
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		deallocationCount++;
+		lastDeallocated = ptr;
+		lastMemType = memType;
+		auto const iter = m_live.find(ptr);
+		if (iter == m_live.end())
+		{
+			badDeallocationCount++;
+			return;
+		}
+		if (ptr != m_largeRequestBuffer)
+			delete[] ptr;
+		m_live.erase(iter);
+	}
+
+	std::size_t liveCount()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_live.size();
+	}
+
+	std::size_t allocationCount = 0;
+	std::size_t deallocationCount = 0;
+	std::size_t badDeallocationCount = 0;
+	std::size_t lastAmount = 0;
+	std::byte* lastDeallocated = nullptr;
+	MemoryType lastMemType = MemoryType::ImageData;
+
+private:
+	std::mutex m_mutex;
+	std::map<std::byte*, std::size_t> m_live;
+	alignas(std::max_align_t) std::byte m_largeRequestBuffer[64] = {};
+};
+
+using MemoryType = Texas::Allocator::MemoryType;
+
+static int failures = 0;
+
+static void check(bool condition, char const* what)
+{
+	if (condition)
+		return;
+	std::printf("%s\n", what);
+	failures++;
+}
+
+static bool isAligned(std::byte const* ptr)
+{
+	return reinterpret_cast<std::uintptr_t>(ptr) % alignof(std::max_align_t) == 0;
+}
+
+static void testArenaWithBuffer()
+{
+	CountingAllocator upstream;
+	alignas(std::max_align_t) std::byte buffer[256];
+	{
+		Texas::ArenaAllocator arena({ buffer, sizeof(buffer) }, &upstream);
+
+		std::byte* const a = arena.allocate(10, MemoryType::WorkingData);
+		std::byte* const b = arena.allocate(30, MemoryType::WorkingData);
+		check(a == buffer, "Arena starts at the start of its buffer");
+		check(isAligned(b) && b >= a + 10 && b < buffer + sizeof(buffer), "Arena allocations are aligned and don't overlap");
+		check(arena.bytesUsed() == std::size_t(b - a) + ((30 + alignof(std::max_align_t) - 1) / alignof(std::max_align_t)) * alignof(std::max_align_t),
+			"Arena bytes used");
+
+		// Image-data always goes upstream.
+		std::byte* const image = arena.allocate(16, MemoryType::ImageData);
+		check(upstream.allocationCount == 1 && upstream.lastMemType == MemoryType::ImageData, "Arena forwards image-data");
+
+		// Doesn't fit in what is left, so it's forwarded.
+		std::byte* const large = arena.allocate(240, MemoryType::WorkingData);
+		check(upstream.allocationCount == 2 && upstream.lastAmount == 240, "Arena forwards what doesn't fit");
+
+		arena.deallocate(image, MemoryType::ImageData);
+		arena.deallocate(large, MemoryType::WorkingData);
+		arena.deallocate(a, MemoryType::WorkingData);
+		check(arena.statistics().resetCount == 0, "Arena is not reset while allocations live in it");
+		arena.deallocate(b, MemoryType::WorkingData);
+		check(arena.statistics().resetCount == 1 && arena.bytesUsed() == 0, "Arena is reset once everything is deallocated");
+		check(arena.allocate(8, MemoryType::WorkingData) == buffer, "Arena is reused from the start after a reset");
+		arena.deallocate(buffer, MemoryType::WorkingData);
+
+		Texas::ArenaAllocator::Statistics const statistics = arena.statistics();
+		check(statistics.growCount == 0 && statistics.capacity == sizeof(buffer), "Arena never grows a buffer it doesn't own");
+		check(statistics.arenaAllocationCount == 3 && statistics.forwardedAllocationCount == 2, "Arena allocation counts");
+		check(statistics.peakBytesUsed >= 40 && statistics.peakBytesUsed <= sizeof(buffer), "Arena peak bytes used");
+	}
+	check(upstream.liveCount() == 0 && upstream.badDeallocationCount == 0, "Arena gives back everything it forwarded");
+}
+
+static void testArenaGrow()
+{
+	CountingAllocator upstream;
+	{
+		Texas::ArenaAllocator arena(256, &upstream);
+		check(upstream.allocationCount == 1 && upstream.lastAmount == 256, "Arena allocates its buffer upstream");
+		check(arena.statistics().capacity == 256, "Arena capacity");
+
+		std::byte* const a = arena.allocate(200, MemoryType::WorkingData);
+		std::byte* const b = arena.allocate(300, MemoryType::WorkingData);
+		check(upstream.allocationCount == 2, "Arena forwards what doesn't fit");
+		arena.deallocate(b, MemoryType::WorkingData);
+		check(arena.statistics().growCount == 0, "Arena doesn't grow while allocations live in it");
+		arena.deallocate(a, MemoryType::WorkingData);
+
+		// Grows to hold what was forwarded as well.
+		Texas::ArenaAllocator::Statistics statistics = arena.statistics();
+		check(statistics.growCount == 1 && statistics.capacity >= 256 + 300, "Arena grows at the reset after forwarding");
+		check(upstream.liveCount() == 1, "Arena gives back its old buffer when it grows");
+
+		std::uint64_t const forwardedCount = statistics.forwardedAllocationCount;
+		std::byte* const c = arena.allocate(200, MemoryType::WorkingData);
+		std::byte* const d = arena.allocate(300, MemoryType::WorkingData);
+		check(arena.statistics().forwardedAllocationCount == forwardedCount, "The same allocations fit after growing");
+		arena.deallocate(d, MemoryType::WorkingData);
+		arena.deallocate(c, MemoryType::WorkingData);
+		check(arena.statistics().growCount == 1, "Arena doesn't grow when nothing was forwarded");
+
+		// A forwarded allocation with nothing in the arena grows it when deallocated.
+		std::size_t const capacity = arena.statistics().capacity;
+		std::byte* const e = arena.allocate(capacity + 1, MemoryType::WorkingData);
+		arena.deallocate(e, MemoryType::WorkingData);
+		statistics = arena.statistics();
+		check(statistics.growCount == 2 && statistics.capacity > capacity, "Arena grows after forwarding with nothing in it");
+	}
+	check(upstream.liveCount() == 0 && upstream.badDeallocationCount == 0, "Arena gives back its buffer when destroyed");
+}
+
+static void testPoolSizeClasses()
+{
+	constexpr std::size_t headerSize = alignof(std::max_align_t) > sizeof(std::uint32_t) ? alignof(std::max_align_t) : sizeof(std::uint32_t);
+	struct SizeClass { std::size_t amount, blockSize; };
+	SizeClass const sizeClasses[] = {
+		{ 1, 256 }, { 256, 256 }, { 257, 320 }, { 320, 320 }, { 321, 384 }, { 448, 448 }, { 449, 512 },
+		{ 512, 512 }, { 513, 640 }, { 1000, 1024 }, { 1025, 1280 }, { (std::size_t(1) << 20) + 1, (std::size_t(1) << 20) * 5 / 4 } };
+
+	CountingAllocator upstream;
+	{
+		Texas::PoolAllocator pool(&upstream);
+		for (SizeClass const& sizeClass : sizeClasses)
+		{
+			std::size_t const allocationCount = upstream.allocationCount;
+			std::byte* const ptr = pool.allocate(sizeClass.amount, MemoryType::ImageData);
+			bool const isNewBlock = upstream.allocationCount == allocationCount + 1;
+			if (isNewBlock)
+				check(upstream.lastAmount == headerSize + sizeClass.blockSize, "Pool block size");
+			check(pool.statistics().bytesInUse == sizeClass.blockSize, "Pool bytes in use are the size-class");
+			check(isAligned(ptr), "Pool allocations are aligned");
+			pool.deallocate(ptr, MemoryType::ImageData);
+			check(pool.statistics().bytesInUse == 0, "Pool bytes in use after deallocating");
+		}
+
+		// No allocation wastes more than a quarter of its block.
+		for (std::size_t amount = 1; amount <= 1 << 16; amount++)
+		{
+			std::byte* const ptr = pool.allocate(amount, MemoryType::ImageData);
+			std::size_t const blockSize = pool.statistics().bytesInUse;
+			if (blockSize < amount || (amount > Texas::PoolAllocator::minBlockSize && blockSize - amount >= blockSize / 4))
+			{
+				std::printf("Pool rounds %zu bytes up to %zu\n", amount, blockSize);
+				failures++;
+			}
+			pool.deallocate(ptr, MemoryType::ImageData);
+		}
+
+		// Too large to be pooled, so the header marks it to be handed straight back.
+		std::size_t const deallocationCount = upstream.deallocationCount;
+		std::size_t const bytesCached = pool.statistics().bytesCached;
+		std::byte* const huge = pool.allocate(Texas::PoolAllocator::maxBlockSize + 1, MemoryType::ImageData);
+		check(huge != nullptr && upstream.lastAmount == headerSize + Texas::PoolAllocator::maxBlockSize + 1, "Pool forwards unpooled allocations with a header");
+		pool.deallocate(huge, MemoryType::ImageData);
+		check(upstream.deallocationCount == deallocationCount + 1 && upstream.lastDeallocated == huge - headerSize,
+			"Pool hands unpooled allocations straight back");
+		check(pool.statistics().bytesCached == bytesCached, "Pool doesn't cache unpooled allocations");
+
+		// Working-memory is not pooled either, nor given a header.
+		std::byte* const working = pool.allocate(100, MemoryType::WorkingData);
+		check(upstream.lastAmount == 100 && upstream.lastMemType == MemoryType::WorkingData, "Pool forwards working-memory");
+		pool.deallocate(working, MemoryType::WorkingData);
+		check(upstream.lastDeallocated == working, "Pool hands working-memory straight back");
+
+		pool.trim();
+		check(pool.statistics().bytesCached == 0 && upstream.liveCount() == 0, "Pool trim gives back every cached block");
+	}
+	check(upstream.badDeallocationCount == 0, "Pool only gives back what it got");
+}
+
+static void testPoolCaches()
+{
+	CountingAllocator upstream;
+	{
+		Texas::PoolAllocator pool(&upstream, 512);
+
+		// Deallocated on another thread, so it's in that thread's cache.
+		std::byte* const a = pool.allocate(300, MemoryType::ImageData);
+		std::thread([&pool, a]() { pool.deallocate(a, MemoryType::ImageData); }).join();
+		std::size_t const allocationCount = upstream.allocationCount;
+		std::byte* const b = pool.allocate(300, MemoryType::ImageData);
+		check(b == a && upstream.allocationCount == allocationCount, "Pool takes blocks from the caches of other threads");
+		check(pool.statistics().cacheHitCount == 1, "Pool cache hit count");
+
+		// And the other way around.
+		pool.deallocate(b, MemoryType::ImageData);
+		std::byte* c = nullptr;
+		std::thread([&pool, &c]() { c = pool.allocate(300, MemoryType::ImageData); }).join();
+		check(c == a && upstream.allocationCount == allocationCount, "Other threads take blocks from our cache");
+		pool.deallocate(c, MemoryType::ImageData);
+
+		// The cache of this thread holds at most 512 bytes, so the third 256-byte block is handed back.
+		std::byte* const blocks[3] = {
+			pool.allocate(256, MemoryType::ImageData),
+			pool.allocate(256, MemoryType::ImageData),
+			pool.allocate(256, MemoryType::ImageData) };
+		pool.trim();
+		std::size_t const deallocationCount = upstream.deallocationCount;
+		for (std::byte* const block : blocks)
+			pool.deallocate(block, MemoryType::ImageData);
+		check(upstream.deallocationCount == deallocationCount + 1, "Pool hands back blocks beyond the cache limit");
+		check(pool.statistics().bytesCached == 512, "Pool bytes cached");
+	}
+	check(upstream.liveCount() == 0 && upstream.badDeallocationCount == 0, "Pool gives back its cached blocks when destroyed");
+}
+
+// Several threads allocate, fill and deallocate at once, then check nothing was handed out twice.
+static void testPoolThreads()
+{
+	CountingAllocator upstream;
+	{
+		Texas::PoolAllocator pool(&upstream, 1 << 16);
+		std::vector<std::thread> threads;
+		std::vector<int> threadFailures(4, 0);
+		for (std::size_t t = 0; t < threadFailures.size(); t++)
+		{
+			threads.emplace_back([&pool, &threadFailures, t]()
+			{
+				std::mt19937 rng(static_cast<unsigned>(t));
+				std::uniform_int_distribution<std::size_t> sizeDist(1, 4000);
+				std::vector<std::pair<std::byte*, std::size_t>> live;
+				for (int i = 0; i < 4000; i++)
+				{
+					if (live.size() < 16 && (live.empty() || rng() % 2 == 0))
+					{
+						std::size_t const size = sizeDist(rng);
+						std::byte* const ptr = pool.allocate(size, MemoryType::ImageData);
+						std::memset(ptr, int(t + 1), size);
+						live.push_back({ ptr, size });
+						continue;
+					}
+					std::size_t const index = rng() % live.size();
+					std::byte* const ptr = live[index].first;
+					for (std::size_t j = 0; j < live[index].second; j++)
+					{
+						if (ptr[j] != std::byte(t + 1))
+						{
+							threadFailures[t]++;
+							break;
+						}
+					}
+					pool.deallocate(ptr, MemoryType::ImageData);
+					live.erase(live.begin() + std::ptrdiff_t(index));
+				}
+				for (auto const& allocation : live)
+					pool.deallocate(allocation.first, MemoryType::ImageData);
+			});
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+		for (int threadFailure : threadFailures)
+			check(threadFailure == 0, "Pool hands out blocks that are in use by another thread");
+		check(pool.statistics().bytesInUse == 0, "Pool bytes in use after every thread is done");
+	}
+	check(upstream.liveCount() == 0 && upstream.badDeallocationCount == 0, "Pool gives back every block after use from several threads");
+}
+
+int main()
+{
+	testArenaWithBuffer();
+	testArenaGrow();
+	testPoolSizeClasses();
+	testPoolCaches();
+	testPoolThreads();
+
+	if (failures > 0)
+	{
+		std::printf("%d checks failed.\n", failures);
+		return 1;
+	}
+	std::printf("All checks passed.\n");
+	return 0;
+}
@@ -0,0 +1,270 @@
+// Saves PNG files to a temporary directory, then loads them with Texas::loadFromPaths and Texas::loadFromStreams
+// with fewer threads than files, and checks every result against the image it was saved from.
+// Missing, empty, truncated and unsupported files are mixed in, and must fail without affecting the others.
+// Some files are larger than what is read ahead of them at once, and one is larger than what is read ahead
+// of all files together when reading through io_uring, so it's loaded from its path on its own.
+// Build it with TEXAS_ENABLE_IO_URING both on and off, since it goes through different code for each.
+
+#include "Texas/Texas.hpp"
+#include "Texas/BatchLoad.hpp"
+#include "Texas/PNG_Save.hpp"
+#include "Texas/PoolAllocator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using ByteVector = std::vector<std::byte>;
+
+class VectorOutputStream : public Texas::OutputStream
+{
+public:
+	ByteVector data;
+
+	Texas::Result write(char const* src, std::uint64_t size) noexcept override
+	{
+		std::byte const* const bytes = reinterpret_cast<std::byte const*>(src);
+		data.insert(data.end(), bytes, bytes + size);
+		return { Texas::ResultType::Success, nullptr };
+	}
+};
+
+// What a path in the batch holds, and what loading it must give.
+struct TestFile
+{
+	std::string path;
+	bool loads = false;
+	Texas::TextureInfo textureInfo{};
+	ByteVector imageData;
+	ByteVector fileData;
+};
+
+static bool writeFile(std::string const& path, ByteVector const& data)
+{
+	std::ofstream file(path, std::ios::binary);
+	file.write(reinterpret_cast<char const*>(data.data()), std::streamsize(data.size()));
+	return file.good();
+}
+
+static TestFile makePng(std::string const& path, std::uint32_t width, std::uint32_t height, std::uint32_t segmentCount, std::mt19937& rng)
+{
+	TestFile testFile{};
+	testFile.path = path;
+	testFile.loads = true;
+	Texas::TextureInfo& textureInfo = testFile.textureInfo;
+	textureInfo.fileFormat = Texas::FileFormat::PNG;
+	textureInfo.textureType = Texas::TextureType::Texture2D;
+	textureInfo.pixelFormat = Texas::PixelFormat::RGBA_8;
+	textureInfo.channelType = Texas::ChannelType::UnsignedNormalized;
+	textureInfo.colorSpace = Texas::ColorSpace::Linear;
+	textureInfo.baseDimensions = { width, height, 1 };
+	textureInfo.mipCount = 1;
+	textureInfo.layerCount = 1;
+
+	// Noise doesn't compress, so the file is about as large as the image.
+	testFile.imageData.resize(std::size_t(width) * height * 4);
+	for (std::byte& value : testFile.imageData)
+		value = std::byte(rng());
+
+	VectorOutputStream stream;
+	Texas::Result const result = Texas::PNG::saveToStream(
+		textureInfo,
+		{ testFile.imageData.data(), testFile.imageData.size() },
+		stream,
+		segmentCount);
+	if (!result.isSuccessful())
+		std::printf("Could not save %s: %s\n", path.c_str(), result.errorMessage());
+	testFile.fileData = std::move(stream.data);
+	return testFile;
+}
+
+static TestFile makeBadFile(std::string const& path, ByteVector const& data)
+{
+	TestFile testFile{};
+	testFile.path = path;
+	testFile.fileData = data;
+	return testFile;
+}
+
+static int failures = 0;
+
+// Every result starts out as this, so we can tell if one was never written.
+static char const notWrittenMessage[] = "Result was never written.";
+
+static std::vector<Texas::ResultValue<Texas::Texture>> makeResults(std::size_t count)
+{
+	std::vector<Texas::ResultValue<Texas::Texture>> results;
+	results.reserve(count);
+	for (std::size_t i = 0; i < count; i++)
+		results.emplace_back(Texas::ResultType::UnknownError, notWrittenMessage);
+	return results;
+}
+
+static void checkResults(
+	std::vector<TestFile> const& files,
+	std::vector<Texas::ResultValue<Texas::Texture>> const& results,
+	char const* what,
+	std::uint32_t threadCount)
+{
+	for (std::size_t i = 0; i < files.size(); i++)
+	{
+		TestFile const& file = files[i];
+		Texas::ResultValue<Texas::Texture> const& result = results[i];
+		bool matches = false;
+		if (file.loads && result.isSuccessful())
+		{
+			Texas::Texture const& texture = result.value();
+			Texas::ConstByteSpan const data = texture.mipSpan(0);
+			matches = texture.baseDimensions().width == file.textureInfo.baseDimensions.width &&
+				texture.baseDimensions().height == file.textureInfo.baseDimensions.height &&
+				texture.pixelFormat() == file.textureInfo.pixelFormat &&
+				data.size() == file.imageData.size() &&
+				std::memcmp(data.data(), file.imageData.data(), data.size()) == 0;
+		}
+		else if (!file.loads)
+			matches = !result.isSuccessful() && result.errorMessage() != notWrittenMessage;
+		if (!matches)
+		{
+			std::printf("%s with %u threads, %s: %s\n",
+				what,
+				threadCount,
+				file.path.c_str(),
+				result.errorMessage() ? result.errorMessage() : "no error");
+			failures++;
+		}
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<std::uint32_t> sizeDist(1, 200);
+
+	std::filesystem::path const directory = std::filesystem::temp_directory_path() /
+		("texas_batchloadtest_" + std::to_string(std::random_device{}()));
+	std::filesystem::create_directories(directory);
+	auto const pathOf = [&directory](std::string const& name) { return (directory / name).string(); };
+
+	// Enough files for several io_uring windows.
+	std::vector<TestFile> files;
+	for (int i = 0; i < 80; i++)
+	{
+		std::string const name = "image" + std::to_string(i) + ".png";
+		if (i % 10 == 3)
+			files.push_back(makeBadFile(pathOf("missing" + std::to_string(i) + ".png"), {}));
+		else if (i == 5)
+			files.push_back(makeBadFile(pathOf("empty.png"), {}));
+		else if (i == 7)
+		{
+			char const text[] = "Not a texture.";
+			ByteVector data(sizeof(text));
+			std::memcpy(data.data(), text, sizeof(text));
+			files.push_back(makeBadFile(pathOf("text.txt"), data));
+		}
+		else if (i == 9)
+		{
+			TestFile truncated = makePng(pathOf("truncated.png"), 300, 300, 1, rng);
+			truncated.loads = false;
+			truncated.fileData.resize(truncated.fileData.size() / 2);
+			files.push_back(std::move(truncated));
+		}
+		else if (i % 10 == 6)
+			// Larger than the first read of each file through io_uring.
+			files.push_back(makePng(pathOf(name), 300, 250, i % 20 == 6 ? 4 : 1, rng));
+		else
+			files.push_back(makePng(pathOf(name), sizeDist(rng), sizeDist(rng), 1, rng));
+	}
+	// Larger than all the files io_uring reads ahead at once.
+	files.insert(files.begin() + 40, makePng(pathOf("huge.png"), 4200, 4100, 1, rng));
+
+	for (TestFile const& file : files)
+	{
+		if (file.path.find("missing") != std::string::npos)
+			continue;
+		if (!writeFile(file.path, file.fileData))
+		{
+			std::printf("Could not write %s\n", file.path.c_str());
+			failures++;
+		}
+	}
+
+	std::vector<char const*> paths;
+	for (TestFile const& file : files)
+		paths.push_back(file.path.c_str());
+
+	for (std::uint32_t threadCount : { 1u, 2u, 3u, 0u })
+	{
+		{
+			Texas::PoolAllocator allocator;
+			std::vector<Texas::ResultValue<Texas::Texture>> results = makeResults(files.size());
+			Texas::Result const result = Texas::loadFromPaths(
+				{ paths.data(), paths.size() },
+				{ results.data(), results.size() },
+				allocator,
+				threadCount);
+			if (!result.isSuccessful())
+			{
+				std::printf("loadFromPaths with %u threads: %s\n", threadCount, result.errorMessage());
+				failures++;
+			}
+			checkResults(files, results, "loadFromPaths", threadCount);
+		}
+
+		std::vector<Texas::ResultValue<Texas::Texture>> results = makeResults(files.size());
+		Texas::Result const result = Texas::loadFromPaths(
+			{ paths.data(), paths.size() },
+			{ results.data(), results.size() },
+			threadCount);
+		if (!result.isSuccessful())
+		{
+			std::printf("loadFromPaths without an allocator, with %u threads: %s\n", threadCount, result.errorMessage());
+			failures++;
+		}
+		checkResults(files, results, "loadFromPaths without an allocator", threadCount);
+	}
+
+	// The same files from memory. Missing files are just empty streams here.
+	std::vector<std::unique_ptr<Texas::MemoryInputStream>> memoryStreams;
+	std::vector<Texas::InputStream*> streams;
+	for (TestFile const& file : files)
+	{
+		memoryStreams.push_back(std::make_unique<Texas::MemoryInputStream>(Texas::ConstByteSpan{ file.fileData.data(), file.fileData.size() }));
+		streams.push_back(memoryStreams.back().get());
+	}
+	for (std::uint32_t threadCount : { 1u, 4u, 0u })
+	{
+		for (std::unique_ptr<Texas::MemoryInputStream> const& stream : memoryStreams)
+			stream->seek(0);
+		Texas::PoolAllocator allocator;
+		std::vector<Texas::ResultValue<Texas::Texture>> results = makeResults(files.size());
+		Texas::Result const result = Texas::loadFromStreams(
+			{ streams.data(), streams.size() },
+			{ results.data(), results.size() },
+			allocator,
+			threadCount);
+		if (!result.isSuccessful())
+		{
+			std::printf("loadFromStreams with %u threads: %s\n", threadCount, result.errorMessage());
+			failures++;
+		}
+		checkResults(files, results, "loadFromStreams", threadCount);
+	}
+
+	std::error_code errorCode;
+	std::filesystem::remove_all(directory, errorCode);
+
+	if (failures > 0)
+	{
+		std::printf("%d checks failed.\n", failures);
+		return 1;
+	}
+	std::printf("All checks passed.\n");
+	return 0;
+}
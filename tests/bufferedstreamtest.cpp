@@ -0,0 +1,312 @@
+// Checks Texas::BufferedInputStream against the data it wraps, with wrapped streams that do and don't know their size.
+// The wrapped stream counts what is asked of it, so we can check that small reads and seeks back into the buffer
+// never reach it, that refills start where it already is instead of seeking back to the start of the block,
+// that reads into the buffer get smaller near the end of a stream of unknown size, and that large and vectored reads
+// go straight to it once they are past the buffer.
+
+#include "Texas/BufferedInputStream.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using ByteVector = std::vector<std::byte>;
+
+class CountingInputStream : public Texas::InputStream
+{
+public:
+	CountingInputStream(ByteVector const& data, bool knowsSize) : m_data(data), m_knowsSize(knowsSize) {}
+
+	// Fails without moving if it would read past the end.
+	Texas::Result read(Texas::ByteSpan dst) noexcept override
+	{
+		reads++;
+		if (m_pos > m_data.size() || dst.size() > m_data.size() - m_pos)
+		{
+			failedReads++;
+			return { Texas::ResultType::PrematureEndOfFile, "Read past the end of the stream." };
+		}
+		if (dst.size() > largestRead)
+			largestRead = dst.size();
+		lastReadPos = m_pos;
+		lastReadSize = dst.size();
+		std::memcpy(dst.data(), m_data.data() + m_pos, dst.size());
+		m_pos += dst.size();
+		return { Texas::ResultType::Success, nullptr };
+	}
+
+	Texas::Result readVectored(Texas::Span<Texas::ByteSpan const> dsts) noexcept override
+	{
+		vectoredReads++;
+		lastVectoredCount = dsts.size();
+		return InputStream::readVectored(dsts);
+	}
+
+	void ignore(std::size_t amount) noexcept override { m_pos += amount; }
+	std::size_t tell() noexcept override { return m_pos; }
+	void seek(std::size_t pos) noexcept override
+	{
+		seeks++;
+		m_pos = pos;
+	}
+	std::size_t size() noexcept override { return m_knowsSize ? m_data.size() : unknownSize; }
+
+	std::size_t reads = 0;
+	std::size_t failedReads = 0;
+	std::size_t vectoredReads = 0;
+	std::size_t seeks = 0;
+	std::size_t largestRead = 0;
+	std::size_t lastReadPos = 0;
+	std::size_t lastReadSize = 0;
+	std::size_t lastVectoredCount = 0;
+
+private:
+	ByteVector const& m_data;
+	bool m_knowsSize = false;
+	std::size_t m_pos = 0;
+};
+
+static ByteVector makeData(std::size_t size)
+{
+	ByteVector data(size);
+	for (std::size_t i = 0; i < size; i++)
+		data[i] = std::byte((i * 7) ^ (i >> 8));
+	return data;
+}
+
+static int failures = 0;
+
+static void check(bool condition, char const* what, bool knowsSize)
+{
+	if (condition)
+		return;
+	std::printf("%s, %s size\n", what, knowsSize ? "known" : "unknown");
+	failures++;
+}
+
+static bool readMatches(Texas::InputStream& stream, ByteVector const& data, std::size_t pos, std::size_t size)
+{
+	ByteVector dst(size);
+	if (!stream.read({ dst.data(), dst.size() }).isSuccessful())
+		return false;
+	return std::equal(dst.begin(), dst.end(), data.begin() + std::ptrdiff_t(pos));
+}
+
+static void testSequentialReads(ByteVector const& data, bool knowsSize)
+{
+	// Starts in the middle of a block, so the first refill has to start there too.
+	CountingInputStream source(data, knowsSize);
+	source.seek(5);
+	source.seeks = 0;
+	std::byte buffer[64];
+	Texas::BufferedInputStream stream(source, { buffer, sizeof(buffer) }, 16);
+
+	check(readMatches(stream, data, 5, 4), "First read", knowsSize);
+	check(source.lastReadPos == 5, "First refill starts where the wrapped stream is", knowsSize);
+	check(source.reads == 1 && source.lastReadSize == sizeof(buffer), "First refill fills the buffer", knowsSize);
+
+	// Every refill starts where the last one ended, which is not at the start of a block.
+	std::size_t pos = 9;
+	while (pos + 12 <= data.size() - 100)
+	{
+		check(readMatches(stream, data, pos, 12), "Sequential read", knowsSize);
+		pos += 12;
+	}
+	check(source.seeks == 0, "Sequential reads never seek the wrapped stream", knowsSize);
+	check(source.largestRead <= sizeof(buffer), "Sequential reads go through the buffer", knowsSize);
+}
+
+static void testEndOfStream(ByteVector const& data, bool knowsSize)
+{
+	CountingInputStream source(data, knowsSize);
+	std::byte buffer[256];
+	Texas::BufferedInputStream stream(source, { buffer, sizeof(buffer) }, 16);
+
+	std::size_t pos = 0;
+	while (pos + 10 <= data.size())
+	{
+		check(readMatches(stream, data, pos, 10), "Read near the end", knowsSize);
+		pos += 10;
+	}
+	check(readMatches(stream, data, pos, data.size() - pos), "Read up to the end", knowsSize);
+	std::byte pastEnd[1];
+	check(!stream.read({ pastEnd, 1 }).isSuccessful(), "Read past the end fails", knowsSize);
+
+	if (knowsSize)
+	{
+		// The size tells it where to stop, so nothing but the read past the end is tried.
+		check(source.failedReads == 0, "Never reads past the end of a stream that knows its size", knowsSize);
+	}
+	else
+	{
+		// Every failed refill halves the next one, so there are only a few of them.
+		check(source.failedReads > 0, "Reads into the buffer fail near the end", knowsSize);
+		check(source.failedReads <= 10, "Reads into the buffer get smaller after failing", knowsSize);
+	}
+}
+
+static void testLargeRead(ByteVector const& data, bool knowsSize)
+{
+	CountingInputStream source(data, knowsSize);
+	std::byte buffer[64];
+	Texas::BufferedInputStream stream(source, { buffer, sizeof(buffer) }, 16);
+
+	check(readMatches(stream, data, 0, 4), "Read into the buffer", knowsSize);
+	// 60 bytes come from the buffer, the rest does not fit in it.
+	check(readMatches(stream, data, 4, 300), "Read larger than the buffer", knowsSize);
+	check(source.reads == 2, "Read larger than the buffer reads once", knowsSize);
+	check(source.lastReadPos == 64 && source.lastReadSize == 240, "Read larger than the buffer goes straight to dst", knowsSize);
+	check(readMatches(stream, data, 304, 8), "Read after a large read", knowsSize);
+	check(source.seeks == 0, "Large reads never seek the wrapped stream", knowsSize);
+}
+
+static void testSeekBack(ByteVector const& data, bool knowsSize)
+{
+	CountingInputStream source(data, knowsSize);
+	std::byte buffer[64];
+	Texas::BufferedInputStream stream(source, { buffer, sizeof(buffer) }, 16);
+
+	check(readMatches(stream, data, 0, 40), "Read into the buffer", knowsSize);
+	stream.seek(8);
+	check(readMatches(stream, data, 8, 16), "Read after seeking back into the buffer", knowsSize);
+	stream.ignore(20);
+	check(readMatches(stream, data, 44, 20), "Read after ignoring inside the buffer", knowsSize);
+	stream.seek(32);
+	Texas::ConstByteSpan const acquired = stream.acquire(32);
+	check(acquired.data() != nullptr && std::memcmp(acquired.data(), data.data() + 32, 32) == 0, "Acquire from the buffer", knowsSize);
+	check(stream.acquire(1).data() == nullptr, "Acquire past the buffer", knowsSize);
+	check(source.reads == 1 && source.seeks == 0, "Seeks inside the buffer never reach the wrapped stream", knowsSize);
+
+	// Behind the buffer, so the wrapped stream has to go back.
+	stream.seek(200);
+	check(readMatches(stream, data, 200, 8), "Read after seeking forward", knowsSize);
+	stream.seek(100);
+	check(readMatches(stream, data, 100, 8), "Read after seeking back past the buffer", knowsSize);
+	check(source.seeks == 1 && source.lastReadPos == 96, "Seeking back past the buffer refills at the start of the block", knowsSize);
+}
+
+static void testReadVectored(ByteVector const& data, bool knowsSize)
+{
+	{
+		CountingInputStream source(data, knowsSize);
+		std::byte buffer[64];
+		Texas::BufferedInputStream stream(source, { buffer, sizeof(buffer) }, 16);
+		check(readMatches(stream, data, 0, 4), "Read into the buffer", knowsSize);
+
+		// The first span ends right at the end of the buffer, the others go straight to the wrapped stream.
+		ByteVector dst(190);
+		Texas::ByteSpan const dsts[] = { { dst.data(), 60 }, { dst.data() + 60, 100 }, { dst.data() + 160, 30 } };
+		check(stream.readVectored({ dsts, 3 }).isSuccessful(), "Vectored read", knowsSize);
+		check(std::memcmp(dst.data(), data.data() + 4, dst.size()) == 0, "Vectored read data", knowsSize);
+		check(source.vectoredReads == 1 && source.lastVectoredCount == 2, "Vectored read is split at the end of the buffer", knowsSize);
+		check(stream.tell() == 194, "Position after vectored read", knowsSize);
+		check(readMatches(stream, data, 194, 8), "Read after vectored read", knowsSize);
+	}
+	{
+		CountingInputStream source(data, knowsSize);
+		std::byte buffer[64];
+		Texas::BufferedInputStream stream(source, { buffer, sizeof(buffer) }, 16);
+		check(readMatches(stream, data, 0, 4), "Read into the buffer", knowsSize);
+
+		// The second span starts in the buffer and reaches past it.
+		ByteVector dst(180);
+		Texas::ByteSpan const dsts[] = { { dst.data(), 50 }, { dst.data() + 50, 100 }, { dst.data() + 150, 30 } };
+		check(stream.readVectored({ dsts, 3 }).isSuccessful(), "Vectored read across the buffer", knowsSize);
+		check(std::memcmp(dst.data(), data.data() + 4, dst.size()) == 0, "Vectored read across the buffer data", knowsSize);
+		check(source.vectoredReads == 1 && source.lastVectoredCount == 1, "Only spans past the buffer go to the wrapped stream", knowsSize);
+	}
+	{
+		CountingInputStream source(data, knowsSize);
+		std::byte buffer[64];
+		Texas::BufferedInputStream stream(source, { buffer, sizeof(buffer) }, 16);
+
+		// Fits in the buffer, so it's read through it.
+		ByteVector dst(40);
+		Texas::ByteSpan const dsts[] = { { dst.data(), 8 }, { dst.data() + 8, 32 } };
+		check(stream.readVectored({ dsts, 2 }).isSuccessful(), "Small vectored read", knowsSize);
+		check(std::memcmp(dst.data(), data.data(), dst.size()) == 0, "Small vectored read data", knowsSize);
+		check(source.vectoredReads == 0 && source.reads == 1, "Small vectored read goes through the buffer", knowsSize);
+	}
+}
+
+// Random reads, ignores, seeks and vectored reads, compared with the data itself.
+static void testRandomAccess(ByteVector const& data, bool knowsSize, std::size_t bufferSize, std::size_t blockSize)
+{
+	std::mt19937 rng(static_cast<unsigned>(bufferSize * 31 + blockSize + (knowsSize ? 1 : 0)));
+	CountingInputStream source(data, knowsSize);
+	ByteVector buffer(bufferSize);
+	Texas::BufferedInputStream stream(source, { buffer.data(), buffer.size() }, blockSize);
+
+	std::size_t pos = 0;
+	for (int i = 0; i < 2000; i++)
+	{
+		int const op = std::uniform_int_distribution<int>(0, 9)(rng);
+		if (op < 5)
+		{
+			std::size_t const maxSize = op == 0 ? bufferSize * 3 : 40;
+			std::size_t const size = std::uniform_int_distribution<std::size_t>(0, maxSize)(rng);
+			if (pos + size > data.size())
+				continue;
+			check(readMatches(stream, data, pos, size), "Random read", knowsSize);
+			pos += size;
+		}
+		else if (op < 7)
+		{
+			std::size_t const amount = std::uniform_int_distribution<std::size_t>(0, 100)(rng);
+			stream.ignore(amount);
+			pos += amount;
+		}
+		else if (op < 9)
+		{
+			// Mostly a bit back, sometimes anywhere.
+			if (op == 7 && pos > 0)
+				pos -= std::uniform_int_distribution<std::size_t>(0, pos < 100 ? pos : 100)(rng);
+			else
+				pos = std::uniform_int_distribution<std::size_t>(0, data.size())(rng);
+			stream.seek(pos);
+		}
+		else
+		{
+			std::size_t const sizeA = std::uniform_int_distribution<std::size_t>(0, bufferSize)(rng);
+			std::size_t const sizeB = std::uniform_int_distribution<std::size_t>(0, bufferSize * 2)(rng);
+			if (pos + sizeA + sizeB > data.size())
+				continue;
+			ByteVector dst(sizeA + sizeB);
+			Texas::ByteSpan const dsts[] = { { dst.data(), sizeA }, { dst.data() + sizeA, sizeB } };
+			check(stream.readVectored({ dsts, 2 }).isSuccessful(), "Random vectored read", knowsSize);
+			check(std::equal(dst.begin(), dst.end(), data.begin() + std::ptrdiff_t(pos)), "Random vectored read data", knowsSize);
+			pos += dst.size();
+		}
+		check(stream.tell() == pos, "Random position", knowsSize);
+	}
+}
+
+int main()
+{
+	ByteVector const data = makeData(1000);
+
+	for (bool knowsSize : { true, false })
+	{
+		testSequentialReads(data, knowsSize);
+		testEndOfStream(data, knowsSize);
+		testLargeRead(data, knowsSize);
+		testSeekBack(data, knowsSize);
+		testReadVectored(data, knowsSize);
+		testRandomAccess(data, knowsSize, 64, 16);
+		testRandomAccess(data, knowsSize, 100, 16);
+		testRandomAccess(data, knowsSize, 256, 4096);
+		testRandomAccess(data, knowsSize, 7, 3);
+	}
+
+	if (failures > 0)
+	{
+		std::printf("%d checks failed.\n", failures);
+		return 1;
+	}
+	std::printf("All checks passed.\n");
+	return 0;
+}
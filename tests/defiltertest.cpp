@@ -0,0 +1,164 @@
+// Checks the PNG defilter kernels against a plain implementation of the PNG specification,
+// for every filter type, every pixel-width and widths that don't line up with any vector size.
+
+#include "PNG_Defilter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+enum class Filter
+{
+	Sub,
+	Up,
+	Average,
+	AverageFirstRow,
+	Paeth
+};
+
+static char const* filterName(Filter filter)
+{
+	switch (filter)
+	{
+	case Filter::Sub: return "Sub";
+	case Filter::Up: return "Up";
+	case Filter::Average: return "Average";
+	case Filter::AverageFirstRow: return "AverageFirstRow";
+	case Filter::Paeth: return "Paeth";
+	}
+	return "";
+}
+
+static std::uint8_t paethPredictor(int a, int b, int c)
+{
+	int const p = a + b - c;
+	int const pa = std::abs(p - a);
+	int const pb = std::abs(p - b);
+	int const pc = std::abs(p - c);
+	if (pa <= pb && pa <= pc)
+		return std::uint8_t(a);
+	if (pb <= pc)
+		return std::uint8_t(b);
+	return std::uint8_t(c);
+}
+
+static void defilterReference(
+	Filter filter,
+	std::uint8_t* dst,
+	std::uint8_t const* filtered,
+	std::uint8_t const* prev,
+	std::size_t rowWidth,
+	std::size_t pixelWidth)
+{
+	for (std::size_t i = 0; i < rowWidth; i++)
+	{
+		int const a = i >= pixelWidth ? dst[i - pixelWidth] : 0;
+		int const b = filter == Filter::AverageFirstRow ? 0 : prev[i];
+		int const c = i >= pixelWidth && filter != Filter::AverageFirstRow ? prev[i - pixelWidth] : 0;
+		int predictor = 0;
+		switch (filter)
+		{
+		case Filter::Sub: predictor = a; break;
+		case Filter::Up: predictor = b; break;
+		case Filter::Average:
+		case Filter::AverageFirstRow: predictor = (a + b) / 2; break;
+		case Filter::Paeth: predictor = paethPredictor(a, b, c); break;
+		}
+		dst[i] = std::uint8_t(filtered[i] + predictor);
+	}
+}
+
+static Texas::detail::PNG::DefilterRowFn getKernel(Texas::detail::PNG::DefilterKernels const& kernels, Filter filter)
+{
+	switch (filter)
+	{
+	case Filter::Sub: return kernels.sub;
+	case Filter::Up: return kernels.up;
+	case Filter::Average: return kernels.average;
+	case Filter::AverageFirstRow: return kernels.averageFirstRow;
+	case Filter::Paeth: return kernels.paeth;
+	}
+	return nullptr;
+}
+
+int main()
+{
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<int> byteDist(0, 255);
+
+	std::uint8_t const pixelWidths[] = { 1, 2, 3, 4, 6, 8 };
+	std::size_t const pixelCounts[] = { 1, 2, 3, 5, 7, 9, 15, 17, 31, 33, 63, 65, 127, 129, 255, 257 };
+	Filter const filters[] = { Filter::Sub, Filter::Up, Filter::Average, Filter::AverageFirstRow, Filter::Paeth };
+
+	int failures = 0;
+	for (std::uint8_t const pixelWidth : pixelWidths)
+	{
+		Texas::detail::PNG::DefilterKernels const* kernels = Texas::detail::PNG::getDefilterKernels(pixelWidth);
+		if (kernels == nullptr)
+		{
+			std::printf("No kernels for pixel-width %u\n", unsigned(pixelWidth));
+			return 1;
+		}
+
+		for (std::size_t const pixelCount : pixelCounts)
+		{
+			std::size_t const rowWidth = pixelCount * pixelWidth;
+			for (Filter const filter : filters)
+			{
+				for (int run = 0; run < 4; run++)
+				{
+					// Padding on both sides catches kernels that touch bytes outside the row.
+					std::size_t const padding = 32;
+					std::vector<std::uint8_t> filtered(rowWidth + padding * 2);
+					std::vector<std::uint8_t> prev(rowWidth + padding * 2);
+					for (std::uint8_t& value : filtered)
+						value = std::uint8_t(byteDist(rng));
+					for (std::uint8_t& value : prev)
+						value = std::uint8_t(byteDist(rng));
+
+					std::vector<std::uint8_t> expected(rowWidth);
+					defilterReference(filter, expected.data(), filtered.data() + padding, prev.data() + padding, rowWidth, pixelWidth);
+
+					std::vector<std::uint8_t> dst(rowWidth + padding * 2, 0xCD);
+					getKernel(*kernels, filter)(
+						reinterpret_cast<std::byte*>(dst.data() + padding),
+						reinterpret_cast<std::byte const*>(filtered.data() + padding),
+						reinterpret_cast<std::byte const*>(prev.data() + padding),
+						rowWidth);
+
+					// The loaders also defilter in place.
+					std::vector<std::uint8_t> inPlace = filtered;
+					getKernel(*kernels, filter)(
+						reinterpret_cast<std::byte*>(inPlace.data() + padding),
+						reinterpret_cast<std::byte const*>(inPlace.data() + padding),
+						reinterpret_cast<std::byte const*>(prev.data() + padding),
+						rowWidth);
+
+					bool const dstMatches = std::memcmp(dst.data() + padding, expected.data(), rowWidth) == 0;
+					bool const inPlaceMatches = std::memcmp(inPlace.data() + padding, expected.data(), rowWidth) == 0;
+					bool paddingUntouched = true;
+					for (std::size_t i = 0; i < padding; i++)
+					{
+						if (dst[i] != 0xCD || dst[padding + rowWidth + i] != 0xCD)
+							paddingUntouched = false;
+					}
+					if (!dstMatches || !inPlaceMatches || !paddingUntouched)
+					{
+						std::printf(
+							"%s filter mismatch, pixel-width %u, %u pixels\n",
+							filterName(filter),
+							unsigned(pixelWidth),
+							unsigned(pixelCount));
+						failures++;
+					}
+				}
+			}
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}
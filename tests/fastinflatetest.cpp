@@ -0,0 +1,164 @@
+// Checks Texas' own inflate against data compressed by zLib with every strategy and several levels,
+// handed over in pieces of different sizes. Also checks that it rejects truncated data,
+// a bad Adler-32 and data that decompresses to more or less than the destination holds.
+
+#include "FastInflate.hpp"
+
+#include "zlib/zlib.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using ByteVector = std::vector<std::uint8_t>;
+
+class PieceSource : public Texas::detail::FastInflateSource
+{
+public:
+	PieceSource(ByteVector const& data, std::size_t pieceSize) : m_data(data), m_pieceSize(pieceSize) {}
+
+	Texas::ConstByteSpan next() noexcept override
+	{
+		std::size_t const offset = m_offset;
+		std::size_t const size = m_data.size() - offset < m_pieceSize ? m_data.size() - offset : m_pieceSize;
+		m_offset += size;
+		return { reinterpret_cast<std::byte const*>(m_data.data() + offset), size };
+	}
+
+private:
+	ByteVector const& m_data;
+	std::size_t m_pieceSize;
+	std::size_t m_offset = 0;
+};
+
+static ByteVector compress(ByteVector const& raw, int level, int strategy)
+{
+	z_stream stream{};
+	if (deflateInit2(&stream, level, Z_DEFLATED, 15, 8, strategy) != Z_OK)
+		return {};
+	ByteVector compressed(deflateBound(&stream, static_cast<uLong>(raw.size())));
+	stream.next_in = const_cast<Bytef*>(raw.data());
+	stream.avail_in = static_cast<uInt>(raw.size());
+	stream.next_out = compressed.data();
+	stream.avail_out = static_cast<uInt>(compressed.size());
+	int const result = deflate(&stream, Z_FINISH);
+	compressed.resize(stream.total_out);
+	deflateEnd(&stream);
+	return result == Z_STREAM_END ? compressed : ByteVector();
+}
+
+static Texas::Result inflate(ByteVector const& compressed, std::size_t pieceSize, ByteVector& dst)
+{
+	PieceSource source(compressed, pieceSize);
+	return Texas::detail::fastInflate(source, { reinterpret_cast<std::byte*>(dst.data()), dst.size() });
+}
+
+int main()
+{
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<int> byteDist(0, 255);
+
+	// Random bytes, short and long repeats of them, and runs of one byte.
+	std::vector<ByteVector> inputs;
+	std::size_t const sizes[] = { 1, 2, 17, 300, 5000, 70000, 1 << 20 };
+	for (std::size_t const size : sizes)
+	{
+		for (int kind = 0; kind < 4; kind++)
+		{
+			ByteVector raw(size);
+			for (std::size_t i = 0; i < size; i++)
+			{
+				switch (kind)
+				{
+				case 0: raw[i] = std::uint8_t(byteDist(rng)); break;
+				case 1: raw[i] = i < 7 ? std::uint8_t(byteDist(rng)) : raw[i - 7]; break;
+				case 2: raw[i] = i < 300 || byteDist(rng) < 8 ? std::uint8_t(byteDist(rng)) : raw[i - 300]; break;
+				case 3: raw[i] = std::uint8_t(i / 1000 % 3); break;
+				}
+			}
+			inputs.push_back(raw);
+		}
+	}
+
+	int const strategies[] = { Z_DEFAULT_STRATEGY, Z_FILTERED, Z_HUFFMAN_ONLY, Z_RLE, Z_FIXED };
+	int const levels[] = { 0, 1, 6, 9 };
+	std::size_t const pieceSizes[] = { 1, 3, 4096, std::size_t(1) << 30 };
+
+	int failures = 0;
+	for (std::size_t inputIndex = 0; inputIndex < inputs.size(); inputIndex++)
+	{
+		ByteVector const& raw = inputs[inputIndex];
+		for (int const strategy : strategies)
+		{
+			for (int const level : levels)
+			{
+				ByteVector const compressed = compress(raw, level, strategy);
+				if (compressed.empty())
+				{
+					std::printf("zLib failed to compress input %u\n", unsigned(inputIndex));
+					return 1;
+				}
+
+				for (std::size_t const pieceSize : pieceSizes)
+				{
+					// Piece sizes of a few bytes make large inputs very slow.
+					if (pieceSize < 16 && compressed.size() > 100000)
+						continue;
+					ByteVector dst(raw.size());
+					Texas::Result const result = inflate(compressed, pieceSize, dst);
+					if (!result.isSuccessful() || dst != raw)
+					{
+						std::printf(
+							"Input %u, strategy %d, level %d, pieces of %u bytes: %s\n",
+							unsigned(inputIndex),
+							strategy,
+							level,
+							unsigned(pieceSize),
+							result.errorMessage() ? result.errorMessage() : "wrong data");
+						failures++;
+					}
+				}
+
+				ByteVector dst(raw.size());
+				ByteVector truncated(compressed.begin(), compressed.end() - 1);
+				if (inflate(truncated, 4096, dst).isSuccessful())
+				{
+					std::printf("Input %u, strategy %d, level %d: truncated data was accepted\n", unsigned(inputIndex), strategy, level);
+					failures++;
+				}
+				ByteVector badAdler = compressed;
+				badAdler.back() ^= 1;
+				if (inflate(badAdler, 4096, dst).isSuccessful())
+				{
+					std::printf("Input %u, strategy %d, level %d: bad Adler-32 was accepted\n", unsigned(inputIndex), strategy, level);
+					failures++;
+				}
+				ByteVector tooSmall(raw.size() - 1);
+				ByteVector tooLarge(raw.size() + 1);
+				if (inflate(compressed, 4096, tooSmall).isSuccessful() || inflate(compressed, 4096, tooLarge).isSuccessful())
+				{
+					std::printf("Input %u, strategy %d, level %d: wrong destination size was accepted\n", unsigned(inputIndex), strategy, level);
+					failures++;
+				}
+			}
+		}
+	}
+
+	// Anything can be handed to it, it must never crash or write outside of dst.
+	for (int run = 0; run < 2000; run++)
+	{
+		ByteVector const& raw = inputs[std::size_t(run) % inputs.size()];
+		if (raw.size() > 100000)
+			continue;
+		ByteVector corrupted = compress(raw, 6, Z_DEFAULT_STRATEGY);
+		int const flipCount = 1 + run % 4;
+		for (int i = 0; i < flipCount; i++)
+			corrupted[std::size_t(byteDist(rng)) * corrupted.size() / 256] ^= std::uint8_t(1 << (byteDist(rng) % 8));
+		ByteVector dst(raw.size());
+		(void)inflate(corrupted, 64, dst);
+	}
+
+	return failures == 0 ? 0 : 1;
+}
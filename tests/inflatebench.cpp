@@ -0,0 +1,185 @@
+// Measures Texas' own inflate against zLib's, decompressing whole zLib data-streams into one buffer
+// the way the PNG loader does when TEXAS_ENABLE_FAST_INFLATE is on.
+// Not run as a test. Build with optimizations and run it on the machine you are targeting,
+// then only turn the option on if it comes out ahead there.
+//
+// Usage: inflatebench [run-count]
+
+#include "FastInflate.hpp"
+
+#include "zlib/zlib.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Hands out the compressed data in pieces the size of typical IDAT chunks.
+class ChunkedSource : public Texas::detail::FastInflateSource
+{
+public:
+	ChunkedSource(std::vector<std::uint8_t> const& data) : m_data(data) {}
+
+	Texas::ConstByteSpan next() noexcept override
+	{
+		std::size_t const pieceSize = 1 << 16;
+		std::size_t const offset = m_offset;
+		std::size_t const size = m_data.size() - offset < pieceSize ? m_data.size() - offset : pieceSize;
+		m_offset += size;
+		return { reinterpret_cast<std::byte const*>(m_data.data() + offset), size };
+	}
+
+private:
+	std::vector<std::uint8_t> const& m_data;
+	std::size_t m_offset = 0;
+};
+
+struct Dataset
+{
+	char const* name;
+	int compressionLevel;
+	std::vector<std::uint8_t> raw;
+};
+
+// Rows of a filtered RGBA image: one filter-type byte, then the row.
+static std::vector<std::uint8_t> makeImageRows(std::mt19937& rng, std::size_t width, std::size_t height, int noise, int flatness)
+{
+	std::uniform_int_distribution<int> noiseDist(-noise, noise);
+	std::uniform_int_distribution<int> flatDist(0, 99);
+	std::vector<std::uint8_t> rows;
+	rows.reserve((width * 4 + 1) * height);
+	for (std::size_t y = 0; y < height; y++)
+	{
+		// Sub filter.
+		rows.push_back(1);
+		int prev[4] = {};
+		for (std::size_t x = 0; x < width; x++)
+		{
+			bool const flat = flatDist(rng) < flatness;
+			for (int c = 0; c < 4; c++)
+			{
+				int const value = flat ? 0 : int((x * (c + 1) + y * 3) & 0xFF) + noiseDist(rng);
+				rows.push_back(std::uint8_t(value - prev[c]));
+				prev[c] = value;
+			}
+		}
+	}
+	return rows;
+}
+
+static std::vector<std::uint8_t> compress(std::vector<std::uint8_t> const& raw, int level)
+{
+	z_stream stream{};
+	if (deflateInit(&stream, level) != Z_OK)
+	{
+		std::printf("zLib failed to initialize deflate\n");
+		std::exit(1);
+	}
+	std::vector<std::uint8_t> compressed(deflateBound(&stream, static_cast<uLong>(raw.size())));
+	stream.next_in = const_cast<Bytef*>(raw.data());
+	stream.avail_in = static_cast<uInt>(raw.size());
+	stream.next_out = compressed.data();
+	stream.avail_out = static_cast<uInt>(compressed.size());
+	int const result = deflate(&stream, Z_FINISH);
+	compressed.resize(stream.total_out);
+	deflateEnd(&stream);
+	if (result != Z_STREAM_END)
+	{
+		std::printf("zLib failed to compress\n");
+		std::exit(1);
+	}
+	return compressed;
+}
+
+static bool inflateZLib(std::vector<std::uint8_t> const& compressed, std::vector<std::uint8_t>& dst)
+{
+	z_stream stream{};
+	if (inflateInit(&stream) != Z_OK)
+		return false;
+	stream.next_in = const_cast<Bytef*>(compressed.data());
+	stream.avail_in = static_cast<uInt>(compressed.size());
+	stream.next_out = dst.data();
+	stream.avail_out = static_cast<uInt>(dst.size());
+	int const result = inflate(&stream, Z_FINISH);
+	inflateEnd(&stream);
+	return result == Z_STREAM_END && stream.avail_out == 0;
+}
+
+static bool inflateTexas(std::vector<std::uint8_t> const& compressed, std::vector<std::uint8_t>& dst)
+{
+	ChunkedSource source(compressed);
+	return Texas::detail::fastInflate(source, { reinterpret_cast<std::byte*>(dst.data()), dst.size() }).isSuccessful();
+}
+
+// Returns the fastest of runCount runs, in seconds.
+template<typename InflateFn>
+static double timeInflate(InflateFn inflateFn, std::vector<std::uint8_t> const& compressed, std::vector<std::uint8_t>& dst, int runCount)
+{
+	double best = 0;
+	for (int run = 0; run < runCount; run++)
+	{
+		auto const begin = std::chrono::steady_clock::now();
+		bool const succeeded = inflateFn(compressed, dst);
+		double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		if (!succeeded)
+			return -1;
+		if (run == 0 || seconds < best)
+			best = seconds;
+	}
+	return best;
+}
+
+int main(int argc, char** argv)
+{
+	int const runCount = argc > 1 ? std::atoi(argv[1]) : 10;
+
+	std::mt19937 rng(1234);
+	std::vector<Dataset> datasets;
+	datasets.push_back({ "gradient rows, level 6", 6, makeImageRows(rng, 2048, 1024, 2, 0) });
+	datasets.push_back({ "noisy rows, level 6", 6, makeImageRows(rng, 2048, 1024, 40, 0) });
+	datasets.push_back({ "mostly flat rows, level 6", 6, makeImageRows(rng, 2048, 1024, 2, 90) });
+	datasets.push_back({ "gradient rows, level 1", 1, makeImageRows(rng, 2048, 1024, 2, 0) });
+	datasets.push_back({ "gradient rows, level 9", 9, makeImageRows(rng, 2048, 1024, 2, 0) });
+	{
+		std::uniform_int_distribution<int> byteDist(0, 255);
+		std::vector<std::uint8_t> noise(8 << 20);
+		for (std::uint8_t& value : noise)
+			value = std::uint8_t(byteDist(rng));
+		datasets.push_back({ "random bytes, level 6", 6, noise });
+	}
+
+	std::printf("%-28s %10s %12s %12s %8s\n", "Data", "Ratio", "zLib MB/s", "Texas MB/s", "Speedup");
+	int failures = 0;
+	for (Dataset const& dataset : datasets)
+	{
+		std::vector<std::uint8_t> const compressed = compress(dataset.raw, dataset.compressionLevel);
+		std::vector<std::uint8_t> dst(dataset.raw.size());
+
+		double const zLibSeconds = timeInflate(inflateZLib, compressed, dst, runCount);
+		bool const zLibMatches = zLibSeconds >= 0 && dst == dataset.raw;
+		std::memset(dst.data(), 0, dst.size());
+		double const texasSeconds = timeInflate(inflateTexas, compressed, dst, runCount);
+		bool const texasMatches = texasSeconds >= 0 && dst == dataset.raw;
+		if (!zLibMatches || !texasMatches)
+		{
+			std::printf("%-28s decompressed to the wrong data\n", dataset.name);
+			failures++;
+			continue;
+		}
+
+		double const megabytes = double(dataset.raw.size()) / (1 << 20);
+		std::printf(
+			"%-28s %9.1f%% %12.1f %12.1f %7.2fx\n",
+			dataset.name,
+			100.0 * double(compressed.size()) / double(dataset.raw.size()),
+			megabytes / zLibSeconds,
+			megabytes / texasSeconds,
+			zLibSeconds / texasSeconds);
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,356 @@
+// Saves KTX files with Texas::KTX::saveToStream, then loads every range of mip levels and array layers out of them,
+// tightly packed and in a padded layout, and compares them with the image the file was saved from.
+// Ranges are loaded in a shuffled order from the same stream and FileInfo, from regular and memory streams,
+// and from a stream that doesn't know its size, where the index of mip levels can't be checked and isn't used.
+// Also checks that ranges are loaded correctly, or not at all, when the index of mip levels does not match the file:
+// when a mip level before the range is larger than it should be, when a mip level has a wrong size,
+// and when the file is cut short.
+
+#include "Texas/Texas.hpp"
+#include "Texas/KTX_Save.hpp"
+#include "Texas/Tools.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using ByteVector = std::vector<std::byte>;
+
+class VectorOutputStream : public Texas::OutputStream
+{
+public:
+	ByteVector data;
+
+	Texas::Result write(char const* src, std::uint64_t size) noexcept override
+	{
+		std::byte const* const bytes = reinterpret_cast<std::byte const*>(src);
+		data.insert(data.end(), bytes, bytes + size);
+		return { Texas::ResultType::Success, nullptr };
+	}
+};
+
+// Goes through the generic InputStream path, unlike Texas::MemoryInputStream.
+class VectorInputStream : public Texas::InputStream
+{
+public:
+	VectorInputStream(ByteVector const& data, bool knowsSize) : m_data(data), m_knowsSize(knowsSize) {}
+
+	Texas::Result read(Texas::ByteSpan dst) noexcept override
+	{
+		if (m_pos > m_data.size() || dst.size() > m_data.size() - m_pos)
+			return { Texas::ResultType::PrematureEndOfFile, "Read past the end of the file." };
+		std::memcpy(dst.data(), m_data.data() + m_pos, dst.size());
+		m_pos += dst.size();
+		return { Texas::ResultType::Success, nullptr };
+	}
+
+	void ignore(std::size_t amount) noexcept override { m_pos += amount; }
+	std::size_t tell() noexcept override { return m_pos; }
+	void seek(std::size_t pos) noexcept override { m_pos = pos; }
+	std::size_t size() noexcept override { return m_knowsSize ? m_data.size() : unknownSize; }
+
+private:
+	ByteVector const& m_data;
+	bool m_knowsSize = true;
+	std::size_t m_pos = 0;
+};
+
+struct TestTexture
+{
+	std::string name;
+	Texas::TextureInfo textureInfo{};
+	ByteVector imageData;
+	ByteVector file;
+};
+
+static int failures = 0;
+
+static void fail(std::string const& what, Texas::Result const& result)
+{
+	std::printf("%s: %s\n", what.c_str(), result.errorMessage() ? result.errorMessage() : "no error");
+	failures++;
+}
+
+static std::string rangeName(Texas::ImageDataRange const& range)
+{
+	return "mips " + std::to_string(range.baseMip) + "+" + std::to_string(range.mipCount) +
+		", layers " + std::to_string(range.baseLayer) + "+" + std::to_string(range.layerCount);
+}
+
+static TestTexture makeTexture(
+	std::string const& name,
+	Texas::TextureType textureType,
+	Texas::PixelFormat pixelFormat,
+	Texas::Dimensions dims,
+	std::uint8_t mipCount,
+	std::uint64_t layerCount,
+	std::mt19937& rng)
+{
+	TestTexture texture{};
+	texture.name = name;
+	Texas::TextureInfo& textureInfo = texture.textureInfo;
+	textureInfo.fileFormat = Texas::FileFormat::KTX;
+	textureInfo.textureType = textureType;
+	textureInfo.pixelFormat = pixelFormat;
+	textureInfo.channelType = Texas::ChannelType::UnsignedNormalized;
+	textureInfo.colorSpace = Texas::ColorSpace::Linear;
+	textureInfo.baseDimensions = dims;
+	textureInfo.mipCount = mipCount;
+	textureInfo.layerCount = layerCount;
+
+	texture.imageData.resize(static_cast<std::size_t>(Texas::calculateTotalSize(textureInfo)));
+	for (std::byte& value : texture.imageData)
+		value = std::byte(rng());
+
+	std::vector<Texas::ConstByteSpan> mipLevels;
+	for (std::uint8_t mipIndex = 0; mipIndex < mipCount; mipIndex++)
+	{
+		std::uint64_t const offset = Texas::calculateMipOffset(textureInfo, mipIndex);
+		std::uint64_t const size = Texas::calculateTotalSize(Texas::calculateMipDimensions(dims, mipIndex), pixelFormat, 1, layerCount);
+		mipLevels.push_back({ texture.imageData.data() + offset, static_cast<std::size_t>(size) });
+	}
+	VectorOutputStream stream;
+	Texas::Result const result = Texas::KTX::saveToStream(textureInfo, { mipLevels.data(), mipLevels.size() }, stream);
+	if (!result.isSuccessful())
+		fail("Saving " + name, result);
+	texture.file = std::move(stream.data);
+	return texture;
+}
+
+static std::uint64_t layerSizeOf(Texas::TextureInfo const& textureInfo, std::uint8_t mipIndex)
+{
+	return Texas::calculateSingleImageSize(Texas::calculateMipDimensions(textureInfo.baseDimensions, mipIndex), textureInfo.pixelFormat);
+}
+
+// Compares a range loaded as described by layout with the image-data of the whole texture, row by row.
+static bool rangeMatches(
+	Texas::TextureInfo const& textureInfo,
+	ByteVector const& imageData,
+	Texas::ImageDataRange const& range,
+	Texas::ImageDataLayout const& layout,
+	ByteVector const& dst)
+{
+	for (std::uint8_t mipIndex = range.baseMip; mipIndex < range.baseMip + range.mipCount; mipIndex++)
+	{
+		Texas::Dimensions const mipDims = Texas::calculateMipDimensions(textureInfo.baseDimensions, mipIndex);
+		std::uint64_t const rowSize = Texas::calculateRowSize(mipDims, textureInfo.pixelFormat);
+		std::uint64_t const rowCount = Texas::calculateRowCount(mipDims, textureInfo.pixelFormat);
+		std::uint64_t const layerSize = layerSizeOf(textureInfo, mipIndex);
+		Texas::MipLayout const& mipLayout = layout.mips[mipIndex];
+		for (std::uint64_t layerIndex = 0; layerIndex < range.layerCount; layerIndex++)
+		{
+			for (std::uint64_t sliceIndex = 0; sliceIndex < mipDims.depth; sliceIndex++)
+			{
+				for (std::uint64_t rowIndex = 0; rowIndex < rowCount; rowIndex++)
+				{
+					std::uint64_t const srcOffset = Texas::calculateMipOffset(textureInfo, mipIndex) +
+						(range.baseLayer + layerIndex) * layerSize + (sliceIndex * rowCount + rowIndex) * rowSize;
+					std::uint64_t const dstOffset = mipLayout.offset +
+						layerIndex * mipLayout.layerPitch + sliceIndex * mipLayout.slicePitch + rowIndex * mipLayout.rowPitch;
+					if (dstOffset + rowSize > dst.size() ||
+						std::memcmp(dst.data() + dstOffset, imageData.data() + srcOffset, static_cast<std::size_t>(rowSize)) != 0)
+						return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+static std::vector<Texas::ImageDataRange> allRanges(Texas::TextureInfo const& textureInfo)
+{
+	std::vector<Texas::ImageDataRange> ranges;
+	for (std::uint8_t baseMip = 0; baseMip < textureInfo.mipCount; baseMip++)
+	{
+		for (std::uint8_t mipCount = 1; baseMip + mipCount <= textureInfo.mipCount; mipCount++)
+		{
+			for (std::uint64_t baseLayer = 0; baseLayer < textureInfo.layerCount; baseLayer++)
+			{
+				for (std::uint64_t layerCount = 1; baseLayer + layerCount <= textureInfo.layerCount; layerCount++)
+				{
+					Texas::ImageDataRange range{};
+					range.baseMip = baseMip;
+					range.mipCount = mipCount;
+					range.baseLayer = baseLayer;
+					range.layerCount = layerCount;
+					ranges.push_back(range);
+				}
+			}
+		}
+	}
+	return ranges;
+}
+
+// Loads every range, tightly packed and padded, in a shuffled order from the same stream and FileInfo.
+template<typename StreamT>
+static void testRanges(TestTexture const& texture, StreamT& stream, std::string const& what, std::mt19937& rng)
+{
+	Texas::ResultValue<Texas::FileInfo> const fileInfoResult = Texas::parseStream(stream);
+	if (!fileInfoResult.isSuccessful())
+	{
+		fail(what + ", parsing", fileInfoResult);
+		return;
+	}
+	Texas::FileInfo const& fileInfo = fileInfoResult.value();
+
+	// The whole texture, to compare the ranges with.
+	ByteVector whole(static_cast<std::size_t>(fileInfo.memoryRequired()));
+	Texas::Result result = Texas::loadImageData(stream, fileInfo, { whole.data(), whole.size() }, {});
+	if (!result.isSuccessful() || whole != texture.imageData)
+		fail(what + ", whole texture", result);
+
+	std::vector<Texas::ImageDataRange> ranges = allRanges(texture.textureInfo);
+	std::shuffle(ranges.begin(), ranges.end(), rng);
+	for (Texas::ImageDataRange const& range : ranges)
+	{
+		std::string const name = what + ", " + rangeName(range);
+
+		Texas::ImageDataLayout const tightLayout = Texas::calculateImageDataLayout(texture.textureInfo, range, 1, 1);
+		ByteVector tight(static_cast<std::size_t>(fileInfo.memoryRequired(range)));
+		if (tight.size() != tightLayout.totalSize)
+			fail(name + ", memoryRequired", result);
+		result = Texas::loadImageData(stream, fileInfo, range, { tight.data(), tight.size() }, {});
+		if (!result.isSuccessful() || !rangeMatches(texture.textureInfo, texture.imageData, range, tightLayout, tight))
+			fail(name + ", tightly packed", result);
+
+		Texas::ImageDataLayout const paddedLayout = Texas::calculateImageDataLayout(texture.textureInfo, range, 512, 256);
+		ByteVector padded(static_cast<std::size_t>(paddedLayout.totalSize));
+		result = Texas::loadImageData(stream, fileInfo, range, { padded.data(), padded.size() }, paddedLayout, {});
+		if (!result.isSuccessful() || !rangeMatches(texture.textureInfo, texture.imageData, range, paddedLayout, padded))
+			fail(name + ", padded", result);
+	}
+}
+
+/*
+	Loads every range out of a file where the mip levels in [firstBadMip, lastBadMip] are broken.
+	A range that holds any of them must fail, and a range that loads must match the image.
+	The other ranges must load, except when the stream doesn't know its size and the range is after the broken
+	mip levels, unless walkable says the file can still be walked through them.
+*/
+static void testBrokenFile(
+	TestTexture const& texture,
+	ByteVector const& file,
+	std::uint8_t firstBadMip,
+	std::uint8_t lastBadMip,
+	bool walkable,
+	std::string const& what)
+{
+	for (bool knowsSize : { true, false })
+	{
+		VectorInputStream stream(file, knowsSize);
+		Texas::ResultValue<Texas::FileInfo> const fileInfoResult = Texas::parseStream(stream);
+		if (!fileInfoResult.isSuccessful())
+		{
+			fail(what + ", parsing", fileInfoResult);
+			continue;
+		}
+		Texas::FileInfo const& fileInfo = fileInfoResult.value();
+		for (Texas::ImageDataRange const& range : allRanges(texture.textureInfo))
+		{
+			std::string const name = what + (knowsSize ? ", " : ", unknown size, ") + rangeName(range);
+			bool const holdsBadMip = range.baseMip <= lastBadMip && range.baseMip + range.mipCount > firstBadMip;
+			bool const mustLoad = !holdsBadMip && (knowsSize || walkable || range.baseMip < firstBadMip);
+			ByteVector dst(static_cast<std::size_t>(fileInfo.memoryRequired(range)));
+			Texas::Result const result = Texas::loadImageData(stream, fileInfo, range, { dst.data(), dst.size() }, {});
+			Texas::ImageDataLayout const layout = Texas::calculateImageDataLayout(texture.textureInfo, range, 1, 1);
+			if (holdsBadMip && result.isSuccessful())
+				fail(name + ", loaded a bad mip level", result);
+			else if (result.isSuccessful() && !rangeMatches(texture.textureInfo, texture.imageData, range, layout, dst))
+				fail(name + ", wrong image-data", result);
+			else if (mustLoad && !result.isSuccessful())
+				fail(name, result);
+		}
+	}
+}
+
+static void writeU32(std::byte* dst, std::uint32_t value)
+{
+	std::memcpy(dst, &value, sizeof(value));
+}
+
+static std::uint32_t readU32(std::byte const* src)
+{
+	std::uint32_t value = 0;
+	std::memcpy(&value, src, sizeof(value));
+	return value;
+}
+
+// Stream position of the 'imageSize' field of every mip level, found by walking the file.
+static std::vector<std::size_t> findMipFields(TestTexture const& texture)
+{
+	// 'bytesOfKeyValueData' is the last field of the 64-byte header.
+	std::size_t pos = 64 + readU32(texture.file.data() + 60);
+	std::vector<std::size_t> fields;
+	for (std::uint8_t mipIndex = 0; mipIndex < texture.textureInfo.mipCount; mipIndex++)
+	{
+		fields.push_back(pos);
+		std::uint32_t const imageSize = readU32(texture.file.data() + pos);
+		pos += 4 + imageSize + (3 - ((imageSize + 3) % 4));
+	}
+	return fields;
+}
+
+int main()
+{
+	std::mt19937 rng(1234);
+
+	std::vector<TestTexture> textures;
+	textures.push_back(makeTexture("2D array", Texas::TextureType::Array2D, Texas::PixelFormat::RGBA_8, { 37, 19, 1 }, 6, 3, rng));
+	// Every mip level of these is padded in the file, since their sizes are not multiples of 4.
+	textures.push_back(makeTexture("3D", Texas::TextureType::Texture3D, Texas::PixelFormat::R_8, { 13, 7, 5 }, 4, 1, rng));
+	textures.push_back(makeTexture("2D", Texas::TextureType::Texture2D, Texas::PixelFormat::RGB_8, { 64, 33, 1 }, 5, 1, rng));
+
+	for (TestTexture const& texture : textures)
+	{
+		VectorInputStream stream(texture.file, true);
+		testRanges(texture, stream, texture.name, rng);
+		// The index of mip levels can't be checked without the size of the stream.
+		VectorInputStream unknownSizeStream(texture.file, false);
+		testRanges(texture, unknownSizeStream, texture.name + ", unknown size", rng);
+		Texas::MemoryInputStream memoryStream({ texture.file.data(), texture.file.size() });
+		testRanges(texture, memoryStream, texture.name + ", memory stream", rng);
+	}
+
+	TestTexture const& texture = textures[0];
+	std::vector<std::size_t> const mipFields = findMipFields(texture);
+
+	// The first mip level holds 4 bytes more than it should, so the index points 4 bytes before the other mip levels.
+	// Ranges after it are still found by walking through the file.
+	{
+		ByteVector file = texture.file;
+		std::byte* const field = file.data() + mipFields[0];
+		std::uint32_t const imageSize = readU32(field);
+		writeU32(field, imageSize + 4);
+		std::byte const extra[4] = { std::byte(0xFF), std::byte(0xFF), std::byte(0xFF), std::byte(0xFF) };
+		file.insert(file.begin() + std::ptrdiff_t(mipFields[0] + 4 + imageSize), extra, extra + 4);
+		testBrokenFile(texture, file, 0, 0, true, "First mip level too large");
+	}
+	// The size of a mip level in the middle doesn't match the one in the header.
+	// Ranges after it can only be found through the index.
+	{
+		ByteVector file = texture.file;
+		std::byte* const field = file.data() + mipFields[2];
+		writeU32(field, readU32(field) - 4);
+		testBrokenFile(texture, file, 2, 2, false, "Wrong mip level size");
+	}
+	// The last mip level is cut short, in the middle of its first layer.
+	{
+		std::uint8_t const lastMip = texture.textureInfo.mipCount - 1;
+		ByteVector file = texture.file;
+		file.resize(mipFields[lastMip] + 4 + 2);
+		testBrokenFile(texture, file, lastMip, lastMip, true, "Cut short");
+	}
+
+	if (failures > 0)
+	{
+		std::printf("%d checks failed.\n", failures);
+		return 1;
+	}
+	std::printf("All checks passed.\n");
+	return 0;
+}
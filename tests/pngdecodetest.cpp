@@ -0,0 +1,401 @@
+// Saves PNG files with Texas::PNG::saveToStream, then decodes them through every PNG loading path:
+// regular and memory streams, Texas::loadImageData with all the working memory it asks for,
+// Texas::TextureLoader with pipelined decoding, and Texas::IncrementalDecoder fed in pieces of different sizes.
+// Files split into segments take the parallel path when pipelining is on.
+// Also checks that every path rejects files with a bad Adler-32, a bad CRC, missing image-data,
+// or more image-data than the image holds. The Adler-32 and CRC are checked both at the end of
+// the last IDAT chunk, and in an IDAT chunk of their own after it. So are the CRCs of IDAT chunks
+// after the end of the zLib data-stream.
+
+#include "Texas/Texas.hpp"
+
+#include "zlib/zlib.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using ByteVector = std::vector<std::byte>;
+
+class VectorOutputStream : public Texas::OutputStream
+{
+public:
+	ByteVector data;
+
+	Texas::Result write(char const* src, std::uint64_t size) noexcept override
+	{
+		std::byte const* const bytes = reinterpret_cast<std::byte const*>(src);
+		data.insert(data.end(), bytes, bytes + size);
+		return { Texas::ResultType::Success, nullptr };
+	}
+};
+
+// Goes through the generic InputStream path, unlike Texas::MemoryInputStream.
+class VectorInputStream : public Texas::InputStream
+{
+public:
+	explicit VectorInputStream(ByteVector const& data) : m_data(data) {}
+
+	Texas::Result read(Texas::ByteSpan dst) noexcept override
+	{
+		if (m_pos + dst.size() > m_data.size())
+			return { Texas::ResultType::PrematureEndOfFile, "Read past the end of the file." };
+		std::memcpy(dst.data(), m_data.data() + m_pos, dst.size());
+		m_pos += dst.size();
+		return { Texas::ResultType::Success, nullptr };
+	}
+
+	void ignore(std::size_t amount) noexcept override { m_pos += amount; }
+	std::size_t tell() noexcept override { return m_pos; }
+	void seek(std::size_t pos) noexcept override { m_pos = pos; }
+	std::size_t size() noexcept override { return m_data.size(); }
+
+private:
+	ByteVector const& m_data;
+	std::size_t m_pos = 0;
+};
+
+struct Chunk
+{
+	std::size_t pos;
+	std::uint32_t dataLength;
+	std::string type;
+};
+
+static std::uint32_t readU32BigEndian(std::byte const* ptr)
+{
+	return std::uint32_t(ptr[0]) << 24 | std::uint32_t(ptr[1]) << 16 | std::uint32_t(ptr[2]) << 8 | std::uint32_t(ptr[3]);
+}
+
+static std::vector<Chunk> findChunks(ByteVector const& file)
+{
+	std::vector<Chunk> chunks;
+	std::size_t pos = 8;
+	while (pos + 12 <= file.size())
+	{
+		std::uint32_t const dataLength = readU32BigEndian(file.data() + pos);
+		chunks.push_back({ pos, dataLength, std::string(reinterpret_cast<char const*>(file.data() + pos + 4), 4) });
+		pos += std::size_t(dataLength) + 12;
+	}
+	return chunks;
+}
+
+static Chunk lastIdatChunk(ByteVector const& file)
+{
+	Chunk last = {};
+	for (Chunk const& chunk : findChunks(file))
+	{
+		if (chunk.type == "IDAT")
+			last = chunk;
+	}
+	return last;
+}
+
+// Writes a CRC that matches the chunk's contents, so only the change we made is wrong.
+static void fixChunkCrc(ByteVector& file, Chunk const& chunk)
+{
+	unsigned long const crc = crc32(
+		0,
+		reinterpret_cast<Bytef const*>(file.data() + chunk.pos + 4),
+		static_cast<uInt>(chunk.dataLength + 4));
+	for (int i = 0; i < 4; i++)
+		file[chunk.pos + 8 + chunk.dataLength + i] = std::byte((crc >> (24 - 8 * i)) & 0xff);
+}
+
+// Appends an IDAT chunk holding data to file, with a CRC that matches it.
+static void appendIdatChunk(ByteVector& file, std::byte const* data, std::uint32_t dataLength)
+{
+	std::size_t const chunkPos = file.size();
+	for (int i = 0; i < 4; i++)
+		file.push_back(std::byte((dataLength >> (24 - 8 * i)) & 0xff));
+	for (char const c : { 'I', 'D', 'A', 'T' })
+		file.push_back(std::byte(c));
+	file.insert(file.end(), data, data + dataLength);
+	file.resize(file.size() + 4);
+	fixChunkCrc(file, { chunkPos, dataLength, "IDAT" });
+}
+
+// Moves the Adler-32 at the end of the last IDAT chunk into a new IDAT chunk after it.
+static ByteVector withAdlerChunk(ByteVector const& file)
+{
+	Chunk const lastIdat = lastIdatChunk(file);
+	std::size_t const adlerPos = lastIdat.pos + 8 + lastIdat.dataLength - 4;
+
+	ByteVector split(file.begin(), file.begin() + lastIdat.pos);
+	appendIdatChunk(split, file.data() + lastIdat.pos + 8, lastIdat.dataLength - 4);
+	appendIdatChunk(split, file.data() + adlerPos, 4);
+	split.insert(split.end(), file.begin() + lastIdat.pos + 12 + lastIdat.dataLength, file.end());
+	return split;
+}
+
+// Adds an IDAT chunk after the last one, after the end of the zLib data-stream.
+static ByteVector withIdatChunkAfterEnd(ByteVector const& file)
+{
+	Chunk const lastIdat = lastIdatChunk(file);
+	std::size_t const lastIdatEnd = lastIdat.pos + 12 + lastIdat.dataLength;
+
+	ByteVector extended(file.begin(), file.begin() + lastIdatEnd);
+	std::byte const unusedData[4] = {};
+	appendIdatChunk(extended, unusedData, 4);
+	extended.insert(extended.end(), file.begin() + lastIdatEnd, file.end());
+	return extended;
+}
+
+// Makes the header say the image is one row shorter than it is, so its image-data holds a row too many.
+static ByteVector withOneRowLess(ByteVector const& file)
+{
+	ByteVector shorter = file;
+	Chunk const ihdr = findChunks(file)[0];
+	std::uint32_t const height = readU32BigEndian(file.data() + ihdr.pos + 12) - 1;
+	for (int i = 0; i < 4; i++)
+		shorter[ihdr.pos + 12 + i] = std::byte((height >> (24 - 8 * i)) & 0xff);
+	fixChunkCrc(shorter, ihdr);
+	return shorter;
+}
+
+struct DecodeOutput
+{
+	char const* path;
+	Texas::Result result;
+	ByteVector imageData;
+};
+
+static DecodeOutput fromTexture(char const* path, Texas::ResultValue<Texas::Texture> const& texture)
+{
+	if (!texture.isSuccessful())
+		return { path, { texture.resultType(), texture.errorMessage() }, {} };
+	Texas::ConstByteSpan const span = texture.value().rawBufferSpan();
+	return { path, { Texas::ResultType::Success, nullptr }, ByteVector(span.data(), span.data() + span.size()) };
+}
+
+// Decompresses all of the image-data at once, instead of a few rows at a time like Texas::loadFromStream.
+static DecodeOutput decodeWholeImage(ByteVector const& file)
+{
+	char const* const path = "Whole-image loadImageData";
+	VectorInputStream stream(file);
+	Texas::ResultValue<Texas::FileInfo> const fileInfo = Texas::parseStream(stream);
+	if (!fileInfo.isSuccessful())
+		return { path, { fileInfo.resultType(), fileInfo.errorMessage() }, {} };
+	ByteVector imageData(static_cast<std::size_t>(fileInfo.value().memoryRequired()));
+	ByteVector workingMem(static_cast<std::size_t>(fileInfo.value().workingMemoryRequired()));
+	Texas::Result const result = Texas::loadImageData(
+		stream,
+		fileInfo.value(),
+		{ imageData.data(), imageData.size() },
+		{ workingMem.data(), workingMem.size() });
+	return { path, result, imageData };
+}
+
+static DecodeOutput decodeIncrementally(ByteVector const& file, std::size_t pieceSize)
+{
+	Texas::IncrementalDecoder decoder;
+	ByteVector imageData;
+	Texas::Result result = { Texas::ResultType::Success, nullptr };
+	for (std::size_t offset = 0; offset < file.size() && result.isSuccessful(); offset += pieceSize)
+	{
+		std::size_t const size = file.size() - offset < pieceSize ? file.size() - offset : pieceSize;
+		result = decoder.feed({ file.data() + offset, size });
+		if (result.isSuccessful() && decoder.hasFileInfo() && imageData.empty())
+		{
+			imageData.resize(static_cast<std::size_t>(decoder.fileInfo().memoryRequired()));
+			result = decoder.setDstBuffer({ imageData.data(), imageData.size() });
+		}
+	}
+	if (result.isSuccessful() && !decoder.isDone())
+		result = { Texas::ResultType::PrematureEndOfFile, "IncrementalDecoder was not done at the end of the file." };
+	return { "IncrementalDecoder", result, imageData };
+}
+
+static std::vector<DecodeOutput> decodeEveryWay(ByteVector const& file)
+{
+	std::vector<DecodeOutput> outputs;
+	{
+		VectorInputStream stream(file);
+		outputs.push_back(fromTexture("InputStream", Texas::loadFromStream(stream)));
+	}
+	{
+		Texas::MemoryInputStream stream({ file.data(), file.size() });
+		outputs.push_back(fromTexture("MemoryInputStream", Texas::loadFromStream(stream)));
+	}
+	outputs.push_back(decodeWholeImage(file));
+	{
+		Texas::TextureLoader loader;
+		loader.setPipelinedDecoding(true);
+		Texas::MemoryInputStream stream({ file.data(), file.size() });
+		outputs.push_back(fromTexture("Pipelined TextureLoader", loader.loadFromStream(stream)));
+	}
+	// Feeding a few bytes at a time is slow, so it's only done for small files.
+	std::size_t const pieceSizes[] = { 1, 13, 4096, file.size() };
+	for (std::size_t const pieceSize : pieceSizes)
+	{
+		if (pieceSize < 4096 && file.size() > 100000)
+			continue;
+		outputs.push_back(decodeIncrementally(file, pieceSize));
+	}
+	return outputs;
+}
+
+struct ImageFormat
+{
+	Texas::PixelFormat pixelFormat;
+	std::uint32_t pixelWidth;
+};
+
+int main()
+{
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<int> noiseDist(0, 7);
+
+	ImageFormat const formats[] = {
+		{ Texas::PixelFormat::R_8, 1 },
+		{ Texas::PixelFormat::RG_8, 2 },
+		{ Texas::PixelFormat::RGB_8, 3 },
+		{ Texas::PixelFormat::RGBA_8, 4 } };
+	struct Dimensions { std::uint32_t width, height; };
+	// The last one is large enough to be decoded pipelined, but only as RGBA.
+	Dimensions const dimensions[] = { { 1, 1 }, { 7, 3 }, { 33, 17 }, { 1100, 1000 } };
+	Dimensions const& pipelinedDimensions = dimensions[3];
+	std::uint32_t const segmentCounts[] = { 1, 2, 4, Texas::PNG::maxSegmentCount };
+
+	int failures = 0;
+	auto const fail = [&failures](std::string const& what, DecodeOutput const& output)
+	{
+		std::printf("%s, %s: %s\n", what.c_str(), output.path, output.result.errorMessage() ? output.result.errorMessage() : "no error");
+		failures++;
+	};
+
+	for (ImageFormat const& format : formats)
+	{
+		for (Dimensions const& dims : dimensions)
+		{
+			// Decoding it takes a while, and the other formats would not be pipelined anyway.
+			if (&dims == &pipelinedDimensions && format.pixelFormat != Texas::PixelFormat::RGBA_8)
+				continue;
+
+			Texas::TextureInfo textureInfo{};
+			textureInfo.fileFormat = Texas::FileFormat::PNG;
+			textureInfo.textureType = Texas::TextureType::Texture2D;
+			textureInfo.pixelFormat = format.pixelFormat;
+			textureInfo.channelType = Texas::ChannelType::UnsignedNormalized;
+			textureInfo.colorSpace = Texas::ColorSpace::Linear;
+			textureInfo.baseDimensions = { dims.width, dims.height, 1 };
+			textureInfo.mipCount = 1;
+			textureInfo.layerCount = 1;
+
+			// Gradients with a little noise, so every filter type gets picked somewhere.
+			ByteVector image(std::size_t(dims.width) * dims.height * format.pixelWidth);
+			for (std::size_t i = 0; i < image.size(); i++)
+			{
+				std::size_t const x = i / format.pixelWidth % dims.width;
+				std::size_t const y = i / format.pixelWidth / dims.width;
+				image[i] = std::byte((x * 3 + y * 5 + i % format.pixelWidth * 40 + noiseDist(rng)) & 0xff);
+			}
+
+			for (std::uint32_t const segmentCount : segmentCounts)
+			{
+				std::string const name =
+					std::to_string(dims.width) + "x" + std::to_string(dims.height) + ", " +
+					std::to_string(format.pixelWidth) + " bytes per pixel, " +
+					std::to_string(segmentCount) + " segments";
+
+				VectorOutputStream saved;
+				Texas::Result const saveResult = Texas::PNG::saveToStream(textureInfo, { image.data(), image.size() }, saved, segmentCount);
+				if (!saveResult.isSuccessful())
+				{
+					std::printf("%s: saving failed: %s\n", name.c_str(), saveResult.errorMessage());
+					failures++;
+					continue;
+				}
+				ByteVector const& file = saved.data;
+
+				for (DecodeOutput const& output : decodeEveryWay(file))
+				{
+					if (!output.result.isSuccessful() || output.imageData != image)
+						fail(name + ", roundtrip", output);
+				}
+
+				// The Adler-32 checksum is the last 4 bytes of the last IDAT chunk.
+				Chunk const lastIdat = lastIdatChunk(file);
+				ByteVector badAdler = file;
+				badAdler[lastIdat.pos + 8 + lastIdat.dataLength - 1] ^= std::byte(1);
+				fixChunkCrc(badAdler, lastIdat);
+				for (DecodeOutput const& output : decodeEveryWay(badAdler))
+				{
+					if (output.result.type() != Texas::ResultType::CorruptFileData)
+						fail(name + ", bad Adler-32", output);
+				}
+
+				// The Adler-32 is checked even when the last row is done before its IDAT chunk starts.
+				ByteVector const adlerChunk = withAdlerChunk(file);
+				for (DecodeOutput const& output : decodeEveryWay(adlerChunk))
+				{
+					if (!output.result.isSuccessful() || output.imageData != image)
+						fail(name + ", Adler-32 in its own chunk, roundtrip", output);
+				}
+				Chunk const adlerChunkInfo = lastIdatChunk(adlerChunk);
+				ByteVector badAdlerChunk = adlerChunk;
+				badAdlerChunk[adlerChunkInfo.pos + 8 + 3] ^= std::byte(1);
+				fixChunkCrc(badAdlerChunk, adlerChunkInfo);
+				for (DecodeOutput const& output : decodeEveryWay(badAdlerChunk))
+				{
+					if (output.result.type() != Texas::ResultType::CorruptFileData)
+						fail(name + ", bad Adler-32 in its own chunk", output);
+				}
+
+				ByteVector const chunkAfterEnd = withIdatChunkAfterEnd(file);
+				for (DecodeOutput const& output : decodeEveryWay(chunkAfterEnd))
+				{
+					if (!output.result.isSuccessful() || output.imageData != image)
+						fail(name + ", IDAT chunk after the data-stream, roundtrip", output);
+				}
+
+				// Cut the file off in the middle of its image-data.
+				ByteVector truncated(file.begin(), file.begin() + lastIdat.pos + 8 + lastIdat.dataLength / 2);
+				for (DecodeOutput const& output : decodeEveryWay(truncated))
+				{
+					if (output.result.isSuccessful())
+						fail(name + ", truncated", output);
+				}
+
+				if (dims.height > 1)
+				{
+					for (DecodeOutput const& output : decodeEveryWay(withOneRowLess(file)))
+					{
+						if (output.result.type() != Texas::ResultType::CorruptFileData)
+							fail(name + ", a row too many", output);
+					}
+				}
+
+#if defined(TEXAS_ENABLE_PNG_CRC_CHECK)
+				ByteVector badCrc = file;
+				badCrc[lastIdat.pos + 8 + lastIdat.dataLength] ^= std::byte(1);
+				for (DecodeOutput const& output : decodeEveryWay(badCrc))
+				{
+					if (output.result.type() != Texas::ResultType::CorruptFileData)
+						fail(name + ", bad CRC", output);
+				}
+				ByteVector badAdlerChunkCrc = adlerChunk;
+				badAdlerChunkCrc[adlerChunkInfo.pos + 12] ^= std::byte(1);
+				for (DecodeOutput const& output : decodeEveryWay(badAdlerChunkCrc))
+				{
+					if (output.result.type() != Texas::ResultType::CorruptFileData)
+						fail(name + ", bad CRC of the Adler-32 chunk", output);
+				}
+				ByteVector badChunkAfterEndCrc = chunkAfterEnd;
+				badChunkAfterEndCrc[lastIdatChunk(chunkAfterEnd).pos + 12] ^= std::byte(1);
+				for (DecodeOutput const& output : decodeEveryWay(badChunkAfterEndCrc))
+				{
+					if (output.result.type() != Texas::ResultType::CorruptFileData)
+						fail(name + ", bad CRC of an IDAT chunk after the data-stream", output);
+				}
+#endif
+			}
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}